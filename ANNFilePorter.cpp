@@ -5,33 +5,40 @@
 // 【更改记录】2025年7月20日 对扩展名的检查方法进行了改进
 // 【更改记录】2025年7月24日 增加了对网络有效性的检查, 增加导入网络名称的功能
 // 【更改记录】2025年7月29日 针对索引进行相应修改
+// 【更改记录】2026年10月19日 提取文件解析，增加稀疏网络的导入导出
+// 【更改记录】2026年10月19日 导入导出各阶段增加时间线跟踪
+// 【更改记录】2026年10月19日 import保留每个神经元各自的激活函数类型
+// 【更改记录】2026年10月19日 importCompiled改为计数排序直接生成CSR，不再为每个突触分配map节点
 //-------------------------------------------------------------------------------------------------------------------
 #include "ANNFilePorter.hpp" // 神经网络文件导入导出类的头文件
+#include "Tracer.hpp"        // 时间线跟踪
+#include <algorithm>         // std::stable_sort
 #include <iostream>          // 输入输出流头文件
 #include <fstream>           // 文件流头文件
+#include <utility>           // std::pair
 #include <sstream>           // 字符串流头文件
 #include <stdexcept>         // 标准异常头文件
 
 //-------------------------------------------------------------------------------------------------------------------
-// 【函数名称】ANNImporter::import
-// 【函数功能】从文件中导入神经网络结构和数据
-// 【参数】无
-// 【返回值】Network - 导入的神经网络对象
-// 【开发者及日期】李孟涵 2025年7月20日
-// 【更改记录】2025年7月20日 对扩展名的检查方法进行了改进
-// 【更改记录】2025年7月24日 增加了对网络有效性的检查, 增加导入网络名称的功能
+// 【函数名称】ANNImporter::parse
+// 【函数功能】逐行解析ANN文件，收集网络名称、神经元、层和突触信息
+// 【参数】networkName - 输出网络名称，neurons - 输出神经元信息，layers - 输出层信息，
+//        synapses - 输出突触信息
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 由import中提取
 //-------------------------------------------------------------------------------------------------------------------
-Network ANNImporter::import() {
+void ANNImporter::parse(std::string& networkName,
+                        std::vector<NeuronInfo>& neurons,
+                        std::vector<LayerInfo>& layers,
+                        std::vector<SynapseInfo>& synapses) const {
+    CANN_TRACE_SCOPE("import", "parse");
     std::ifstream file(filename);
     if (!file.is_open()) {// 打开文件失败
         throw std::runtime_error("Failed to open file: " + filename);
     }
     
     std::string line;               // 每一行的内容
-    std::vector<NeuronInfo> neurons;// 神经元信息的数组
-    std::vector<LayerInfo> layers;  // 层信息的数组
-    std::vector<SynapseInfo> synapses;// 突触信息的数组
-    std::string networkName;        // 网络名称
 
     //解析文件结构
     while (std::getline(file, line)) {
@@ -71,35 +78,56 @@ Network ANNImporter::import() {
                 break;
         }
     }
+    file.close();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】ANNImporter::import
+// 【函数功能】从文件中导入神经网络结构和数据
+// 【参数】无
+// 【返回值】Network - 导入的神经网络对象
+// 【开发者及日期】李孟涵 2025年7月20日
+// 【更改记录】2025年7月20日 对扩展名的检查方法进行了改进
+// 【更改记录】2025年7月24日 增加了对网络有效性的检查, 增加导入网络名称的功能
+// 【更改记录】2026年10月19日 文件解析移至parse；增加解析与连线两个阶段的跟踪
+// 【更改记录】2026年10月19日 保留每个神经元各自的激活函数类型，不再统一为层内第一个神经元的类型
+//-------------------------------------------------------------------------------------------------------------------
+Network ANNImporter::import() {
+    CANN_TRACE_SCOPE("import", "ANNImporter::import");
+    std::vector<NeuronInfo> neurons;// 神经元信息的数组
+    std::vector<LayerInfo> layers;  // 层信息的数组
+    std::vector<SynapseInfo> synapses;// 突触信息的数组
+    std::string networkName;        // 网络名称
+    parse(networkName, neurons, layers, synapses);
     
     // 创建网络
     Network network;
     network.setName(networkName);
-    // 创建层
-    for (size_t layerIdx = 0; layerIdx < layers.size(); ++layerIdx) {
-        const auto& layerInfo = layers[layerIdx];
-        int neuronCount = layerInfo.endNeuron - layerInfo.startNeuron + 1;
-        std::vector<double> biases;
+    {// 创建层
+        CANN_TRACE_SCOPE("import", "createLayers");
+        for (size_t layerIdx = 0; layerIdx < layers.size(); ++layerIdx) {
+            const auto& layerInfo = layers[layerIdx];
+            int neuronCount = layerInfo.endNeuron - layerInfo.startNeuron + 1;
+            std::vector<double> biases;
+            std::vector<int> activationTypes;
         
-        // 收集该层神经元的偏置值
-        for (int i = layerInfo.startNeuron; i <= layerInfo.endNeuron; ++i) {
-            if (i < static_cast<int>(neurons.size())) {
-                biases.push_back(neurons[i].bias);
-            } else {
-                biases.push_back(0.0);
+            // 收集该层神经元的偏置值和激活函数类型
+            for (int i = layerInfo.startNeuron; i <= layerInfo.endNeuron; ++i) {
+                if (i < static_cast<int>(neurons.size())) {
+                    biases.push_back(neurons[i].bias);
+                    activationTypes.push_back(neurons[i].activationType);
+                } else {
+                    biases.push_back(0.0);
+                    activationTypes.push_back(0);
+                }
             }
-        }
         
-        // 使用第一个神经元的激活函数类型作为整层的激活函数
-        int activationType = 0;
-        if (layerInfo.startNeuron < static_cast<int>(neurons.size())) {
-            activationType = neurons[layerInfo.startNeuron].activationType;
+            Layer* layer = new Layer(&network, neuronCount, biases, activationTypes);
+            network.addLayer(layer);
         }
-        
-        Layer* layer = new Layer(&network, neuronCount, biases, activationType);
-        network.addLayer(layer);
     }
     
+    CANN_TRACE_SCOPE("import", "setWeights");
     // 根据突触信息设置层间权重
     // 为每一层（除了第一层）收集权重矩阵
     for (size_t layerIdx = 1; layerIdx < layers.size(); ++layerIdx) {
@@ -143,7 +171,147 @@ Network ANNImporter::import() {
     if(!network.isValid()) {//增加对网络有效性的检查
         std::cerr << "Warning: Imported network is not valid!" << std::endl;
     }
-    file.close();
+    return network;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】ANNImporter::importCompiled
+// 【函数功能】从文件中导入稀疏网络。与import不同，相邻层之间未列出的突触视为不存在，
+//           不补为全连接；同一突触重复出现时与import相同，以最后一次为准，并给出警告。每个神经元保留各自的激活函数类型。
+//           CSR按计数排序生成：第一遍统计每行的突触数得到行偏移，第二遍按文件顺序填入各行，
+//           再在每行内按列稳定排序并合并重复项，除CSR本身外只需一行大小的临时数组
+// 【参数】无
+// 【返回值】CompiledNetwork - 导入的稀疏网络
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 增加时间线跟踪
+// 【更改记录】2026年10月19日 改为计数排序生成CSR，重复突触给出警告
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork ANNImporter::importCompiled() {
+    CANN_TRACE_SCOPE("import", "ANNImporter::importCompiled");
+    std::vector<NeuronInfo> neurons;
+    std::vector<LayerInfo> layers;
+    std::vector<SynapseInfo> synapses;
+    std::string networkName;
+    parse(networkName, neurons, layers, synapses);
+    CANN_TRACE_SCOPE("import", "buildCSR");
+
+    // 记录每个神经元所在的层，用于把突触分配到对应层
+    std::vector<int> layerOfNeuron(neurons.size(), -1);
+    for (size_t layerIdx = 0; layerIdx < layers.size(); ++layerIdx) {
+        for (int i = layers[layerIdx].startNeuron; i <= layers[layerIdx].endNeuron; ++i) {
+            if (i >= 0 && i < static_cast<int>(neurons.size())) {
+                layerOfNeuron[i] = static_cast<int>(layerIdx);
+            }
+        }
+    }
+
+    // 突触所在的层（不是相邻层之间的连接时为-1），输入和输出连接不属于任何层
+    bool skipped = false;
+    auto layerOfSynapse = [&](const SynapseInfo& synapse) {
+        if (synapse.fromNeuron == -1 || synapse.toNeuron == -1) {
+            return -1; // 跳过输入和输出连接
+        }
+        if (synapse.fromNeuron < 0 || synapse.fromNeuron >= static_cast<int>(neurons.size()) ||
+            synapse.toNeuron < 0 || synapse.toNeuron >= static_cast<int>(neurons.size())) {
+            skipped = true;
+            return -1;
+        }
+        int toLayer = layerOfNeuron[synapse.toNeuron];
+        if (toLayer <= 0 || layerOfNeuron[synapse.fromNeuron] != toLayer - 1) {
+            skipped = true; // 只支持相邻层之间的连接
+            return -1;
+        }
+        return toLayer;
+    };
+
+    // 第一遍：统计每行的突触数，前缀和得到各层的行偏移
+    std::vector<CompiledLayer> compiledLayers(layers.size());
+    for (size_t layerIdx = 1; layerIdx < layers.size(); ++layerIdx) {
+        compiledLayers[layerIdx].rowOffsets.assign(layers[layerIdx].endNeuron - layers[layerIdx].startNeuron + 2, 0);
+    }
+    for (const auto& synapse : synapses) {
+        int toLayer = layerOfSynapse(synapse);
+        if (toLayer > 0) {
+            ++compiledLayers[toLayer].rowOffsets[synapse.toNeuron - layers[toLayer].startNeuron + 1];
+        }
+    }
+    if (skipped) {
+        std::cerr << "Warning: Synapses not between adjacent layers were ignored." << std::endl;
+    }
+    for (size_t layerIdx = 1; layerIdx < layers.size(); ++layerIdx) {
+        CompiledLayer& layer = compiledLayers[layerIdx];
+        for (size_t i = 1; i < layer.rowOffsets.size(); ++i) {
+            layer.rowOffsets[i] += layer.rowOffsets[i - 1];
+        }
+        layer.columnIndices.resize(layer.rowOffsets.back());
+        layer.values.resize(layer.rowOffsets.back());
+    }
+
+    // 第二遍：按文件顺序填入各行
+    std::vector<std::vector<int>> cursors(layers.size());
+    for (size_t layerIdx = 1; layerIdx < layers.size(); ++layerIdx) {
+        cursors[layerIdx].assign(compiledLayers[layerIdx].rowOffsets.begin(), compiledLayers[layerIdx].rowOffsets.end() - 1);
+    }
+    for (const auto& synapse : synapses) {
+        int toLayer = layerOfSynapse(synapse);
+        if (toLayer > 0) {
+            int& cursor = cursors[toLayer][synapse.toNeuron - layers[toLayer].startNeuron];
+            compiledLayers[toLayer].columnIndices[cursor] = synapse.fromNeuron - layers[toLayer - 1].startNeuron;
+            compiledLayers[toLayer].values[cursor] = synapse.weight;
+            ++cursor;
+        }
+    }
+    cursors.clear();
+
+    // 每行按列稳定排序，同列的重复突触只保留文件中最后一次出现的权重，并就地压缩
+    bool duplicated = false;
+    std::vector<std::pair<int, double>> row;
+    for (size_t layerIdx = 1; layerIdx < layers.size(); ++layerIdx) {
+        CompiledLayer& layer = compiledLayers[layerIdx];
+        int written = 0;
+        for (size_t i = 0; i + 1 < layer.rowOffsets.size(); ++i) {
+            row.clear();
+            for (int k = layer.rowOffsets[i]; k < layer.rowOffsets[i + 1]; ++k) {
+                row.emplace_back(layer.columnIndices[k], layer.values[k]);
+            }
+            std::stable_sort(row.begin(), row.end(),
+                             [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+            layer.rowOffsets[i] = written;
+            for (size_t k = 0; k < row.size(); ++k) {
+                if (k > 0 && row[k].first == row[k - 1].first) {
+                    duplicated = true;
+                    layer.values[written - 1] = row[k].second;
+                    continue;
+                }
+                layer.columnIndices[written] = row[k].first;
+                layer.values[written] = row[k].second;
+                ++written;
+            }
+        }
+        layer.rowOffsets.back() = written;
+        layer.columnIndices.resize(written);
+        layer.values.resize(written);
+    }
+    if (duplicated) {
+        std::cerr << "Warning: Duplicate synapses were found; the last occurrence of each was used." << std::endl;
+    }
+
+    CompiledNetwork network;
+    network.setName(networkName);
+    for (size_t layerIdx = 0; layerIdx < layers.size(); ++layerIdx) {
+        const auto& layerInfo = layers[layerIdx];
+        CompiledLayer& layer = compiledLayers[layerIdx];
+        for (int i = layerInfo.startNeuron; i <= layerInfo.endNeuron; ++i) {
+            if (i >= 0 && i < static_cast<int>(neurons.size())) {
+                layer.biases.push_back(neurons[i].bias);
+                layer.activationTypes.push_back(neurons[i].activationType);
+            } else {
+                layer.biases.push_back(0.0);
+                layer.activationTypes.push_back(0);
+            }
+        }
+        network.addLayer(layer);
+    }
     return network;
 }
 
@@ -154,8 +322,10 @@ Network ANNImporter::import() {
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月20日
 //【更改记录】2025年7月24日：增加了对网络名称的导出
+//【更改记录】2026年10月19日：增加时间线跟踪，突触写出阶段单独记录
 //-------------------------------------------------------------------------------------------------------------------
 void ANNExporter::exportNetwork(const Network& network) {
+    CANN_TRACE_SCOPE("export", "ANNExporter::exportNetwork");
     std::ofstream file(filename);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to create file: " + filename);
@@ -191,6 +361,7 @@ void ANNExporter::exportNetwork(const Network& network) {
     }
     
     // 写入突触信息
+    CANN_TRACE_SCOPE("export", "writeSynapses");
     file << "# Synapses\n";
     
     // 导出输入突触（针对第一层）
@@ -243,3 +414,64 @@ void ANNExporter::exportNetwork(const Network& network) {
     
     file.close();
 }
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ANNExporter::exportNetwork
+//【函数功能】将稀疏网络导出到文件，格式与全连接网络相同，但只写出实际存储的突触，
+//          导出文件的大小与非零权重数量成正比，可由importCompiled原样读回
+//【参数】network - 要导出的稀疏网络
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加时间线跟踪
+//-------------------------------------------------------------------------------------------------------------------
+void ANNExporter::exportNetwork(const CompiledNetwork& network) {
+    CANN_TRACE_SCOPE("export", "ANNExporter::exportNetwork");
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create file: " + filename);
+    }
+    file.precision(17); // 保留double全部有效数字，导出后读回的推理结果与原网络一致
+
+    file << "# " << filename << "\n";
+    file << "G " << network.getName() << "\n";
+
+    file << "# Neurons\n";
+    for (int l = 0; l < network.getLayerCount(); ++l) {
+        const CompiledLayer& layer = network.getLayer(l);
+        for (int i = 0; i < layer.getNeuronCount(); ++i) {
+            file << "N " << layer.biases[i] << " " << layer.activationTypes[i] << "\n";
+        }
+    }
+
+    file << "# Layers\n";
+    std::vector<int> layerStarts;
+    int neuronIndex = 0;
+    for (int l = 0; l < network.getLayerCount(); ++l) {
+        int layerSize = network.getLayer(l).getNeuronCount();
+        layerStarts.push_back(neuronIndex);
+        file << "L " << neuronIndex << " " << (neuronIndex + layerSize - 1) << "\n";
+        neuronIndex += layerSize;
+    }
+
+    CANN_TRACE_SCOPE("export", "writeSynapses");
+    file << "# Synapses\n";
+    for (int i = 0; i < network.getInputSize(); ++i) {
+        file << "S -1 " << i << " 1.0\n";
+    }
+    if (network.getLayerCount() > 1) {
+        for (int i = 0; i < network.getOutputSize(); ++i) {
+            file << "S " << (layerStarts.back() + i) << " -1 1.0\n";
+        }
+    }
+    for (int l = 1; l < network.getLayerCount(); ++l) {
+        const CompiledLayer& layer = network.getLayer(l);
+        for (int i = 0; i < layer.getNeuronCount(); ++i) {
+            for (int k = layer.rowOffsets[i]; k < layer.rowOffsets[i + 1]; ++k) {
+                file << "S " << (layerStarts[l - 1] + layer.columnIndices[k]) << " "
+                     << (layerStarts[l] + i) << " " << layer.values[k] << "\n";
+            }
+        }
+    }
+
+    file.close();
+}
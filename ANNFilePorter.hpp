@@ -3,6 +3,7 @@
 //【功能模块和目的】ANN文件操作类的声明，提供ANN格式文件的导入导出功能
 //【开发者及日期】李孟涵 2025年7月20日
 //【更改记录】2025年7月24日：增加了对网络名称的导入导出
+//【更改记录】2026年10月19日：增加稀疏网络（CompiledNetwork）的导入导出
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef ANN_FILE_PORTER_HPP
@@ -10,22 +11,26 @@
 
 #include "FilePorter.hpp"
 #include "Network.hpp"
+#include "CompiledNetwork.hpp"
 #include <string>
+#include <vector>
 
 //-------------------------------------------------------------------------------------------------------------------
 //【类名】ANNImporter
 //【功能】从ANN格式文件导入神经网络结构和参数
 //【接口说明】继承自FilePorter，提供ANN文件的读取和网络构建功能
 //  - explicit ANNImporter(const std::string& filename): 构造函数，初始化文件名并验证文件类型
-//  - Network import(): 从ANN文件导入神经网络，返回构建的网络对象
+//  - Network import(): 从ANN文件导入神经网络，返回构建的网络对象（缺失的相邻层突触补为权重1.0）
+//  - CompiledNetwork importCompiled(): 从ANN文件导入稀疏网络，只保留文件中列出的突触
 //【开发者及日期】李孟涵 2025年7月20日
-//【更改记录】无
+//【更改记录】2026年10月19日：增加importCompiled，文件解析提取为parse
 //-------------------------------------------------------------------------------------------------------------------
 class ANNImporter : public FilePorter<FilePorterType::IMPORTER> {
 public:
     explicit ANNImporter(const std::string& filename) 
         : FilePorter<FilePorterType::IMPORTER>(filename, { "ANN" }) {}
     Network import();
+    CompiledNetwork importCompiled();
 
 private:
     struct NeuronInfo {
@@ -43,6 +48,11 @@ private:
         int toNeuron;
         double weight;
     };
+
+    void parse(std::string& networkName,
+               std::vector<NeuronInfo>& neurons,
+               std::vector<LayerInfo>& layers,
+               std::vector<SynapseInfo>& synapses) const; // 解析文件中的G/N/L/S行
 };
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -51,14 +61,17 @@ private:
 //【接口说明】继承自FilePorter，提供ANN文件的写入功能
 //  - explicit ANNExporter(const std::string& filename): 构造函数，初始化文件名并验证文件类型
 //  - void exportNetwork(const Network& network): 将神经网络导出到ANN文件
+//  - void exportNetwork(const CompiledNetwork& network): 将稀疏网络导出到ANN文件，只写出实际存在的突触
 //【开发者及日期】李孟涵 2025年7月20日
 //【更改记录】2025年7月24日：优化导出文件中的网络名称处理
+//【更改记录】2026年10月19日：增加稀疏网络的导出
 //-------------------------------------------------------------------------------------------------------------------
 class ANNExporter : public FilePorter<FilePorterType::EXPORTER> {
 public:
     explicit ANNExporter(const std::string& filename) 
         : FilePorter<FilePorterType::EXPORTER>(filename, { "ANN" }) {}
     void exportNetwork(const Network& network);
+    void exportNetwork(const CompiledNetwork& network);
 };
 
 #endif // ANN_FILE_PORTER_HPP
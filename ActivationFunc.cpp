@@ -2,7 +2,10 @@
 //【文件名】ActivationFunc.cpp
 //【功能模块和目的】激活函数类的实现，提供神经网络中常用的激活函数
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加导数及按类型调用的实现
+//【更改记录】2026年10月19日 增加整段激活applyRange
+//【更改记录】2026年10月19日 applyRange改由ActivationKernel模板实例化
+//【更改记录】2026年10月19日 删除applyRange
 //-------------------------------------------------------------------------------------------------------------------
 
 #include "ActivationFunc.hpp" // 激活函数所属头文件
@@ -54,4 +57,86 @@ double ActivationFunc::relu(double x) {
 //-------------------------------------------------------------------------------------------------------------------
 double ActivationFunc::linear(double x) {
     return x;
-}
\ No newline at end of file
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ActivationFunc::sigmoidDerivative
+//【函数功能】计算sigmoid函数的导数，利用 σ'(x) = σ(x)(1-σ(x)) 以输出值表示
+//【参数】y - sigmoid函数的输出值
+//【返回值】double - 导数值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ActivationFunc::sigmoidDerivative(double y) {
+    return y * (1.0 - y);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ActivationFunc::tanhDerivative
+//【函数功能】计算双曲正切函数的导数，利用 tanh'(x) = 1-tanh²(x) 以输出值表示
+//【参数】y - tanh函数的输出值
+//【返回值】double - 导数值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ActivationFunc::tanhDerivative(double y) {
+    return 1.0 - y * y;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ActivationFunc::reluDerivative
+//【函数功能】计算ReLU函数的导数，输出大于0时为1，否则为0
+//【参数】y - ReLU函数的输出值
+//【返回值】double - 导数值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ActivationFunc::reluDerivative(double y) {
+    return y > 0 ? 1.0 : 0.0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ActivationFunc::linearDerivative
+//【函数功能】计算线性函数的导数，恒为1
+//【参数】y - 线性函数的输出值（未使用）
+//【返回值】double - 导数值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ActivationFunc::linearDerivative(double /* y */) {
+    return 1.0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ActivationFunc::apply
+//【函数功能】根据激活函数类型计算激活值，类型编码与Soma一致
+//【参数】type - 激活函数类型，x - 输入值
+//【返回值】double - 激活后的输出值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ActivationFunc::apply(int type, double x) {
+    switch (type) {
+        case 1: return sigmoid(x); // Sigmoid 激活函数
+        case 2: return tanh(x);    // Tanh 激活函数
+        case 3: return relu(x);    // ReLU 激活函数
+        default: return linear(x); // Linear 激活函数
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ActivationFunc::derivative
+//【函数功能】根据激活函数类型计算导数，导数以激活函数的输出值表示，反向传播时无需保存加权和
+//【参数】type - 激活函数类型，y - 激活函数的输出值
+//【返回值】double - 导数值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ActivationFunc::derivative(int type, double y) {
+    switch (type) {
+        case 1: return sigmoidDerivative(y); // Sigmoid 导数
+        case 2: return tanhDerivative(y);    // Tanh 导数
+        case 3: return reluDerivative(y);    // ReLU 导数
+        default: return linearDerivative(y); // Linear 导数
+    }
+}
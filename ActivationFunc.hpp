@@ -2,12 +2,17 @@
 //【文件名】ActivationFunc.hpp
 //【功能模块和目的】激活函数类的声明，提供神经网络中常用的激活函数实现
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加按类型调用激活函数及其导数的接口，供训练器反向传播使用
+//【更改记录】2026年10月19日 增加对连续数组整段激活的applyRange
+//【更改记录】2026年10月19日 增加编译期选定激活函数的ActivationKernel模板
+//【更改记录】2026年10月19日 删除applyRange，整段激活由LayerKernel::activate完成
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef ACTIVATION_FUNC_HPP
 #define ACTIVATION_FUNC_HPP
 
+#include <cmath> // 数学函数库
+
 //-------------------------------------------------------------------------------------------------------------------
 //【类名】ActivationFunc
 //【功能】提供神经网络中常用的激活函数，包括sigmoid、tanh、ReLU和线性函数
@@ -16,8 +21,16 @@
 //  - static double tanh(double x): 双曲正切激活函数，输出范围(-1,1)
 //  - static double relu(double x): ReLU激活函数，输出范围[0,+∞)
 //  - static double linear(double x): 线性激活函数，直接返回输入值
+//  - static double sigmoidDerivative(double y): Sigmoid导数，以函数输出y表示
+//  - static double tanhDerivative(double y): 双曲正切导数，以函数输出y表示
+//  - static double reluDerivative(double y): ReLU导数，以函数输出y表示
+//  - static double linearDerivative(double y): 线性函数导数，恒为1
+//  - static double apply(int type, double x): 按激活函数类型计算激活值
+//  - static double derivative(int type, double y): 按激活函数类型计算导数，以函数输出y表示
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加导数及按类型调用的接口
+//【更改记录】2026年10月19日 增加applyRange
+//【更改记录】2026年10月19日 删除applyRange
 //-------------------------------------------------------------------------------------------------------------------
 class ActivationFunc {
 public:
@@ -25,6 +38,41 @@ public:
     static double tanh(double x); // 双曲正切激活函数
     static double relu(double x); // ReLU 激活函数
     static double linear(double x); // 线性激活函数 （默认）
+    static double sigmoidDerivative(double y); // Sigmoid 导数（以输出表示）
+    static double tanhDerivative(double y); // 双曲正切导数（以输出表示）
+    static double reluDerivative(double y); // ReLU 导数（以输出表示）
+    static double linearDerivative(double y); // 线性函数导数
+    static double apply(int type, double x); // 按类型计算激活值：0-linear 1-sigmoid 2-tanh 3-relu
+    static double derivative(int type, double y); // 按类型计算导数，y为激活函数的输出
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【模板名】ActivationKernel
+//【功能】以激活函数类型为模板参数的激活计算，类型在编译期确定，apply可被内联进调用方的循环，
+//        计算式与ActivationFunc中同类型的函数相同，结果逐位一致
+//【接口说明】
+//  - static double apply(double x): 计算激活值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+template <int Type>
+struct ActivationKernel {
+    static double apply(double x) { return x; } // 线性（0）及未知类型
+};
+
+template <>
+struct ActivationKernel<1> {
+    static double apply(double x) { return 1.0 / (1.0 + std::exp(-x)); } // Sigmoid
+};
+
+template <>
+struct ActivationKernel<2> {
+    static double apply(double x) { return std::tanh(x); } // Tanh
+};
+
+template <>
+struct ActivationKernel<3> {
+    static double apply(double x) { return x > 0 ? x : 0; } // ReLU
 };
 
 #endif // ACTIVATION_FUNC_HPP
@@ -0,0 +1,169 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】AllocationCounter.cpp
+//【功能模块和目的】堆分配计数的实现。定义CANN_COUNT_ALLOCS时在此替换全局operator new/delete
+//                  （C++14的普通、数组、nothrow和带大小的版本），分配本身仍由malloc/free完成
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "AllocationCounter.hpp" // 分配计数类头文件
+#include <atomic>                // 原子变量
+#include <cstdlib>               // malloc、free
+#include <iostream>              // 输入输出流头文件
+#include <new>                   // std::bad_alloc、std::nothrow_t
+#include <stdexcept>             // 标准异常头文件
+
+namespace {
+
+// 线程局部计数。AllocationStats的成员初始值均为常量，因此是常量初始化，首次访问时不会再调用operator new
+thread_local AllocationStats threadStats;
+std::atomic<long long> totalAllocations(0);   // 进程分配次数
+std::atomic<long long> totalDeallocations(0); // 进程释放次数
+std::atomic<long long> totalBytes(0);         // 进程申请的字节数
+
+#ifdef CANN_COUNT_ALLOCS
+void* countedAllocate(std::size_t size) {
+    ++threadStats.allocations;
+    threadStats.bytes += static_cast<long long>(size);
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void countedDeallocate(void* pointer) {
+    if (pointer != nullptr) {
+        ++threadStats.deallocations;
+        totalDeallocations.fetch_add(1, std::memory_order_relaxed);
+        std::free(pointer);
+    }
+}
+#endif
+
+} // namespace
+
+#ifdef CANN_COUNT_ALLOCS
+void* operator new(std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedDeallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedDeallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    countedDeallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    countedDeallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    countedDeallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    countedDeallocate(pointer);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AllocationCounter::isEnabled
+//【函数功能】判断编译时是否定义了CANN_COUNT_ALLOCS
+//【参数】无
+//【返回值】bool - 是否统计分配
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool AllocationCounter::isEnabled() {
+#ifdef CANN_COUNT_ALLOCS
+    return true;
+#else
+    return false;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AllocationCounter::getThreadStats / AllocationCounter::getTotalStats
+//【函数功能】获取当前线程、整个进程的分配计数
+//【参数】无
+//【返回值】AllocationStats - 分配计数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+AllocationStats AllocationCounter::getThreadStats() {
+    return threadStats;
+}
+
+AllocationStats AllocationCounter::getTotalStats() {
+    AllocationStats stats;
+    stats.allocations = totalAllocations.load(std::memory_order_relaxed);
+    stats.deallocations = totalDeallocations.load(std::memory_order_relaxed);
+    stats.bytes = totalBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AllocationScope::AllocationScope
+//【函数功能】构造函数，记录当前线程的计数
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+AllocationScope::AllocationScope() : start(AllocationCounter::getThreadStats()) {
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AllocationScope::getStats
+//【函数功能】获取构造以来当前线程的分配计数
+//【参数】无
+//【返回值】AllocationStats - 分配计数之差
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+AllocationStats AllocationScope::getStats() const {
+    AllocationStats now = AllocationCounter::getThreadStats();
+    AllocationStats stats;
+    stats.allocations = now.allocations - start.allocations;
+    stats.deallocations = now.deallocations - start.deallocations;
+    stats.bytes = now.bytes - start.bytes;
+    return stats;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AllocationScope::requireNone
+//【函数功能】检查构造以来当前线程没有发生堆分配，先取计数再拼接错误信息，避免错误信息本身的分配被计入
+//【参数】what - 被检查代码的描述，用于错误信息
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void AllocationScope::requireNone(const std::string& what) const {
+    AllocationStats stats = getStats();
+    if (stats.allocations != 0) {
+        std::cerr << "Error: " << what << " performed " << stats.allocations << " allocations ("
+                  << stats.bytes << " bytes).\n";
+        throw std::runtime_error(what + " performed " + std::to_string(stats.allocations) + " allocations");
+    }
+}
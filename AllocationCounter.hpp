@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】AllocationCounter.hpp
+//【功能模块和目的】堆分配计数。定义CANN_COUNT_ALLOCS编译时替换全局operator new/delete，按线程统计分配次数、
+//                  释放次数和申请的字节数，用AllocationScope统计一段代码（如一次Network::forward）内的分配，
+//                  并可要求预热后的推理路径不发生任何分配；未定义时不替换分配函数，统计结果恒为0
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <string> // 字符串所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】AllocationStats
+//【功能】堆分配计数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct AllocationStats {
+    long long allocations = 0;   // operator new调用次数
+    long long deallocations = 0; // operator delete调用次数（不含空指针）
+    long long bytes = 0;         // operator new申请的字节数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】AllocationCounter
+//【功能】查询堆分配计数。计数由替换后的全局operator new/delete维护，每个线程一份线程局部计数，
+//        另有一份进程总计数（原子变量）
+//【接口说明】
+//  - static bool isEnabled(): 编译时是否定义了CANN_COUNT_ALLOCS
+//  - static AllocationStats getThreadStats(): 当前线程自启动以来的计数
+//  - static AllocationStats getTotalStats(): 所有线程自程序启动以来的计数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class AllocationCounter {
+public:
+    static bool isEnabled();
+    static AllocationStats getThreadStats();
+    static AllocationStats getTotalStats();
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】AllocationScope
+//【功能】统计构造之后当前线程的堆分配，只计当前线程，其他线程同时进行的分配不会混入
+//【接口说明】
+//  - AllocationScope(): 构造函数，记录当前线程的计数
+//  - AllocationStats getStats() const: 构造以来当前线程的分配计数
+//  - void requireNone(const std::string& what) const: 构造以来有任何分配则抛出std::runtime_error，
+//    未定义CANN_COUNT_ALLOCS时不做检查
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class AllocationScope {
+public:
+    AllocationScope();
+    AllocationStats getStats() const;
+    void requireNone(const std::string& what) const;
+
+private:
+    AllocationStats start; // 构造时的计数
+};
+
+#endif // ALLOCATION_COUNTER_HPP
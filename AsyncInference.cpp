@@ -0,0 +1,242 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】AsyncInference.cpp
+//【功能模块和目的】异步推理的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为在ThreadPool上执行
+//【更改记录】2026年10月19日 定义CANN_TRACE时记录每个请求
+//【更改记录】2026年10月19日 在线程池工作线程中提交时不阻塞
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "AsyncInference.hpp" // 异步推理类头文件
+#include "Tracer.hpp"         // 时间线跟踪
+#include <iostream>           // 输入输出流头文件
+#include <stdexcept>          // 标准异常头文件
+#include <string>             // 字符串所属头文件
+#include <utility>            // std::move
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CancellationToken::CancellationToken / CancellationToken::cancel / CancellationToken::isCancelled
+//【函数功能】创建未取消的标记；取消；查询是否已取消
+//【参数】无
+//【返回值】isCancelled返回bool - 是否已取消
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CancellationToken::CancellationToken() : cancelled(std::make_shared<std::atomic<bool>>(false)) {
+}
+
+void CancellationToken::cancel() {
+    cancelled->store(true);
+}
+
+bool CancellationToken::isCancelled() const {
+    return cancelled->load();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::AsyncInference
+//【函数功能】构造函数，检查参数
+//【参数】model - 推理模型，options - 参数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 不再启动工作线程，改用线程池
+//-------------------------------------------------------------------------------------------------------------------
+AsyncInference::AsyncInference(const ModelHandle& model, const AsyncOptions& options)
+    : model(model), options(options), pool(options.pool != nullptr ? *options.pool : ThreadPool::shared()),
+      scheduled(0), stopping(false) {
+    if (model.acquire()->getLayerCount() == 0) {
+        std::cerr << "Error: Network is empty. Cannot run inference.\n";
+        throw std::invalid_argument("Network is empty. Cannot run inference.");
+    }
+    if (options.maxQueued <= 0) {
+        std::cerr << "Error: Invalid asynchronous inference options.\n";
+        throw std::invalid_argument("Invalid asynchronous inference options");
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::~AsyncInference
+//【函数功能】析构函数，等待排队中的请求执行完
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+AsyncInference::~AsyncInference() {
+    stop();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::forwardAsync
+//【函数功能】提交一个样本，结果通过future给出
+//【参数】input - 输入样本（按值传入，可移动以避免复制），token - 取消标记
+//【返回值】std::future<std::vector<double>> - 最后一层输出；推理失败或被取消时get抛出异常
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::future<std::vector<double>> AsyncInference::forwardAsync(std::vector<double> input, CancellationToken token) {
+    std::shared_ptr<std::promise<std::vector<double>>> promise = std::make_shared<std::promise<std::vector<double>>>();
+    std::future<std::vector<double>> future = promise->get_future();
+    AsyncRequest request;
+    request.input = std::move(input);
+    request.token = token;
+    request.callback = [promise](std::vector<double> output, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(output));
+        }
+    };
+    enqueue(std::move(request));
+    return future;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::forwardAsync
+//【函数功能】提交一个样本，完成时在工作线程中调用callback
+//【参数】input - 输入样本，callback - 回调，token - 取消标记
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void AsyncInference::forwardAsync(std::vector<double> input, AsyncCallback callback, CancellationToken token) {
+    if (!callback) {
+        std::cerr << "Error: Callback must not be empty.\n";
+        throw std::invalid_argument("Callback must not be empty");
+    }
+    AsyncRequest request;
+    request.input = std::move(input);
+    request.callback = std::move(callback);
+    request.token = token;
+    enqueue(std::move(request));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::enqueue
+//【函数功能】按模型当前版本检查输入宽度，队列满时按rejectWhenFull阻塞或拒绝，然后入队，
+//           并向线程池提交一个执行最早请求的任务。调用者是线程池的工作线程（如在回调中继续提交）时
+//           不阻塞而是越过上限入队：阻塞会占住工作线程，全部占住后没有线程执行runOne，进程死锁
+//【参数】request - 请求
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 入队后向线程池提交任务
+//【更改记录】2026年10月19日 在线程池工作线程中调用时不阻塞
+//-------------------------------------------------------------------------------------------------------------------
+void AsyncInference::enqueue(AsyncRequest request) {
+    const int inputSize = model.acquire()->getInputSize();
+    if (static_cast<int>(request.input.size()) != inputSize) {
+        std::cerr << "Error: Input size does not match the number of neurons in the first layer.\n";
+        throw std::invalid_argument("Input size " + std::to_string(request.input.size())
+                                    + " does not match the model input size " + std::to_string(inputSize));
+    }
+    const size_t maxQueued = static_cast<size_t>(options.maxQueued);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!stopping && queue.size() >= maxQueued) {
+            if (options.rejectWhenFull) {
+                ++stats.rejected;
+                std::cerr << "Error: Asynchronous inference queue is full.\n";
+                throw std::runtime_error("Asynchronous inference queue is full");
+            }
+            if (!pool.isWorkerThread()) {
+                queueNotFull.wait(lock, [this, maxQueued]() { return queue.size() < maxQueued || stopping; });
+            }
+        }
+        if (stopping) {
+            std::cerr << "Error: AsyncInference has been stopped.\n";
+            throw std::runtime_error("AsyncInference has been stopped");
+        }
+        queue.push_back(std::move(request));
+        ++scheduled;
+    }
+    pool.submit([this]() { runOne(); });
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::getQueued / AsyncInference::getStats
+//【函数功能】获取排队中的请求数；获取统计
+//【参数】无
+//【返回值】size_t - 请求数；AsyncStats - 统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t AsyncInference::getQueued() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+AsyncStats AsyncInference::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::stop
+//【函数功能】不再接受提交，唤醒阻塞中的提交者（它们抛出异常），等待已提交给线程池的任务全部执行完。
+//           不得在本对象的回调中调用
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为等待线程池任务执行完
+//-------------------------------------------------------------------------------------------------------------------
+void AsyncInference::stop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    stopping = true;
+    queueNotFull.notify_all();
+    idle.wait(lock, [this]() { return scheduled == 0; });
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】AsyncInference::runOne
+//【函数功能】线程池任务：取出最早的请求（每个任务对应一次入队，队列必不为空），已取消则直接以异常完成，
+//           否则取得模型最新版本执行forward，在锁外调用回调，最后减少已提交任务数
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 由工作线程主循环改为单个线程池任务
+//【更改记录】2026年10月19日 定义CANN_TRACE时记录每个请求（含回调）
+//-------------------------------------------------------------------------------------------------------------------
+void AsyncInference::runOne() {
+    {
+        CANN_TRACE_SCOPE("async", "AsyncInference::request");
+        AsyncRequest request;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            request = std::move(queue.front());
+            queue.pop_front();
+        }
+        queueNotFull.notify_one();
+        std::vector<double> output;
+        std::exception_ptr error;
+        bool cancelled = request.token.isCancelled();
+        if (cancelled) {
+            error = std::make_exception_ptr(std::runtime_error("Inference request was cancelled"));
+        } else {
+            try {
+                ModelSnapshot snapshot = model.acquire();
+                output = std::move(snapshot->forward(request.input).back());
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cancelled) {
+                ++stats.cancelled;
+            } else if (error) {
+                ++stats.errors;
+            } else {
+                ++stats.completed;
+            }
+        }
+        try {
+            request.callback(std::move(output), error);
+        } catch (...) {
+            // 回调不应抛出异常，忽略以保护工作线程
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--scheduled == 0) {
+        idle.notify_all();
+    }
+}
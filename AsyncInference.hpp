@@ -0,0 +1,136 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】AsyncInference.hpp
+//【功能模块和目的】异步推理：调用者提交单个样本后立即返回，通过future或回调取得结果，
+//                  推理由共享的工作线程完成，调用者可在等待期间处理自己的I/O。
+//                  支持取消排队中的请求，提交队列有上限，满时阻塞提交者或拒绝提交（背压）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为在ThreadPool上执行，不再自建工作线程
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef ASYNC_INFERENCE_HPP
+#define ASYNC_INFERENCE_HPP
+
+#include "ModelHandle.hpp"    // 模型句柄类头文件
+#include "ThreadPool.hpp"     // 线程池类头文件
+#include <atomic>             // 原子变量
+#include <condition_variable> // 条件变量
+#include <deque>              // 双端队列
+#include <exception>          // std::exception_ptr
+#include <functional>         // std::function
+#include <future>             // std::future、std::promise
+#include <memory>             // 智能指针
+#include <mutex>              // 互斥锁
+#include <vector>             // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】AsyncOptions
+//【功能】异步推理参数。pool为空时使用ThreadPool::shared()；排队请求达到maxQueued时，
+//        rejectWhenFull为false则提交者阻塞到有空位，为true则提交立即抛出异常。
+//        在pool的工作线程中（例如回调里）提交时从不阻塞：rejectWhenFull为false则越过上限入队，
+//        否则所有工作线程都可能阻塞在提交上，没有线程再执行请求
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 工作线程数改由线程池决定，workers改为pool
+//【更改记录】2026年10月19日 在工作线程中提交时不阻塞
+//-------------------------------------------------------------------------------------------------------------------
+struct AsyncOptions {
+    ThreadPool* pool = nullptr;  // 执行推理的线程池
+    int maxQueued = 256;         // 排队请求上限
+    bool rejectWhenFull = false; // 队列满时是否拒绝而不是阻塞
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】AsyncStats
+//【功能】异步推理的累计统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct AsyncStats {
+    long long completed = 0; // 成功完成的请求数
+    long long cancelled = 0; // 执行前被取消的请求数
+    long long errors = 0;    // 推理失败的请求数
+    long long rejected = 0;  // 因队列满被拒绝的提交数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】CancellationToken
+//【功能】取消标记。复制后共享同一个标记，任一副本cancel后所有副本都处于已取消状态；
+//        同一个标记可用于多个请求，一次取消一组请求
+//【接口说明】
+//  - CancellationToken(): 构造函数，创建未取消的标记
+//  - void cancel(): 取消，可在任意线程调用
+//  - bool isCancelled() const: 是否已取消
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class CancellationToken {
+public:
+    CancellationToken();
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled; // 共享的取消标记
+};
+
+// 回调：成功时error为空、output为最后一层输出；失败或取消时error为对应的异常
+typedef std::function<void(std::vector<double> output, std::exception_ptr error)> AsyncCallback;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】AsyncInference
+//【功能】线程安全的异步推理。每个请求入队后向线程池提交一个任务，任务按提交顺序取出请求，
+//        在执行时取得模型的最新版本并调用CompiledNetwork::forward。取消只对尚未开始执行的请求有效，被取消的请求以
+//        std::runtime_error完成，不占用推理时间
+//【接口说明】
+//  - AsyncInference(const ModelHandle& model, const AsyncOptions& options): 构造函数，
+//    model和线程池须在对象存在期间有效
+//  - std::future<std::vector<double>> forwardAsync(std::vector<double> input, CancellationToken token):
+//    提交一个样本，future给出最后一层输出
+//  - void forwardAsync(std::vector<double> input, AsyncCallback callback, CancellationToken token):
+//    提交一个样本，完成、失败或取消时在工作线程中调用callback（callback抛出的异常被忽略）
+//    两种提交在输入宽度不符时抛出std::invalid_argument，队列满且rejectWhenFull时或已停止时抛出std::runtime_error
+//  - size_t getQueued() const: 排队中的请求数
+//  - AsyncStats getStats() const: 获取统计
+//  - void stop(): 不再接受提交，执行完排队中的请求后停止；可重复调用
+//  - ~AsyncInference(): 析构函数，调用stop
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为在ThreadPool上执行
+//-------------------------------------------------------------------------------------------------------------------
+class AsyncInference {
+public:
+    AsyncInference(const ModelHandle& model, const AsyncOptions& options = AsyncOptions());
+    AsyncInference(const AsyncInference&) = delete;
+    AsyncInference& operator=(const AsyncInference&) = delete;
+    std::future<std::vector<double>> forwardAsync(std::vector<double> input,
+                                                  CancellationToken token = CancellationToken());
+    void forwardAsync(std::vector<double> input, AsyncCallback callback,
+                      CancellationToken token = CancellationToken());
+    size_t getQueued() const;
+    AsyncStats getStats() const;
+    void stop();
+    ~AsyncInference();
+
+private:
+    //---------------------------------------------------------------------------------------------------------------
+    //【结构体名】AsyncRequest
+    //【功能】排队中的请求
+    //---------------------------------------------------------------------------------------------------------------
+    struct AsyncRequest {
+        std::vector<double> input; // 输入样本
+        AsyncCallback callback;    // 完成时的回调
+        CancellationToken token;   // 取消标记
+    };
+    void enqueue(AsyncRequest request);           // 检查输入宽度，等待空位后入队并提交任务
+    void runOne();                                // 线程池任务：取出并执行最早的请求
+    const ModelHandle& model;                     // 推理模型
+    AsyncOptions options;                         // 参数
+    ThreadPool& pool;                             // 执行推理的线程池
+    mutable std::mutex mutex;                     // 保护以下成员
+    std::condition_variable queueNotFull;         // 有空位或停止时通知提交者
+    std::condition_variable idle;                 // 所有已提交的任务执行完时通知stop
+    std::deque<AsyncRequest> queue;               // 排队中的请求
+    size_t scheduled;                             // 已提交给线程池、尚未执行完的任务数
+    bool stopping;                                // 是否已请求停止
+    AsyncStats stats;                             // 统计
+};
+
+#endif // ASYNC_INFERENCE_HPP
@@ -0,0 +1,168 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】BatchInference.cpp
+//【功能模块和目的】非交互批量推理的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BatchInference.hpp" // 批量推理类头文件
+#include <chrono>             // 计时
+#include <cstdio>             // snprintf
+#include <cstdlib>            // strtod
+#include <iostream>           // 输入输出流头文件
+#include <stdexcept>          // 标准异常头文件
+
+namespace {
+
+const size_t flushBytes = 1 << 20; // 输出缓冲区达到1MB时写出
+
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchInference::BatchInference
+//【函数功能】构造函数，检查批大小和精度
+//【参数】network - 推理网络（须在本对象使用期间有效），batchSize - 批大小，precision - 输出有效数字位数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+BatchInference::BatchInference(const CompiledNetwork& network, int batchSize, int precision)
+    : network(network), batchSize(batchSize), precision(precision) {
+    if (network.getLayerCount() == 0) {
+        std::cerr << "Error: Network is empty. Cannot run inference.\n";
+        throw std::invalid_argument("Network is empty. Cannot run inference.");
+    }
+    if (batchSize <= 0) {
+        std::cerr << "Error: Batch size must be positive.\n";
+        throw std::invalid_argument("Batch size must be positive");
+    }
+    if (precision <= 0 || precision > 17) {
+        std::cerr << "Error: Precision must be between 1 and 17.\n";
+        throw std::invalid_argument("Precision must be between 1 and 17");
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchInference::run
+//【函数功能】逐行读取样本，每凑满一批（或输入结束）执行一次批量推理，输出先写入内存缓冲区，
+//           累计达到1MB或处理结束时一次写出，输出顺序与输入一致
+//【参数】input - 输入流，output - 输出流
+//【返回值】InferenceReport - 统计结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+InferenceReport BatchInference::run(std::istream& input, std::ostream& output) {
+    InferenceReport report;
+    const double start = nowSeconds();
+    std::vector<std::vector<double>> batch(batchSize, std::vector<double>(network.getInputSize()));
+    std::string buffer;
+    buffer.reserve(flushBytes + 4096);
+    std::string line;
+    long long lineNumber = 0;
+    size_t filled = 0;
+    bool finished = false;
+    while (!finished) {
+        finished = !std::getline(input, line);
+        if (!finished) {
+            ++lineNumber;
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+            parseRow(line, lineNumber, batch[filled++]);
+        }
+        if (filled == batch.size() || (finished && filled > 0)) {
+            batch.resize(filled);
+            const double computeStart = nowSeconds();
+            std::vector<std::vector<double>> results = network.forwardBatch(batch);
+            report.computeSeconds += nowSeconds() - computeStart;
+            for (const auto& result : results) {
+                writeRow(result, buffer);
+            }
+            if (buffer.size() >= flushBytes) {
+                output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+            report.rows += static_cast<long long>(filled);
+            ++report.batches;
+            batch.resize(batchSize, std::vector<double>(network.getInputSize()));
+            filled = 0;
+        }
+    }
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    output.flush();
+    if (!output) {
+        std::cerr << "Error: Failed to write inference output.\n";
+        throw std::runtime_error("Failed to write inference output");
+    }
+    report.seconds = nowSeconds() - start;
+    report.rowsPerSecond = report.seconds > 0.0 ? report.rows / report.seconds : 0.0;
+    return report;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchInference::parseRow
+//【函数功能】把一行解析为输入向量，值之间以逗号、空格或制表符分隔
+//【参数】line - 输入行，lineNumber - 行号（用于错误信息），row - 输出的输入向量，长度须为输入宽度
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void BatchInference::parseRow(const std::string& line, long long lineNumber, std::vector<double>& row) const {
+    const char* cursor = line.c_str();
+    size_t count = 0;
+    while (true) {
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+            ++cursor;
+        }
+        if (*cursor == '\0') {
+            break;
+        }
+        char* end = nullptr;
+        double value = std::strtod(cursor, &end);
+        if (end == cursor) {
+            std::cerr << "Error: Invalid number at line " << lineNumber << ".\n";
+            throw std::invalid_argument("Invalid number at line " + std::to_string(lineNumber));
+        }
+        if (count < row.size()) {
+            row[count] = value;
+        }
+        ++count;
+        cursor = end;
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+            ++cursor;
+        }
+        if (*cursor == ',') {
+            ++cursor;
+        }
+    }
+    if (count != row.size()) {
+        std::cerr << "Error: Line " << lineNumber << " has " << count << " values, expected " << row.size() << ".\n";
+        throw std::invalid_argument("Line " + std::to_string(lineNumber) + " has " + std::to_string(count)
+                                    + " values, expected " + std::to_string(row.size()));
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchInference::writeRow
+//【函数功能】把一行输出格式化后追加到缓冲区
+//【参数】values - 输出值，buffer - 输出缓冲区
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void BatchInference::writeRow(const std::vector<double>& values, std::string& buffer) const {
+    char text[32];
+    for (size_t i = 0; i < values.size(); ++i) {
+        int length = std::snprintf(text, sizeof(text), "%.*g", precision, values[i]);
+        if (i > 0) {
+            buffer += ',';
+        }
+        buffer.append(text, static_cast<size_t>(length));
+    }
+    buffer += '\n';
+}
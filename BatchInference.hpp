@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】BatchInference.hpp
+//【功能模块和目的】非交互批量推理：从输入流逐行读取CSV样本，按批调用CompiledNetwork::forwardBatch，
+//                  把最后一层输出以CSV写入输出流，供 "CANN infer model.ANN < in.csv > out.csv" 在数据管道中使用
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef BATCH_INFERENCE_HPP
+#define BATCH_INFERENCE_HPP
+
+#include "CompiledNetwork.hpp" // 紧凑推理网络类头文件
+#include <istream>             // 输入流
+#include <ostream>             // 输出流
+#include <string>              // 字符串所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】InferenceReport
+//【功能】一次批量推理的统计。seconds为读入、推理、写出的总耗时，computeSeconds只含forwardBatch
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct InferenceReport {
+    long long rows = 0;          // 样本数
+    long long batches = 0;       // 批次数
+    double seconds = 0.0;        // 总耗时
+    double computeSeconds = 0.0; // 推理耗时
+    double rowsPerSecond = 0.0;  // 每秒样本数（按总耗时）
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】BatchInference
+//【功能】流式批量推理。输入每行一个样本，值以逗号分隔（也接受空格、制表符），空行和以#开头的行被忽略；
+//        输出每行一个样本的最后一层输出，以逗号分隔。内存占用只与批大小有关，与输入行数无关
+//【接口说明】
+//  - BatchInference(const CompiledNetwork& network, int batchSize = 256, int precision = 10): 构造函数，
+//    precision为输出的有效数字位数
+//  - InferenceReport run(std::istream& input, std::ostream& output): 处理输入流直到结束
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class BatchInference {
+public:
+    BatchInference(const CompiledNetwork& network, int batchSize = 256, int precision = 10);
+    InferenceReport run(std::istream& input, std::ostream& output);
+
+private:
+    void parseRow(const std::string& line, long long lineNumber, std::vector<double>& row) const; // 解析一行
+    void writeRow(const std::vector<double>& values, std::string& buffer) const; // 把一行输出追加到缓冲区
+    const CompiledNetwork& network; // 推理网络
+    int batchSize;                  // 批大小
+    int precision;                  // 输出有效数字位数
+};
+
+#endif // BATCH_INFERENCE_HPP
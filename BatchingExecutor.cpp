@@ -0,0 +1,228 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】BatchingExecutor.cpp
+//【功能模块和目的】进程内动态批处理执行器的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 模型改由ModelHandle提供
+//【更改记录】2026年10月19日 定义CANN_TRACE时为批处理线程命名并记录每一批
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BatchingExecutor.hpp" // 批处理执行器类头文件
+#include "Tracer.hpp"           // 时间线跟踪
+#include <chrono>               // 计时
+#include <iostream>             // 输入输出流头文件
+#include <stdexcept>            // 标准异常头文件
+#include <string>               // 字符串所属头文件
+#include <utility>              // std::swap
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::BatchingExecutor
+//【函数功能】构造函数，检查参数并启动批处理线程
+//【参数】model - 推理模型，options - 批处理参数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为接收ModelHandle
+//【更改记录】2026年10月19日 每一批的跟踪参数标明为size
+//-------------------------------------------------------------------------------------------------------------------
+BatchingExecutor::BatchingExecutor(const ModelHandle& model, const BatchingOptions& options)
+    : model(model), options(options), submitters(0), stopping(false) {
+    if (model.acquire()->getLayerCount() == 0) {
+        std::cerr << "Error: Network is empty. Cannot run inference.\n";
+        throw std::invalid_argument("Network is empty. Cannot run inference.");
+    }
+    if (options.maxBatchSize <= 0 || options.maxDelayMicroseconds < 0) {
+        std::cerr << "Error: Invalid batching options.\n";
+        throw std::invalid_argument("Invalid batching options");
+    }
+    worker = std::thread(&BatchingExecutor::run, this);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::~BatchingExecutor
+//【函数功能】析构函数，处理完已提交的请求后停止批处理线程
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+BatchingExecutor::~BatchingExecutor() {
+    stop();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::submit
+//【函数功能】提交一个样本
+//【参数】input - 输入样本（按值传入，可移动以避免复制）
+//【返回值】std::future<std::vector<double>> - 最后一层输出；批量推理失败时get抛出std::runtime_error
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 按模型当前版本检查输入宽度
+//-------------------------------------------------------------------------------------------------------------------
+std::future<std::vector<double>> BatchingExecutor::submit(std::vector<double> input) {
+    const int inputSize = model.acquire()->getInputSize();
+    if (static_cast<int>(input.size()) != inputSize) {
+        std::cerr << "Error: Input size does not match the number of neurons in the first layer.\n";
+        throw std::invalid_argument("Input size " + std::to_string(input.size())
+                                    + " does not match the model input size " + std::to_string(inputSize));
+    }
+    std::future<std::vector<double>> future;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            std::cerr << "Error: BatchingExecutor has been stopped.\n";
+            throw std::runtime_error("BatchingExecutor has been stopped");
+        }
+        queue.emplace_back();
+        queue.back().input = std::move(input);
+        future = queue.back().result.get_future();
+    }
+    queueChanged.notify_one();
+    return future;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::infer
+//【函数功能】提交一个样本并等待结果
+//【参数】input - 输入样本
+//【返回值】std::vector<double> - 最后一层输出
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<double> BatchingExecutor::infer(const std::vector<double>& input) {
+    return submit(input).get();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::addSubmitter / BatchingExecutor::removeSubmitter
+//【函数功能】登记、注销一个同时只有一个未完成请求的提交者。注销后排队请求可能已达到剩余提交者数量，需通知批处理线程
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void BatchingExecutor::addSubmitter() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++submitters;
+}
+
+void BatchingExecutor::removeSubmitter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (submitters > 0) {
+            --submitters;
+        }
+    }
+    queueChanged.notify_one();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::stop
+//【函数功能】请求停止并等待批处理线程处理完已提交的请求后退出
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void BatchingExecutor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    if (worker.joinable() && worker.get_id() != std::this_thread::get_id()) {
+        worker.join();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::getStats
+//【函数功能】获取统计
+//【参数】无
+//【返回值】BatchingStats - 统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+BatchingStats BatchingExecutor::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】BatchingExecutor::run
+//【函数功能】批处理线程：等待队列非空，从此时起最多等待maxDelayMicroseconds，凑满maxBatchSize、
+//           排队数达到已登记的提交者数量或请求停止时提前结束等待，取出一批执行forwardBatch并逐个完成请求。
+//           停止后继续处理，直到队列为空才退出。每批取得模型的最新版本并持有到该批完成，
+//           输入宽度与该版本不符的请求单独以std::invalid_argument完成
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 每批从ModelHandle取得模型，过滤与该版本输入宽度不符的请求
+//【更改记录】2026年10月19日 定义CANN_TRACE时在时间线上命名为batching-executor，记录每一批，参数为请求数
+//-------------------------------------------------------------------------------------------------------------------
+void BatchingExecutor::run() {
+#ifdef CANN_TRACE
+    Tracer::setThreadName("batching-executor");
+#endif
+    const size_t maxBatchSize = static_cast<size_t>(options.maxBatchSize);
+    std::vector<PendingRequest> batch;
+    std::vector<std::vector<double>> inputs;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queueChanged.wait(lock, [this]() { return !queue.empty() || stopping; });
+            if (queue.empty()) {
+                return;
+            }
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(options.maxDelayMicroseconds);
+            queueChanged.wait_until(lock, deadline, [this, maxBatchSize]() {
+                return queue.size() >= maxBatchSize || (submitters > 0 && queue.size() >= submitters) || stopping;
+            });
+            while (!queue.empty() && batch.size() < maxBatchSize) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+        CANN_TRACE_SCOPE_ARG("batching", "BatchingExecutor::batch", "size", static_cast<long long>(batch.size()));
+        ModelSnapshot snapshot = model.acquire();
+        const size_t inputSize = static_cast<size_t>(snapshot->getInputSize());
+        long long mismatched = 0;
+        size_t accepted = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {// 排队期间模型可能已被替换为不同输入宽度的版本
+            if (batch[i].input.size() != inputSize) {
+                batch[i].result.set_exception(std::make_exception_ptr(std::invalid_argument(
+                    "Input size " + std::to_string(batch[i].input.size()) + " does not match the model input size "
+                    + std::to_string(inputSize))));
+                ++mismatched;
+                continue;
+            }
+            if (accepted != i) {
+                std::swap(batch[accepted], batch[i]);
+            }
+            ++accepted;
+        }
+        batch.resize(accepted);
+        inputs.resize(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            inputs[i].swap(batch[i].input);
+        }
+        std::vector<std::vector<double>> outputs;
+        std::string error;
+        try {
+            outputs = snapshot->forwardBatch(inputs);
+        } catch (const std::exception& exception) {
+            error = exception.what();
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (error.empty()) {
+                batch[i].result.set_value(std::move(outputs[i]));
+            } else {
+                batch[i].result.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.requests += static_cast<long long>(batch.size()) + mismatched;
+            stats.errors += (error.empty() ? 0 : static_cast<long long>(batch.size())) + mismatched;
+            ++stats.batches;
+        }
+        batch.clear();
+    }
+}
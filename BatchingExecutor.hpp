@@ -0,0 +1,99 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】BatchingExecutor.hpp
+//【功能模块和目的】进程内动态批处理：多个线程各自提交单个样本，执行器在可配置的等待窗口内把请求合并为
+//                  一批调用CompiledNetwork::forwardBatch，再分别完成各调用者的future，
+//                  使单样本的固定开销由并发的调用者分摊
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 模型改由ModelHandle提供，每批使用当时的最新版本，支持服务中热替换
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef BATCHING_EXECUTOR_HPP
+#define BATCHING_EXECUTOR_HPP
+
+#include "ModelHandle.hpp"     // 模型句柄类头文件
+#include <condition_variable>  // 条件变量
+#include <deque>               // 双端队列
+#include <future>              // std::future、std::promise
+#include <mutex>               // 互斥锁
+#include <thread>              // 线程
+#include <vector>              // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】BatchingOptions
+//【功能】批处理参数：队列中最早的请求最多等待maxDelayMicroseconds，期间凑满maxBatchSize个请求，
+//        或排队请求数达到已登记的提交者数量时立即执行
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct BatchingOptions {
+    int maxBatchSize = 64;           // 最大批大小
+    int maxDelayMicroseconds = 1000; // 最长等待时间（微秒）
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】BatchingStats
+//【功能】批处理的累计统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct BatchingStats {
+    long long requests = 0; // 已完成的请求数
+    long long batches = 0;  // 已执行的批次数
+    long long errors = 0;   // 以异常完成的请求数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】BatchingExecutor
+//【功能】线程安全的动态批处理执行器，内部一个批处理线程。已知同时提交的调用者数量且每个调用者
+//        同时只有一个未完成请求时（如每个连接一个线程的服务），可用addSubmitter/removeSubmitter登记，
+//        所有调用者都在等待时无需等到窗口结束
+//【接口说明】
+//  - BatchingExecutor(const ModelHandle& model, const BatchingOptions& options): 构造函数，启动批处理线程，
+//    model须在执行器存在期间有效
+//  - std::future<std::vector<double>> submit(std::vector<double> input): 提交一个样本，future给出最后一层输出；
+//    输入宽度与当前版本不符时立即抛出std::invalid_argument，已停止时抛出std::runtime_error；
+//    排队期间模型被替换为不同输入宽度的版本时，future的get抛出std::invalid_argument
+//  - std::vector<double> infer(const std::vector<double>& input): 提交并等待结果
+//  - void addSubmitter() / void removeSubmitter(): 登记/注销一个提交者
+//  - void stop(): 处理完已提交的请求后停止，之后的submit会抛出异常；可重复调用
+//  - BatchingStats getStats() const: 获取统计
+//  - ~BatchingExecutor(): 析构函数，调用stop
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为从ModelHandle取得模型
+//-------------------------------------------------------------------------------------------------------------------
+class BatchingExecutor {
+public:
+    BatchingExecutor(const ModelHandle& model, const BatchingOptions& options = BatchingOptions());
+    BatchingExecutor(const BatchingExecutor&) = delete;
+    BatchingExecutor& operator=(const BatchingExecutor&) = delete;
+    std::future<std::vector<double>> submit(std::vector<double> input);
+    std::vector<double> infer(const std::vector<double>& input);
+    void addSubmitter();
+    void removeSubmitter();
+    void stop();
+    BatchingStats getStats() const;
+    ~BatchingExecutor();
+
+private:
+    //---------------------------------------------------------------------------------------------------------------
+    //【结构体名】PendingRequest
+    //【功能】等待批处理的请求
+    //---------------------------------------------------------------------------------------------------------------
+    struct PendingRequest {
+        std::vector<double> input;                 // 输入样本
+        std::promise<std::vector<double>> result;  // 最后一层输出
+    };
+
+    void run();                                   // 批处理线程主循环
+    const ModelHandle& model;                     // 推理模型
+    BatchingOptions options;                      // 批处理参数
+    mutable std::mutex mutex;                     // 保护以下成员
+    std::condition_variable queueChanged;         // 队列变化或停止时通知批处理线程
+    std::deque<PendingRequest> queue;             // 等待中的请求
+    size_t submitters;                            // 已登记的提交者数量
+    bool stopping;                                // 是否已请求停止
+    BatchingStats stats;                          // 统计
+    std::thread worker;                           // 批处理线程
+};
+
+#endif // BATCHING_EXECUTOR_HPP
@@ -0,0 +1,377 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】CompiledNetwork.cpp
+//【功能模块和目的】紧凑推理网络类的实现，包含从Network编译、CSR合法性检查和稀疏前向传播
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 批量推理在共享线程池上按行并行
+//【更改记录】2026年10月19日 批量推理按激活函数类型分段激活
+//【更改记录】2026年10月19日 推理按段调用按激活函数类型实例化的层计算函数
+//【更改记录】2026年10月19日 编译时用Layer::indexOf换算前驱下标
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "CompiledNetwork.hpp" // 紧凑推理网络类头文件
+#include "ThreadPool.hpp"      // 线程池类头文件
+#include <algorithm>           // std::max、std::stable_sort
+#include <iostream>            // 输入输出流头文件
+#include <stdexcept>           // 标准异常头文件
+
+namespace {
+
+const size_t PARALLEL_MIN_WORK = 16384; // 批量推理中每个并行块的最少乘加次数
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::CompiledNetwork
+//【函数功能】CompiledNetwork类的默认构造函数，创建空网络
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork::CompiledNetwork() : networkName("Untitled") {}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::CompiledNetwork
+//【函数功能】从Network编译紧凑网络。逐个神经元读取树突，按前驱神经元在前一层中的下标
+//        生成CSR行；只保留实际存在的突触，因此部分连接的网络不会被补全为全连接
+//【参数】network - 源网络
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 前驱下标改由Layer::indexOf给出，不再对空指针或其他层的指针做减法
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork::CompiledNetwork(const Network& network) : networkName(network.getName()) {
+    const Layer* previous = nullptr;
+    for (const auto* layer : network.getLayers()) {
+        CompiledLayer compiled;
+        for (const auto& neuron : layer->getNeurons()) {
+            compiled.biases.push_back(neuron.getBias());
+            compiled.activationTypes.push_back(neuron.getActivationFunctionType());
+        }
+        if (previous != nullptr) {
+            compiled.rowOffsets.push_back(0);
+            for (const auto& neuron : layer->getNeurons()) {
+                for (const auto* dendrite : neuron.getDendrites()) {
+                    const int column = previous->indexOf(dendrite->getPre());
+                    if (column < 0) {
+                        continue; // 跳过不来自前一层的突触
+                    }
+                    compiled.columnIndices.push_back(column);
+                    compiled.values.push_back(dendrite->getWeight());
+                }
+                compiled.rowOffsets.push_back(static_cast<int>(compiled.values.size()));
+            }
+        }
+        addLayer(compiled);
+        previous = layer;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::validateLayer
+//【函数功能】检查待追加层的偏置、激活函数类型与CSR结构是否一致，列下标是否在前一层范围内
+//【参数】layer - 待追加的层
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void CompiledNetwork::validateLayer(const CompiledLayer& layer) const {
+    const int neuronCount = layer.getNeuronCount();
+    if (neuronCount == 0 || static_cast<int>(layer.activationTypes.size()) != neuronCount) {
+        std::cerr << "Error: Compiled layer has no neurons or mismatched activation types.\n";
+        throw std::invalid_argument("Compiled layer has no neurons or mismatched activation types.");
+    }
+    if (layers.empty()) {// 输入层没有突触
+        if (!layer.rowOffsets.empty() || !layer.values.empty()) {
+            std::cerr << "Error: The first compiled layer cannot have synapses.\n";
+            throw std::invalid_argument("The first compiled layer cannot have synapses.");
+        }
+        return;
+    }
+    const int previousCount = layers.back().getNeuronCount();
+    if (static_cast<int>(layer.rowOffsets.size()) != neuronCount + 1 || layer.rowOffsets.front() != 0 ||
+        layer.rowOffsets.back() != layer.getSynapseCount() ||
+        layer.columnIndices.size() != layer.values.size()) {
+        std::cerr << "Error: Compiled layer has an invalid CSR structure.\n";
+        throw std::invalid_argument("Compiled layer has an invalid CSR structure.");
+    }
+    for (int i = 0; i < neuronCount; ++i) {
+        if (layer.rowOffsets[i] > layer.rowOffsets[i + 1]) {
+            std::cerr << "Error: Compiled layer row offsets are not monotonic.\n";
+            throw std::invalid_argument("Compiled layer row offsets are not monotonic.");
+        }
+    }
+    for (int column : layer.columnIndices) {
+        if (column < 0 || column >= previousCount) {
+            std::cerr << "Error: Compiled layer column index out of range.\n";
+            throw std::out_of_range("Compiled layer column index out of range");
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::prepareSegments
+//【函数功能】把神经元按激活函数类型稳定排序得到执行顺序及其逆，并把执行顺序划分为同类型的连续段，
+//           为每段选定层计算函数。各层只有一种激活函数时执行顺序即原顺序，只有一段
+//【参数】layer - 已通过检查的层
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 为每段选定层计算函数
+//-------------------------------------------------------------------------------------------------------------------
+void CompiledNetwork::prepareSegments(CompiledLayer& layer) {
+    const int neuronCount = layer.getNeuronCount();
+    layer.executionOrder.resize(neuronCount);
+    for (int i = 0; i < neuronCount; ++i) {
+        layer.executionOrder[i] = i;
+    }
+    const std::vector<int>& types = layer.activationTypes;
+    std::stable_sort(layer.executionOrder.begin(), layer.executionOrder.end(),
+                     [&types](int a, int b) { return types[a] < types[b]; });
+    layer.positions.resize(neuronCount);
+    layer.segmentOffsets.clear();
+    layer.segmentTypes.clear();
+    layer.segmentKernels.clear();
+    for (int p = 0; p < neuronCount; ++p) {
+        const int neuron = layer.executionOrder[p];
+        layer.positions[neuron] = p;
+        if (p == 0 || types[neuron] != layer.segmentTypes.back()) {
+            layer.segmentOffsets.push_back(p);
+            layer.segmentTypes.push_back(types[neuron]);
+            layer.segmentKernels.push_back(LayerKernel::select(types[neuron]));
+        }
+    }
+    layer.segmentOffsets.push_back(neuronCount);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::addLayer
+//【函数功能】检查后在网络末尾追加一层，并生成其执行顺序和激活函数分段
+//【参数】layer - 待追加的层
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 生成执行顺序和激活函数分段
+//-------------------------------------------------------------------------------------------------------------------
+void CompiledNetwork::addLayer(const CompiledLayer& layer) {
+    validateLayer(layer);
+    layers.push_back(layer);
+    prepareSegments(layers.back());
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::forward
+//【函数功能】单样本前向传播，每层执行一次稀疏矩阵-向量乘，计算量与突触数量成正比。
+//           每个激活函数段调用一次该段的层计算函数，激活已在编译期确定
+//【参数】inputs - 输入向量，长度须等于第一层神经元数量
+//【返回值】std::vector<std::vector<double>> - 每一层的输出，与Network::forward一致
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 按激活函数段调用层计算函数
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<std::vector<double>> CompiledNetwork::forward(const std::vector<double>& inputs) const {
+    if (layers.empty()) {
+        std::cerr << "Error: Network is empty. Cannot perform forward propagation.\n";
+        throw std::runtime_error("Network is empty. Cannot perform forward propagation.");
+    }
+    if (static_cast<int>(inputs.size()) != getInputSize()) {
+        std::cerr << "Error: Input size does not match the number of neurons in the first layer.\n";
+        throw std::invalid_argument("Input size does not match the number of neurons in the first layer.");
+    }
+    std::vector<std::vector<double>> outputs(layers.size());
+    const CompiledLayer& first = layers.front();
+    outputs[0].resize(first.getNeuronCount());
+    for (size_t g = 0; g < first.segmentKernels.size(); ++g) {
+        first.segmentKernels[g].evaluateInput(first, first.segmentOffsets[g], first.segmentOffsets[g + 1],
+                                              inputs.data(), outputs[0].data());
+    }
+    for (size_t l = 1; l < layers.size(); ++l) {
+        const CompiledLayer& layer = layers[l];
+        outputs[l].resize(layer.getNeuronCount());
+        for (size_t g = 0; g < layer.segmentKernels.size(); ++g) {
+            layer.segmentKernels[g].evaluate(layer, layer.segmentOffsets[g], layer.segmentOffsets[g + 1],
+                                             outputs[l - 1].data(), outputs[l].data());
+        }
+    }
+    return outputs;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::forwardBatch
+//【函数功能】批量推理。激活值按“神经元 × 样本”存放，每个非零权重对整批样本做一次连续的
+//        乘加（SpMM），内层循环在样本维度上连续，便于编译器向量化。每层的各行互不依赖，
+//        在共享线程池上按行并行；每块至少约16K次乘加，层小于一块时在调用线程中直接计算。
+//        缓冲区中的行按层的执行顺序存放，同一激活函数的神经元相邻，每段调用该段的层计算函数累加后整段激活；
+//        读取前一层时经positions换算行位置，每个非零权重只换算一次。每个神经元的求和顺序不变，结果与逐个激活相同
+//【参数】inputs - 输入样本，每个长度须等于第一层神经元数量
+//【返回值】std::vector<std::vector<double>> - 每个样本最后一层的输出
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 各层按行在共享线程池上并行
+//【更改记录】2026年10月19日 按激活函数分段激活
+//【更改记录】2026年10月19日 按段调用层计算函数
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<std::vector<double>> CompiledNetwork::forwardBatch(const std::vector<std::vector<double>>& inputs) const {
+    if (layers.empty()) {
+        std::cerr << "Error: Network is empty. Cannot perform forward propagation.\n";
+        throw std::runtime_error("Network is empty. Cannot perform forward propagation.");
+    }
+    const size_t batchSize = inputs.size();
+    const CompiledLayer& first = layers.front();
+    std::vector<double> current(first.getNeuronCount() * batchSize);
+    for (size_t s = 0; s < batchSize; ++s) {
+        if (static_cast<int>(inputs[s].size()) != getInputSize()) {
+            std::cerr << "Error: Input size does not match the number of neurons in the first layer.\n";
+            throw std::invalid_argument("Input size does not match the number of neurons in the first layer.");
+        }
+        for (int i = 0; i < first.getNeuronCount(); ++i) {
+            current[first.positions[i] * batchSize + s] = inputs[s][i] + first.biases[i];
+        }
+    }
+    for (size_t g = 0; g < first.segmentKernels.size(); ++g) {
+        first.segmentKernels[g].activate(current.data() + first.segmentOffsets[g] * batchSize,
+                                         (first.segmentOffsets[g + 1] - first.segmentOffsets[g]) * batchSize);
+    }
+    std::vector<double> next;
+    for (size_t l = 1; l < layers.size(); ++l) {
+        const CompiledLayer& layer = layers[l];
+        const int* previousPositions = layers[l - 1].positions.data();
+        next.resize(layer.getNeuronCount() * batchSize);
+        const double* source = current.data();
+        double* target = next.data();
+        // 对执行顺序中[rowBegin, rowEnd)的行，按与之相交的每个激活函数段调用该段的层计算函数
+        auto computeRows = [&layer, previousPositions, source, target, batchSize](size_t rowBegin, size_t rowEnd) {
+            for (size_t g = 0; g < layer.segmentKernels.size(); ++g) {
+                const size_t begin = std::max(rowBegin, static_cast<size_t>(layer.segmentOffsets[g]));
+                const size_t end = std::min(rowEnd, static_cast<size_t>(layer.segmentOffsets[g + 1]));
+                if (begin < end) {
+                    layer.segmentKernels[g].evaluateBatch(layer, previousPositions, batchSize, begin, end, source,
+                                                          target);
+                    layer.segmentKernels[g].activate(target + begin * batchSize, (end - begin) * batchSize);
+                }
+            }
+        };
+        const size_t rows = static_cast<size_t>(layer.getNeuronCount());
+        const size_t rowWork = (static_cast<size_t>(layer.getSynapseCount()) / std::max<size_t>(rows, 1) + 2)
+                               * std::max<size_t>(batchSize, 1);
+        const size_t minRows = std::max<size_t>(1, PARALLEL_MIN_WORK / rowWork);
+        if (rows <= minRows) {
+            computeRows(0, rows);
+        } else {
+            ThreadPool::shared().parallelFor(0, rows, computeRows, minRows);
+        }
+        current.swap(next);
+    }
+    const CompiledLayer& last = layers.back();
+    const int outputSize = getOutputSize();
+    std::vector<std::vector<double>> results(batchSize, std::vector<double>(outputSize));
+    for (size_t s = 0; s < batchSize; ++s) {
+        for (int i = 0; i < outputSize; ++i) {
+            results[s][i] = current[last.positions[i] * batchSize + s];
+        }
+    }
+    return results;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getLayer
+//【函数功能】获取指定索引的层
+//【参数】index - 层索引
+//【返回值】const CompiledLayer& - 指定层
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+const CompiledLayer& CompiledNetwork::getLayer(int index) const {
+    if (index < 0 || index >= static_cast<int>(layers.size())) {
+        std::cerr << "Error: Layer index out of range.\n";
+        throw std::out_of_range("Layer index out of range");
+    }
+    return layers[index];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getLayerCount
+//【函数功能】获取层数
+//【参数】无
+//【返回值】int - 层数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int CompiledNetwork::getLayerCount() const {
+    return static_cast<int>(layers.size());
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getInputSize
+//【函数功能】获取输入宽度，即第一层神经元数量
+//【参数】无
+//【返回值】int - 输入宽度，空网络为0
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int CompiledNetwork::getInputSize() const {
+    return layers.empty() ? 0 : layers.front().getNeuronCount();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getOutputSize
+//【函数功能】获取输出宽度，即最后一层神经元数量
+//【参数】无
+//【返回值】int - 输出宽度，空网络为0
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int CompiledNetwork::getOutputSize() const {
+    return layers.empty() ? 0 : layers.back().getNeuronCount();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getSynapseCount
+//【函数功能】获取网络中实际存储的突触总数（非零元个数）
+//【参数】无
+//【返回值】size_t - 突触总数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t CompiledNetwork::getSynapseCount() const {
+    size_t count = 0;
+    for (const auto& layer : layers) {
+        count += layer.values.size();
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getDenseSynapseCount
+//【函数功能】获取相同层结构下相邻层全连接时的突触总数，用于计算稀疏度
+//【参数】无
+//【返回值】size_t - 全连接突触总数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t CompiledNetwork::getDenseSynapseCount() const {
+    size_t count = 0;
+    for (size_t l = 1; l < layers.size(); ++l) {
+        count += static_cast<size_t>(layers[l - 1].getNeuronCount()) * layers[l].getNeuronCount();
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::setName
+//【函数功能】设置网络名称
+//【参数】name - 网络名称
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void CompiledNetwork::setName(const std::string& name) {
+    networkName = name;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】CompiledNetwork::getName
+//【函数功能】获取网络名称
+//【参数】无
+//【返回值】std::string - 网络名称
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::string CompiledNetwork::getName() const {
+    return networkName;
+}
@@ -0,0 +1,89 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】CompiledNetwork.hpp
+//【功能模块和目的】紧凑推理网络类的声明，以CSR（压缩稀疏行）格式存储每层实际存在的突触，
+//                  供剪枝后的稀疏模型以与非零权重数量成正比的内存和时间执行推理
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 每层按激活函数类型划分执行段，批量推理对每段调用一次激活
+//【更改记录】2026年10月19日 每段在编译时选定按激活函数类型实例化的层计算函数
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef COMPILED_NETWORK_HPP
+#define COMPILED_NETWORK_HPP
+
+#include "Network.hpp" // 网络类头文件
+#include "LayerKernel.hpp" // 层计算函数头文件
+#include <cstddef>     // size_t所属头文件
+#include <string>      // 字符串所属头文件
+#include <vector>      // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】CompiledLayer
+//【功能】一层神经元的紧凑表示。第0层（输入层）没有突触，输出为 f(x + b)；
+//        其余层第i个神经元的突触位于 [rowOffsets[i], rowOffsets[i+1])，
+//        columnIndices为前一层神经元下标，values为对应权重。
+//        执行顺序由addLayer生成：神经元按激活函数类型稳定排序，同类型的神经元在批量推理的激活值缓冲区中
+//        连续存放，每段只调用一次激活函数。神经元下标、CSR和推理结果的顺序都不受影响。
+//        每段同时选定该激活函数类型的层计算函数，推理时按段调用，不再逐个神经元判断类型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加执行顺序和激活函数分段
+//【更改记录】2026年10月19日 增加各段的层计算函数
+//-------------------------------------------------------------------------------------------------------------------
+struct CompiledLayer {
+    std::vector<double> biases;        // 每个神经元的偏置
+    std::vector<int> activationTypes;  // 每个神经元的激活函数类型
+    std::vector<int> rowOffsets;       // CSR行偏移，长度为神经元数+1（第0层为空）
+    std::vector<int> columnIndices;    // CSR列下标，即前一层神经元下标
+    std::vector<double> values;        // CSR权重值
+    std::vector<int> executionOrder;   // 执行顺序中第p个位置的神经元下标（由addLayer生成）
+    std::vector<int> positions;        // 神经元在执行顺序中的位置，即executionOrder的逆（由addLayer生成）
+    std::vector<int> segmentOffsets;   // 各激活函数段在执行顺序中的起点，长度为段数+1（由addLayer生成）
+    std::vector<int> segmentTypes;     // 各段的激活函数类型（由addLayer生成）
+    std::vector<LayerKernel> segmentKernels; // 各段的层计算函数（由addLayer生成）
+    int getNeuronCount() const { return static_cast<int>(biases.size()); }    // 神经元数量
+    int getSynapseCount() const { return static_cast<int>(values.size()); }   // 突触数量
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】CompiledNetwork
+//【功能】只读推理用的紧凑网络：每层以CSR存储突触，前向传播使用稀疏矩阵-向量乘（SpMV），
+//        批量推理使用稀疏矩阵-矩阵乘（SpMM）。所有推理接口均为const，不修改模型状态
+//【接口说明】
+//  - CompiledNetwork(): 默认构造函数，创建空网络
+//  - explicit CompiledNetwork(const Network& network): 从Network编译，只保留实际存在的突触
+//  - void addLayer(const CompiledLayer& layer): 追加一层并检查其合法性，生成执行顺序和激活函数分段
+//  - std::vector<std::vector<double>> forward(const std::vector<double>& inputs) const: 单样本前向传播，返回每层输出
+//  - std::vector<std::vector<double>> forwardBatch(const std::vector<std::vector<double>>& inputs) const: 批量推理，返回每个样本最后一层的输出
+//  - const CompiledLayer& getLayer(int index) const: 获取指定层
+//  - int getLayerCount() const: 获取层数
+//  - int getInputSize() const / int getOutputSize() const: 获取输入/输出宽度
+//  - size_t getSynapseCount() const: 获取突触总数
+//  - size_t getDenseSynapseCount() const: 获取同结构全连接网络的突触总数
+//  - void setName(const std::string& name) / std::string getName() const: 设置/获取网络名称
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 批量推理按激活函数分段执行
+//【更改记录】2026年10月19日 单样本和批量推理按段调用编译时选定的层计算函数
+//-------------------------------------------------------------------------------------------------------------------
+class CompiledNetwork {
+public:
+    CompiledNetwork();                                            // 默认构造函数
+    explicit CompiledNetwork(const Network& network);             // 从Network编译
+    void addLayer(const CompiledLayer& layer);                    // 追加一层
+    std::vector<std::vector<double>> forward(const std::vector<double>& inputs) const; // 单样本前向传播
+    std::vector<std::vector<double>> forwardBatch(const std::vector<std::vector<double>>& inputs) const; // 批量推理
+    const CompiledLayer& getLayer(int index) const;               // 获取指定层
+    int getLayerCount() const;                                    // 获取层数
+    int getInputSize() const;                                     // 获取输入宽度
+    int getOutputSize() const;                                    // 获取输出宽度
+    size_t getSynapseCount() const;                               // 获取突触总数
+    size_t getDenseSynapseCount() const;                          // 获取全连接时的突触总数
+    void setName(const std::string& name);                        // 设置网络名称
+    std::string getName() const;                                  // 获取网络名称
+
+private:
+    void validateLayer(const CompiledLayer& layer) const;         // 检查新层与当前最后一层是否匹配
+    static void prepareSegments(CompiledLayer& layer);            // 生成执行顺序、激活函数分段和各段的层计算函数
+    std::vector<CompiledLayer> layers;                            // 各层的紧凑表示
+    std::string networkName;                                      // 网络名称
+};
+
+#endif // COMPILED_NETWORK_HPP
@@ -0,0 +1,315 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 【文件名】CppExporter.cpp
+// 【功能模块和目的】C++源码导出类的实现
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 参数数组改为infer内的局部静态常量
+//-------------------------------------------------------------------------------------------------------------------
+#include "CppExporter.hpp" // C++源码导出类头文件
+#include "Tracer.hpp"      // 时间线跟踪
+#include <cctype>          // 字符分类
+#include <cmath>           // std::isfinite
+#include <fstream>         // 文件流头文件
+#include <iostream>        // 输入输出流头文件
+#include <sstream>         // 字符串流头文件
+#include <stdexcept>       // 标准异常头文件
+#include <vector>          // 向量头文件
+
+namespace {
+
+const int VALUES_PER_LINE = 8; // 常量数组每行写出的元素数
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】floatLiteral
+// 【函数功能】把数值写成float字面量，保留float的全部有效数字（9位），超出float范围或非有限值时抛出异常
+// 【参数】value - 数值
+// 【返回值】std::string - 字面量，例如 0.353600001f
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::string floatLiteral(double value) {
+    float rounded = static_cast<float>(value);
+    if (!std::isfinite(rounded)) {
+        std::cerr << "Error: Parameter " << value << " cannot be represented as a finite float.\n";
+        throw std::invalid_argument("Parameter cannot be represented as a finite float");
+    }
+    std::ostringstream stream;
+    stream.precision(9);
+    stream << rounded;
+    std::string text = stream.str();
+    if (text.find_first_of(".e") == std::string::npos) {
+        text += ".0";
+    }
+    return text + "f";
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】isDense
+// 【函数功能】判断一层是否按稠密矩阵生成：突触数不少于前一层宽度×本层宽度的一半时，按行连续存放的稠密循环
+//           比CSR的间接寻址更快，缺失的突触补0
+// 【参数】layer - 层，previousWidth - 前一层宽度
+// 【返回值】bool - 是否按稠密矩阵生成
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool isDense(const CompiledLayer& layer, int previousWidth) {
+    return 2LL * layer.getSynapseCount() >= static_cast<long long>(layer.getNeuronCount()) * previousWidth;
+}
+
+// 第index层参数数组的名称
+std::string parameterName(int index, const std::string& kind) {
+    return "layer" + std::to_string(index) + kind;
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::getNamespaceName
+// 【函数功能】由网络名称生成命名空间名：字母、数字和下划线保留，其他字符替换为下划线，
+//           以数字开头时加前缀"model_"，名称为空时为"model"
+// 【参数】networkName - 网络名称
+// 【返回值】std::string - 命名空间名
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::string CppExporter::getNamespaceName(const std::string& networkName) {
+    std::string name;
+    for (char c : networkName) {
+        name += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+    if (name.empty()) {
+        return "model";
+    }
+    if (std::isdigit(static_cast<unsigned char>(name[0]))) {
+        name = "model_" + name;
+    }
+    return name;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::isHeader
+// 【函数功能】判断导出文件是否为头文件
+// 【参数】无
+// 【返回值】bool - 扩展名为hpp或h时为true
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool CppExporter::isHeader() const {
+    std::string extension = GetExtName(filename);
+    return extension == "hpp" || extension == "h";
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::exportNetwork
+// 【函数功能】把网络编译为CompiledNetwork后导出，只包含实际存在的突触
+// 【参数】network - 要导出的神经网络
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void CppExporter::exportNetwork(const Network& network) {
+    exportNetwork(CompiledNetwork(network));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::exportNetwork
+// 【函数功能】生成C++代码：infer开头写出各层的float参数数组（函数内的局部静态常量，头文件被多个
+//           翻译单元包含时inline函数及其参数只有一份），随后依次计算各层，中间结果存放在栈上的定长数组中，
+//           最后一层直接写入output。生成的代码只依赖<cmath>，以float计算，结果与本库的double推理
+//           在float舍入误差范围内相同
+// 【参数】network - 要导出的稀疏网络
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 参数数组由命名空间作用域移入infer，修复头文件模式的ODR违规和参数重复
+//-------------------------------------------------------------------------------------------------------------------
+void CppExporter::exportNetwork(const CompiledNetwork& network) {
+    CANN_TRACE_SCOPE("export", "CppExporter::exportNetwork");
+    if (network.getLayerCount() == 0) {
+        std::cerr << "Error: Network is empty. Cannot export.\n";
+        throw std::invalid_argument("Network is empty. Cannot export.");
+    }
+    const std::string space = getNamespaceName(network.getName());
+    const bool header = isHeader();
+    const int layerCount = network.getLayerCount();
+    std::ostringstream out; // 全部生成完毕后再写文件，参数无法表示时不留下不完整的文件
+
+    out << "// " << filename << "\n";
+    out << "// 由CppExporter从网络 " << network.getName() << " 生成，不依赖CANN，请勿手工修改\n";
+    out << "// " << layerCount << " 层，" << network.getInputSize() << " 个输入，" << network.getOutputSize()
+        << " 个输出，" << network.getSynapseCount() << " 个突触\n";
+    std::string guard;
+    if (header) {
+        for (char c : space) {
+            guard += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        guard = "CANN_GENERATED_" + guard + "_HPP";
+        out << "\n#ifndef " << guard << "\n#define " << guard << "\n";
+    }
+    out << "\n#include <cmath>\n\nnamespace " << space << " {\n\n";
+    out << "const int inputSize = " << network.getInputSize() << ";\n";
+    out << "const int outputSize = " << network.getOutputSize() << ";\n\n";
+
+    out << "// input有inputSize个元素，output有outputSize个元素\n";
+    out << (header ? "inline " : "") << "void infer(const float* input, float* output) {\n";
+    for (int l = 0; l < layerCount; ++l) {
+        writeParameters(out, network.getLayer(l), l, l == 0 ? 0 : network.getLayer(l - 1).getNeuronCount());
+    }
+    std::string previous = "input";
+    for (int l = 0; l < layerCount; ++l) {
+        const CompiledLayer& layer = network.getLayer(l);
+        std::string buffer = "output";
+        if (l + 1 < layerCount) {
+            buffer = "layer" + std::to_string(l);
+            out << "    float " << buffer << "[" << layer.getNeuronCount() << "];\n";
+        }
+        writeLayer(out, layer, l, l == 0 ? 0 : network.getLayer(l - 1).getNeuronCount(), previous, buffer);
+        previous = buffer;
+    }
+    out << "}\n\n} // namespace " << space << "\n";
+    if (header) {
+        out << "\n#endif // " << guard << "\n";
+    }
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create file: " + filename);
+    }
+    file << out.str();
+    file.close();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::writeArray
+// 【函数功能】在infer函数体内写出static const局部常量数组，每行VALUES_PER_LINE个元素；元素个数为0时不写出
+// 【参数】out - 输出流，name - 数组名，values - 元素，count - 元素个数
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 改为函数体内的缩进
+//-------------------------------------------------------------------------------------------------------------------
+void CppExporter::writeArray(std::ostream& out, const std::string& name, const double* values, int count) {
+    if (count == 0) {
+        return;
+    }
+    out << "    static const float " << name << "[" << count << "] = {";
+    for (int i = 0; i < count; ++i) {
+        out << (i % VALUES_PER_LINE == 0 ? "\n        " : " ") << floatLiteral(values[i]) << ",";
+    }
+    out << "\n    };\n";
+}
+
+void CppExporter::writeArray(std::ostream& out, const std::string& name, const int* values, int count) {
+    if (count == 0) {
+        return;
+    }
+    out << "    static const int " << name << "[" << count << "] = {";
+    for (int i = 0; i < count; ++i) {
+        out << (i % VALUES_PER_LINE == 0 ? "\n        " : " ") << values[i] << ",";
+    }
+    out << "\n    };\n";
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::writeParameters
+// 【函数功能】写出一层的参数：偏置layerNBiases；稠密层为按行存放的layerNWeights（缺失的突触为0），
+//           稀疏层为CSR数组layerNOffsets、layerNColumns、layerNValues。第0层只有偏置
+// 【参数】out - 输出流，layer - 层，index - 层索引，previousWidth - 前一层宽度
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 写在infer函数体内
+//-------------------------------------------------------------------------------------------------------------------
+void CppExporter::writeParameters(std::ostream& out, const CompiledLayer& layer, int index, int previousWidth) {
+    writeArray(out, parameterName(index, "Biases"), layer.biases.data(), layer.getNeuronCount());
+    if (index > 0 && layer.getSynapseCount() > 0) {
+        if (isDense(layer, previousWidth)) {
+            std::vector<double> weights(static_cast<size_t>(layer.getNeuronCount()) * previousWidth, 0.0);
+            for (int i = 0; i < layer.getNeuronCount(); ++i) {
+                for (int k = layer.rowOffsets[i]; k < layer.rowOffsets[i + 1]; ++k) {
+                    weights[static_cast<size_t>(i) * previousWidth + layer.columnIndices[k]] += layer.values[k];
+                }
+            }
+            writeArray(out, parameterName(index, "Weights"), weights.data(), static_cast<int>(weights.size()));
+        } else {
+            writeArray(out, parameterName(index, "Offsets"), layer.rowOffsets.data(),
+                       static_cast<int>(layer.rowOffsets.size()));
+            writeArray(out, parameterName(index, "Columns"), layer.columnIndices.data(), layer.getSynapseCount());
+            writeArray(out, parameterName(index, "Values"), layer.values.data(), layer.getSynapseCount());
+        }
+    }
+    out << "\n";
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::writeLayer
+// 【函数功能】写出一层的计算循环，循环边界为常量。第0层为 x + b；其他层从偏置开始累加加权输入，
+//           稠密层按行遍历layerNWeights，稀疏层遍历CSR，没有突触的层只复制偏置。最后写出激活循环
+// 【参数】out - 输出流，layer - 层，index - 层索引，previousWidth - 前一层宽度，
+//        input - 前一层结果的数组名，output - 本层结果的数组名
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void CppExporter::writeLayer(std::ostream& out, const CompiledLayer& layer, int index, int previousWidth,
+                             const std::string& input, const std::string& output) {
+    const int width = layer.getNeuronCount();
+    const std::string biases = parameterName(index, "Biases");
+    if (width == 0) {
+        return;
+    }
+    out << "    for (int i = 0; i < " << width << "; ++i) {\n";
+    if (index == 0) {
+        out << "        " << output << "[i] = " << input << "[i] + " << biases << "[i];\n";
+    } else if (layer.getSynapseCount() == 0) {
+        out << "        " << output << "[i] = " << biases << "[i];\n";
+    } else if (isDense(layer, previousWidth)) {
+        out << "        const float* weights = " << parameterName(index, "Weights") << " + i * " << previousWidth << ";\n"
+            << "        float sum = " << biases << "[i];\n"
+            << "        for (int j = 0; j < " << previousWidth << "; ++j) {\n"
+            << "            sum += weights[j] * " << input << "[j];\n"
+            << "        }\n"
+            << "        " << output << "[i] = sum;\n";
+    } else {
+        const std::string offsets = parameterName(index, "Offsets");
+        out << "        float sum = " << biases << "[i];\n"
+            << "        for (int k = " << offsets << "[i]; k < " << offsets << "[i + 1]; ++k) {\n"
+            << "            sum += " << parameterName(index, "Values") << "[k] * " << input << "["
+            << parameterName(index, "Columns") << "[k]];\n"
+            << "        }\n"
+            << "        " << output << "[i] = sum;\n";
+    }
+    out << "    }\n";
+    writeActivation(out, layer, output);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】CppExporter::writeActivation
+// 【函数功能】把一层按神经元顺序分成激活函数类型相同的连续段，每段写出一个专用循环。
+//           线性段不需要计算，未知类型与ActivationFunc::apply一致按线性处理
+// 【参数】out - 输出流，layer - 层，buffer - 本层结果的数组名
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void CppExporter::writeActivation(std::ostream& out, const CompiledLayer& layer, const std::string& buffer) {
+    const int width = layer.getNeuronCount();
+    int begin = 0;
+    while (begin < width) {
+        int type = layer.activationTypes[begin];
+        int end = begin + 1;
+        while (end < width && layer.activationTypes[end] == type) {
+            ++end;
+        }
+        std::string value = buffer + "[i]";
+        std::string expression;
+        switch (type) {
+            case 1: expression = "1.0f / (1.0f + std::exp(-" + value + "))"; break; // Sigmoid
+            case 2: expression = "std::tanh(" + value + ")"; break;                  // Tanh
+            case 3: expression = value + " > 0.0f ? " + value + " : 0.0f"; break;    // ReLU
+            default: break;                                                          // Linear
+        }
+        if (!expression.empty()) {
+            out << "    for (int i = " << begin << "; i < " << end << "; ++i) {\n"
+                << "        " << value << " = " << expression << ";\n"
+                << "    }\n";
+        }
+        begin = end;
+    }
+}
@@ -0,0 +1,48 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】CppExporter.hpp
+//【功能模块和目的】C++源码导出类的声明，把网络生成为不依赖本库的C++代码，可直接编译进对延迟敏感的程序
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef CPP_EXPORTER_HPP
+#define CPP_EXPORTER_HPP
+
+#include "FilePorter.hpp"      // 文件操作基类头文件
+#include "Network.hpp"         // 网络类头文件
+#include "CompiledNetwork.hpp" // 稀疏推理网络类头文件
+#include <ostream>             // 输出流头文件
+#include <string>              // 字符串所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】CppExporter
+//【功能】将网络导出为自包含的C++代码：参数为float常量数组，每层生成边界为常量的专用循环，
+//        入口为 void infer(const float* input, float* output)，位于以网络名称命名的命名空间中。
+//        扩展名为hpp/h时生成仅头文件的代码（inline函数、包含保护），为cpp/cc时生成源文件
+//【接口说明】继承自FilePorter
+//  - explicit CppExporter(const std::string& filename): 构造函数，初始化文件名并验证文件类型
+//  - void exportNetwork(const Network& network): 编译为CompiledNetwork后导出，缺失的突触按权重0处理
+//  - void exportNetwork(const CompiledNetwork& network): 导出稀疏网络，只包含实际存储的突触
+//  - static std::string getNamespaceName(const std::string& networkName): 生成代码使用的命名空间名
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class CppExporter : public FilePorter<FilePorterType::EXPORTER> {
+public:
+    explicit CppExporter(const std::string& filename)
+        : FilePorter<FilePorterType::EXPORTER>(filename, { "hpp", "h", "cpp", "cc" }) {}
+    void exportNetwork(const Network& network);
+    void exportNetwork(const CompiledNetwork& network);
+    static std::string getNamespaceName(const std::string& networkName);
+
+private:
+    bool isHeader() const; // 是否生成头文件
+    static void writeArray(std::ostream& out, const std::string& name, const double* values, int count); // 写出float常量数组
+    static void writeArray(std::ostream& out, const std::string& name, const int* values, int count);    // 写出int常量数组
+    static void writeParameters(std::ostream& out, const CompiledLayer& layer, int index, int previousWidth); // 写出一层的参数数组
+    static void writeLayer(std::ostream& out, const CompiledLayer& layer, int index, int previousWidth,
+                           const std::string& input, const std::string& output); // 写出一层的计算循环
+    static void writeActivation(std::ostream& out, const CompiledLayer& layer, const std::string& buffer); // 按激活函数类型分段写出激活循环
+};
+
+#endif // CPP_EXPORTER_HPP
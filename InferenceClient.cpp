@@ -0,0 +1,133 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceClient.cpp
+//【功能模块和目的】本机推理服务客户端的实现（仅Linux）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "InferenceClient.hpp"   // 推理客户端类头文件
+#include "InferenceProtocol.hpp" // 推理协议头文件
+#include <cstring>               // strerror、strncpy
+#include <iostream>              // 输入输出流头文件
+#include <stdexcept>             // 标准异常头文件
+
+#ifdef __linux__
+#include <cerrno>                // errno
+#include <sys/socket.h>          // 套接字
+#include <sys/un.h>              // sockaddr_un
+#include <unistd.h>              // close
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceClient::InferenceClient
+//【函数功能】构造函数，连接服务并发送INFO请求获取模型的输入、输出宽度
+//【参数】socketPath - 服务的套接字路径
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+InferenceClient::InferenceClient(const std::string& socketPath) : fd(-1), inputSize(0), outputSize(0) {
+#ifdef __linux__
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Invalid socket path: " << socketPath << "\n";
+        throw std::invalid_argument("Invalid socket path: " + socketPath);
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::string reason = std::strerror(errno);
+        if (fd >= 0) {
+            close(fd);
+        }
+        std::cerr << "Error: Failed to connect to " << socketPath << ": " << reason << "\n";
+        throw std::runtime_error("Failed to connect to " + socketPath + ": " + reason);
+    }
+    try {
+        std::vector<double> shape = request(InferenceProtocol::TYPE_INFO, {});
+        if (shape.size() != 2) {
+            throw std::runtime_error("Invalid INFO response");
+        }
+        inputSize = static_cast<int>(shape[0]);
+        outputSize = static_cast<int>(shape[1]);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+#else
+    (void)socketPath;
+    std::cerr << "Error: The inference server is only supported on Linux.\n";
+    throw std::runtime_error("The inference server is only supported on Linux.");
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceClient::~InferenceClient
+//【函数功能】析构函数，关闭连接
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+InferenceClient::~InferenceClient() {
+#ifdef __linux__
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceClient::infer
+//【函数功能】发送一个样本并等待最后一层输出
+//【参数】input - 输入样本
+//【返回值】std::vector<double> - 最后一层输出
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<double> InferenceClient::infer(const std::vector<double>& input) {
+    return request(InferenceProtocol::TYPE_INFER, input);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceClient::getInputSize / InferenceClient::getOutputSize
+//【函数功能】获取模型的输入、输出宽度
+//【参数】无
+//【返回值】int - 宽度
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int InferenceClient::getInputSize() const {
+    return inputSize;
+}
+
+int InferenceClient::getOutputSize() const {
+    return outputSize;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceClient::request
+//【函数功能】发送一条请求并读取响应
+//【参数】type - 请求类型，payload - 载荷
+//【返回值】std::vector<double> - 响应载荷
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<double> InferenceClient::request(unsigned short type, const std::vector<double>& payload) {
+    InferenceProtocol::writeValues(fd, type, payload.data(), static_cast<uint32_t>(payload.size()));
+    InferenceMessageHeader header;
+    if (!InferenceProtocol::readHeader(fd, header)) {
+        std::cerr << "Error: Inference server closed the connection.\n";
+        throw std::runtime_error("Inference server closed the connection");
+    }
+    if (header.status != InferenceProtocol::STATUS_OK) {
+        std::string message = InferenceProtocol::readText(fd, header.count);
+        std::cerr << "Error: Inference server returned an error: " << message << "\n";
+        throw std::runtime_error(message);
+    }
+    std::vector<double> result;
+    InferenceProtocol::readValues(fd, header.count, result);
+    return result;
+}
@@ -0,0 +1,43 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceClient.hpp
+//【功能模块和目的】本机推理服务的客户端（仅Linux）：连接InferenceServer的Unix域套接字并逐个发送推理请求
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef INFERENCE_CLIENT_HPP
+#define INFERENCE_CLIENT_HPP
+
+#include <string> // 字符串所属头文件
+#include <vector> // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】InferenceClient
+//【功能】一个连接上的同步客户端，同一对象不能被多个线程同时使用；多个线程或进程应各自创建客户端
+//【接口说明】
+//  - explicit InferenceClient(const std::string& socketPath): 构造函数，连接服务并查询模型的输入、输出宽度
+//  - std::vector<double> infer(const std::vector<double>& input): 发送一个样本并等待最后一层输出，
+//    服务返回错误时抛出std::runtime_error
+//  - int getInputSize() const / int getOutputSize() const: 模型的输入、输出宽度
+//  - ~InferenceClient(): 析构函数，关闭连接
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class InferenceClient {
+public:
+    explicit InferenceClient(const std::string& socketPath);
+    InferenceClient(const InferenceClient&) = delete;
+    InferenceClient& operator=(const InferenceClient&) = delete;
+    std::vector<double> infer(const std::vector<double>& input);
+    int getInputSize() const;
+    int getOutputSize() const;
+    ~InferenceClient();
+
+private:
+    std::vector<double> request(unsigned short type, const std::vector<double>& payload); // 发送请求并读取响应
+    int fd;          // 连接套接字
+    int inputSize;   // 模型输入宽度
+    int outputSize;  // 模型输出宽度
+};
+
+#endif // INFERENCE_CLIENT_HPP
@@ -0,0 +1,130 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceContext.cpp
+//【功能模块和目的】推理临时工作区的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "InferenceContext.hpp" // 推理工作区类头文件
+#include <cstdint>              // uintptr_t
+#include <iostream>             // 输入输出流头文件
+#include <stdexcept>            // 标准异常头文件
+
+const size_t InferenceContext::CACHE_LINE_BYTES;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceContext::InferenceContext / InferenceContext::~InferenceContext
+//【函数功能】构造空工作区；析构时释放缓冲区
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+InferenceContext::InferenceContext() : storage(nullptr), buffer(nullptr), capacity(0) {
+}
+
+InferenceContext::~InferenceContext() {
+    delete[] storage;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceContext::setLayerCount / InferenceContext::setLayerSize
+//【函数功能】设置层数、层宽度，须在allocate之前调用
+//【参数】count - 层数；index - 层索引，size - 层宽度
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceContext::setLayerCount(int count) {
+    if (count < 0) {
+        std::cerr << "Error: Layer count must not be negative.\n";
+        throw std::invalid_argument("Layer count must not be negative");
+    }
+    sizes.resize(count);
+    offsets.resize(count + 1);
+}
+
+void InferenceContext::setLayerSize(int index, int size) {
+    if (index < 0 || index >= static_cast<int>(sizes.size()) || size < 0) {
+        std::cerr << "Error: Invalid layer index or size.\n";
+        throw std::out_of_range("Invalid layer index or size");
+    }
+    sizes[index] = size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceContext::allocate
+//【函数功能】计算各层起始位置（补齐到整缓存行），所需容量超过现有容量时重新分配并对齐，原有内容不保留
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceContext::allocate() {
+    const size_t lineDoubles = CACHE_LINE_BYTES / sizeof(double);
+    size_t total = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        offsets[i] = total;
+        total += (static_cast<size_t>(sizes[i]) + lineDoubles - 1) / lineDoubles * lineDoubles;
+    }
+    offsets[sizes.size()] = total;
+    if (total > capacity) {
+        delete[] storage;
+        storage = nullptr;
+        buffer = nullptr;
+        capacity = 0;
+        storage = new char[total * sizeof(double) + CACHE_LINE_BYTES];
+        uintptr_t address = reinterpret_cast<uintptr_t>(storage);
+        address = (address + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+        buffer = reinterpret_cast<double*>(address);
+        capacity = total;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceContext::getLayer
+//【函数功能】获取第index层激活值的起始地址
+//【参数】index - 层索引
+//【返回值】double* - 起始地址（64字节对齐）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double* InferenceContext::getLayer(int index) {
+    return buffer + offsets[index];
+}
+
+const double* InferenceContext::getLayer(int index) const {
+    return buffer + offsets[index];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceContext::getLayerCount / InferenceContext::getLayerSize
+//【函数功能】获取层数、第index层的宽度
+//【参数】index - 层索引
+//【返回值】int - 层数或宽度
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int InferenceContext::getLayerCount() const {
+    return static_cast<int>(sizes.size());
+}
+
+int InferenceContext::getLayerSize(int index) const {
+    return sizes[index];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceContext::getOutputs
+//【函数功能】复制最后一层的激活值
+//【参数】无
+//【返回值】std::vector<double> - 最后一层激活值，没有层时为空
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<double> InferenceContext::getOutputs() const {
+    if (sizes.empty()) {
+        return {};
+    }
+    const double* last = getLayer(static_cast<int>(sizes.size()) - 1);
+    return std::vector<double>(last, last + sizes.back());
+}
@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceContext.hpp
+//【功能模块和目的】推理的临时工作区：保存一次前向传播中各层的激活值，使Network::infer不修改模型本身，
+//                  同一个Network可由任意多个线程各自带着自己的工作区同时推理
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef INFERENCE_CONTEXT_HPP
+#define INFERENCE_CONTEXT_HPP
+
+#include <cstddef> // size_t所属头文件
+#include <vector>  // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】InferenceContext
+//【功能】按层存放激活值的连续缓冲区。缓冲区起始地址和每层的起始位置都按64字节缓存行对齐，
+//        每层长度补齐到整缓存行，因此不同线程的工作区、同一工作区的不同层都不会共享缓存行。
+//        层数和各层宽度不变时重复使用不会分配内存；一个工作区同时只能被一个线程使用
+//【接口说明】
+//  - InferenceContext(): 默认构造函数，创建空工作区
+//  - void setLayerCount(int count): 设置层数
+//  - void setLayerSize(int index, int size): 设置第index层的宽度
+//  - void allocate(): 按当前各层宽度计算布局，容量不足时重新分配
+//  - double* getLayer(int index) / const double* getLayer(int index) const: 第index层激活值的起始地址
+//  - int getLayerCount() const / int getLayerSize(int index) const: 获取层数、层宽度
+//  - std::vector<double> getOutputs() const: 复制最后一层的激活值
+//  - ~InferenceContext(): 析构函数，释放缓冲区
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class InferenceContext {
+public:
+    static const size_t CACHE_LINE_BYTES = 64; // 缓存行大小
+
+    InferenceContext();
+    InferenceContext(const InferenceContext&) = delete;
+    InferenceContext& operator=(const InferenceContext&) = delete;
+    void setLayerCount(int count);
+    void setLayerSize(int index, int size);
+    void allocate();
+    double* getLayer(int index);
+    const double* getLayer(int index) const;
+    int getLayerCount() const;
+    int getLayerSize(int index) const;
+    std::vector<double> getOutputs() const;
+    ~InferenceContext();
+
+private:
+    std::vector<int> sizes;      // 各层宽度
+    std::vector<size_t> offsets; // 各层在缓冲区中的起始下标（double个数）
+    char* storage;               // 分配的原始内存（多出一个缓存行用于对齐）
+    double* buffer;              // 对齐后的缓冲区
+    size_t capacity;             // 缓冲区容量（double个数）
+};
+
+#endif // INFERENCE_CONTEXT_HPP
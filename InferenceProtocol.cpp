@@ -0,0 +1,207 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceProtocol.cpp
+//【功能模块和目的】本机推理服务二进制协议的实现（仅Linux）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加skipValues
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "InferenceProtocol.hpp" // 推理协议头文件
+#include <cerrno>                // errno
+#include <cstring>               // strerror
+#include <iostream>              // 输入输出流头文件
+#include <stdexcept>             // 标准异常头文件
+
+#ifdef __linux__
+#include <sys/socket.h>          // send、recv
+#endif
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】readFully
+//【函数功能】从套接字读满size字节
+//【参数】fd - 套接字，data - 缓冲区，size - 字节数
+//【返回值】bool - 一个字节都未读到对端即关闭时返回false；读到一部分后关闭则抛出异常
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool readFully(int fd, void* data, size_t size) {
+#ifdef __linux__
+    char* cursor = static_cast<char*>(data);
+    size_t received = 0;
+    while (received < size) {
+        ssize_t result = recv(fd, cursor + received, size - received, 0);
+        if (result == 0) {
+            if (received == 0) {
+                return false;
+            }
+            std::cerr << "Error: Connection closed in the middle of a message.\n";
+            throw std::runtime_error("Connection closed in the middle of a message");
+        }
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Failed to read from socket: ") + std::strerror(errno));
+        }
+        received += static_cast<size_t>(result);
+    }
+    return true;
+#else
+    (void)fd;
+    (void)data;
+    (void)size;
+    std::cerr << "Error: The inference server is only supported on Linux.\n";
+    throw std::runtime_error("The inference server is only supported on Linux.");
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】writeFully
+//【函数功能】向套接字写满size字节，对端已关闭时不产生SIGPIPE而是抛出异常
+//【参数】fd - 套接字，data - 数据，size - 字节数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void writeFully(int fd, const void* data, size_t size) {
+#ifdef __linux__
+    const char* cursor = static_cast<const char*>(data);
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t result = send(fd, cursor + sent, size - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Failed to write to socket: ") + std::strerror(errno));
+        }
+        sent += static_cast<size_t>(result);
+    }
+#else
+    (void)fd;
+    (void)data;
+    (void)size;
+    std::cerr << "Error: The inference server is only supported on Linux.\n";
+    throw std::runtime_error("The inference server is only supported on Linux.");
+#endif
+}
+
+} // namespace
+
+const uint32_t InferenceProtocol::MAGIC;
+const uint32_t InferenceProtocol::MAX_COUNT;
+const uint16_t InferenceProtocol::TYPE_INFER;
+const uint16_t InferenceProtocol::TYPE_INFO;
+const uint16_t InferenceProtocol::STATUS_OK;
+const uint16_t InferenceProtocol::STATUS_ERROR;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceProtocol::readHeader
+//【函数功能】读取并检查消息头
+//【参数】fd - 套接字，header - 读到的消息头
+//【返回值】bool - 对端在消息边界处关闭时返回false
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool InferenceProtocol::readHeader(int fd, InferenceMessageHeader& header) {
+    if (!readFully(fd, &header, sizeof(header))) {
+        return false;
+    }
+    if (header.magic != MAGIC || header.count > MAX_COUNT) {
+        throw std::runtime_error("Invalid inference message header");
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceProtocol::readValues
+//【函数功能】读取count个double载荷
+//【参数】fd - 套接字，count - 元素个数，values - 读到的值
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceProtocol::readValues(int fd, uint32_t count, std::vector<double>& values) {
+    values.resize(count);
+    if (count > 0 && !readFully(fd, values.data(), count * sizeof(double))) {
+        throw std::runtime_error("Connection closed in the middle of a message");
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceProtocol::skipValues
+//【函数功能】读取并丢弃count个double载荷，每次最多读入固定大小的栈上缓冲区，内存占用与count无关
+//【参数】fd - 套接字，count - 元素个数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceProtocol::skipValues(int fd, uint32_t count) {
+    char buffer[4096];
+    size_t remaining = static_cast<size_t>(count) * sizeof(double);
+    while (remaining > 0) {
+        const size_t chunk = remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+        if (!readFully(fd, buffer, chunk)) {
+            throw std::runtime_error("Connection closed in the middle of a message");
+        }
+        remaining -= chunk;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceProtocol::readText
+//【函数功能】读取count字节的错误信息
+//【参数】fd - 套接字，count - 字节数
+//【返回值】std::string - 错误信息
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::string InferenceProtocol::readText(int fd, uint32_t count) {
+    std::string text(count, '\0');
+    if (count > 0 && !readFully(fd, &text[0], count)) {
+        throw std::runtime_error("Connection closed in the middle of a message");
+    }
+    return text;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceProtocol::writeValues
+//【函数功能】写出消息头和count个double载荷，合并为一次写入
+//【参数】fd - 套接字，type - 消息类型，values - 载荷，count - 元素个数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceProtocol::writeValues(int fd, uint16_t type, const double* values, uint32_t count) {
+    InferenceMessageHeader header;
+    header.magic = MAGIC;
+    header.type = type;
+    header.status = STATUS_OK;
+    header.count = count;
+    std::vector<char> message(sizeof(header) + count * sizeof(double));
+    std::memcpy(message.data(), &header, sizeof(header));
+    if (count > 0) {
+        std::memcpy(message.data() + sizeof(header), values, count * sizeof(double));
+    }
+    writeFully(fd, message.data(), message.size());
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceProtocol::writeError
+//【函数功能】写出错误响应
+//【参数】fd - 套接字，type - 所响应的请求类型，message - 错误信息
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceProtocol::writeError(int fd, uint16_t type, const std::string& message) {
+    InferenceMessageHeader header;
+    header.magic = MAGIC;
+    header.type = type;
+    header.status = STATUS_ERROR;
+    header.count = static_cast<uint32_t>(message.size());
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+    data += message;
+    writeFully(fd, data.data(), data.size());
+}
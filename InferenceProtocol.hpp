@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceProtocol.hpp
+//【功能模块和目的】本机推理服务的二进制协议：客户端与InferenceServer之间经Unix域套接字交换的消息格式，
+//                  以及完整读写一条消息的函数。双方在同一主机上，数值按本机字节序直接传输
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加丢弃载荷的skipValues
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef INFERENCE_PROTOCOL_HPP
+#define INFERENCE_PROTOCOL_HPP
+
+#include <cstdint> // 定宽整数
+#include <string>  // 字符串所属头文件
+#include <vector>  // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】InferenceMessageHeader
+//【功能】消息头，其后紧跟载荷：
+//        - 请求TYPE_INFER：count个double，为一个输入样本；响应：count个double，为最后一层输出
+//        - 请求TYPE_INFO：无载荷；响应：2个double，为输入宽度和输出宽度
+//        - 任一响应status非0时，载荷为count字节的错误信息
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct InferenceMessageHeader {
+    uint32_t magic = 0;  // 固定为InferenceProtocol::MAGIC
+    uint16_t type = 0;   // 消息类型
+    uint16_t status = 0; // 响应状态，0为成功
+    uint32_t count = 0;  // 载荷元素个数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】InferenceProtocol
+//【功能】协议常量和消息读写。读写函数在套接字上循环直到完整收发一条消息
+//【接口说明】
+//  - static const uint32_t MAGIC, MAX_COUNT: 消息头魔数、单条消息的最大载荷元素个数
+//  - static const uint16_t TYPE_INFER, TYPE_INFO, STATUS_OK, STATUS_ERROR: 消息类型和响应状态
+//  - static bool readHeader(int fd, InferenceMessageHeader& header): 读取消息头，对端关闭时返回false
+//  - static void readValues(int fd, uint32_t count, std::vector<double>& values): 读取count个double
+//  - static void skipValues(int fd, uint32_t count): 读取并丢弃count个double，只使用固定大小的缓冲区。
+//    接收方应先按模型检查count再读取载荷，不符时用它跳过，不按对端给出的count分配内存
+//  - static std::string readText(int fd, uint32_t count): 读取count字节的错误信息
+//  - static void writeValues(int fd, uint16_t type, const double* values, uint32_t count): 写出带double载荷的消息
+//  - static void writeError(int fd, uint16_t type, const std::string& message): 写出错误响应
+//  读写出错或消息头不合法时抛出std::runtime_error
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加skipValues
+//-------------------------------------------------------------------------------------------------------------------
+class InferenceProtocol {
+public:
+    static const uint32_t MAGIC = 0x4E4E4143; // "CANN"
+    static const uint32_t MAX_COUNT = 1 << 24;
+    static const uint16_t TYPE_INFER = 1;
+    static const uint16_t TYPE_INFO = 2;
+    static const uint16_t STATUS_OK = 0;
+    static const uint16_t STATUS_ERROR = 1;
+
+    static bool readHeader(int fd, InferenceMessageHeader& header);
+    static void readValues(int fd, uint32_t count, std::vector<double>& values);
+    static void skipValues(int fd, uint32_t count);
+    static std::string readText(int fd, uint32_t count);
+    static void writeValues(int fd, uint16_t type, const double* values, uint32_t count);
+    static void writeError(int fd, uint16_t type, const std::string& message);
+};
+
+#endif // INFERENCE_PROTOCOL_HPP
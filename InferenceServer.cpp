@@ -0,0 +1,301 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceServer.cpp
+//【功能模块和目的】本机推理服务的实现（仅Linux）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 批处理改由BatchingExecutor完成
+//【更改记录】2026年10月19日 只删除无人监听的旧套接字文件
+//【更改记录】2026年10月19日 定义CANN_TRACE时为连接线程命名并记录每个请求
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "InferenceServer.hpp"   // 推理服务类头文件
+#include "InferenceProtocol.hpp" // 推理协议头文件
+#include "Tracer.hpp"            // 时间线跟踪
+#include <cstring>               // strerror、strncpy
+#include <iostream>              // 输入输出流头文件
+#include <stdexcept>             // 标准异常头文件
+
+#ifdef __linux__
+#include <cerrno>                // errno
+#include <poll.h>                // poll
+#include <sys/socket.h>          // 套接字
+#include <sys/stat.h>            // lstat
+#include <sys/un.h>              // sockaddr_un
+#include <unistd.h>              // close、unlink
+#endif
+
+#ifdef __linux__
+namespace {
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】isStaleSocket
+//【函数功能】判断路径上是否为可以删除的旧套接字：必须是套接字文件，且试连接得到ECONNREFUSED（无人监听）。
+//           路径不存在时返回false且reason为空；是普通文件、正在被其他服务监听或无法判断时返回false并给出原因
+//【参数】path - 套接字路径（长度已检查），reason - 输出不能删除的原因
+//【返回值】bool - 是否为无人监听的旧套接字
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//【更改记录】2026年10月19日 每个请求的跟踪参数标明为type
+//-------------------------------------------------------------------------------------------------------------------
+bool isStaleSocket(const std::string& path, std::string& reason) {
+    reason.clear();
+    struct stat status;
+    if (lstat(path.c_str(), &status) < 0) {
+        if (errno != ENOENT) {
+            reason = std::strerror(errno);
+        }
+        return false;
+    }
+    if (!S_ISSOCK(status.st_mode)) {
+        reason = "the path exists and is not a socket";
+        return false;
+    }
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int probeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probeFd < 0) {
+        reason = std::strerror(errno);
+        return false;
+    }
+    int result = connect(probeFd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int error = errno;
+    close(probeFd);
+    if (result == 0) {
+        reason = "another server is listening on it";
+        return false;
+    }
+    if (error != ECONNREFUSED) {
+        reason = std::strerror(error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceServer::InferenceServer
+//【函数功能】构造函数，创建批处理执行器（由其检查网络和批处理参数）
+//【参数】model - 推理模型，socketPath - 套接字路径，options - 批处理参数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为创建BatchingExecutor
+//【更改记录】2026年10月19日 改为接收ModelHandle
+//-------------------------------------------------------------------------------------------------------------------
+InferenceServer::InferenceServer(const ModelHandle& model, const std::string& socketPath,
+                                 const BatchingOptions& options)
+    : model(model), socketPath(socketPath), executor(model, options), stopping(false) {
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceServer::~InferenceServer
+//【函数功能】析构函数。run返回前已回收全部连接线程，执行器在成员析构时停止
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+InferenceServer::~InferenceServer() = default;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceServer::stop / InferenceServer::getStats
+//【函数功能】请求停止；获取统计
+//【参数】无
+//【返回值】getStats返回ServerStats - 统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 请求数和批次数取自BatchingExecutor
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceServer::stop() {
+    stopping.store(true);
+}
+
+ServerStats InferenceServer::getStats() const {
+    BatchingStats batching = executor.getStats();
+    std::lock_guard<std::mutex> lock(mutex);
+    ServerStats result = stats;
+    result.requests = batching.requests;
+    result.batches = batching.batches;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceServer::run
+//【函数功能】创建并监听Unix域套接字，以100毫秒为周期检查停止请求，同时回收已结束的连接线程。
+//           路径上已有文件时，只有无人监听的旧套接字会被删除，其他情况（普通文件、正在运行的服务）抛出异常。
+//           停止时关闭监听套接字，对所有连接执行shutdown使连接线程退出，再以同样的检查删除套接字文件
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 批处理线程改由BatchingExecutor管理
+//【更改记录】2026年10月19日 删除前检查路径上是否为无人监听的旧套接字
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceServer::run() {
+#ifdef __linux__
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Invalid socket path: " << socketPath << "\n";
+        throw std::invalid_argument("Invalid socket path: " + socketPath);
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    std::string reason;
+    if (isStaleSocket(socketPath, reason)) {
+        unlink(socketPath.c_str());
+    } else if (!reason.empty()) {
+        std::cerr << "Error: Cannot use socket path " << socketPath << ": " << reason << "\n";
+        throw std::runtime_error("Cannot use socket path " + socketPath + ": " + reason);
+    }
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error: Failed to create socket: " << std::strerror(errno) << "\n";
+        throw std::runtime_error("Failed to create socket");
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, 128) < 0) {
+        std::string reason = std::strerror(errno);
+        close(listenFd);
+        std::cerr << "Error: Failed to listen on " << socketPath << ": " << reason << "\n";
+        throw std::runtime_error("Failed to listen on " + socketPath + ": " + reason);
+    }
+
+    std::list<std::thread> connections;
+    while (!stopping.load()) {
+        joinFinishedConnections(connections);
+        pollfd descriptor = { listenFd, POLLIN, 0 };
+        int ready = poll(&descriptor, 1, 100);
+        if (ready <= 0) {
+            continue;
+        }
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            clientFds.insert(clientFd);
+            ++stats.connections;
+        }
+        connections.emplace_back(&InferenceServer::serveConnection, this, clientFd);
+    }
+
+    close(listenFd);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int clientFd : clientFds) {
+            shutdown(clientFd, SHUT_RDWR);
+        }
+    }
+    for (auto& connection : connections) {
+        connection.join();
+    }
+    if (isStaleSocket(socketPath, reason)) {// 运行期间路径可能已被替换，只删除仍是旧套接字的文件
+        unlink(socketPath.c_str());
+    }
+#else
+    std::cerr << "Error: The inference server is only supported on Linux.\n";
+    throw std::runtime_error("The inference server is only supported on Linux.");
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceServer::serveConnection
+//【函数功能】连接线程：登记为执行器的提交者后循环读取请求。INFO立即应答；INFER提交给执行器，
+//           等待结果后应答，输入宽度不符等错误以错误响应返回。载荷长度在读取载荷之前按模型检查：
+//           INFER须等于模型输入宽度，INFO须为0，不符或类型未知时用skipValues丢弃载荷后返回错误响应，
+//           不按客户端给出的长度分配内存。对端关闭、协议错误或服务停止时关闭连接
+//【参数】clientFd - 连接套接字
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为提交给BatchingExecutor
+//【更改记录】2026年10月19日 INFO应答模型当前版本的形状
+//【更改记录】2026年10月19日 定义CANN_TRACE时在时间线上命名为connection-套接字号，记录每个请求
+//【更改记录】2026年10月19日 读取载荷前检查长度，不符时丢弃载荷
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceServer::serveConnection(int clientFd) {
+#ifdef __linux__
+#ifdef CANN_TRACE
+    Tracer::setThreadName("connection-" + std::to_string(clientFd));
+#endif
+    executor.addSubmitter();
+    try {
+        InferenceMessageHeader header;
+        std::vector<double> input;
+        while (!stopping.load() && InferenceProtocol::readHeader(clientFd, header)) {
+            CANN_TRACE_SCOPE_ARG("server", "InferenceServer::request", "type", static_cast<long long>(header.type));
+            if (header.type == InferenceProtocol::TYPE_INFO && header.count == 0) {
+                ModelSnapshot snapshot = model.acquire();
+                const double shape[] = { static_cast<double>(snapshot->getInputSize()),
+                                         static_cast<double>(snapshot->getOutputSize()) };
+                InferenceProtocol::writeValues(clientFd, header.type, shape, 2);
+                continue;
+            }
+            std::string error;
+            if (header.type == InferenceProtocol::TYPE_INFER) {
+                const int inputSize = model.acquire()->getInputSize();
+                if (header.count == static_cast<uint32_t>(inputSize)) {
+                    InferenceProtocol::readValues(clientFd, header.count, input);
+                    try {
+                        std::vector<double> output = executor.submit(std::move(input)).get();
+                        InferenceProtocol::writeValues(clientFd, header.type, output.data(),
+                                                       static_cast<uint32_t>(output.size()));
+                        continue;
+                    } catch (const std::logic_error& exception) {// 检查后模型被热替换，输入宽度不再相符
+                        error = exception.what();
+                    } catch (const std::runtime_error& exception) {// 推理失败
+                        error = exception.what();
+                    }
+                } else {
+                    InferenceProtocol::skipValues(clientFd, header.count);
+                    error = "Input size " + std::to_string(header.count) + " does not match the model input size "
+                          + std::to_string(inputSize);
+                }
+            } else {
+                InferenceProtocol::skipValues(clientFd, header.count);
+                error = header.type == InferenceProtocol::TYPE_INFO ? "INFO request must not carry a payload"
+                                                                    : "Unknown request type " + std::to_string(header.type);
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++stats.errors;
+            }
+            InferenceProtocol::writeError(clientFd, header.type, error);
+        }
+    } catch (const std::exception&) {
+        // 对端异常关闭或协议错误：直接关闭连接
+    }
+    executor.removeSubmitter();
+    std::lock_guard<std::mutex> lock(mutex);
+    clientFds.erase(clientFd);
+    close(clientFd);
+    finishedConnections.push_back(std::this_thread::get_id());
+#else
+    (void)clientFd;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】InferenceServer::joinFinishedConnections
+//【函数功能】回收已结束的连接线程，避免长时间运行时线程对象不断累积
+//【参数】connections - 接收线程持有的全部连接线程
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void InferenceServer::joinFinishedConnections(std::list<std::thread>& connections) {
+    std::vector<std::thread::id> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.swap(finishedConnections);
+    }
+    for (std::thread::id id : finished) {
+        for (auto it = connections.begin(); it != connections.end(); ++it) {
+            if (it->get_id() == id) {
+                it->join();
+                connections.erase(it);
+                break;
+            }
+        }
+    }
+}
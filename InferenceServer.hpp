@@ -0,0 +1,76 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】InferenceServer.hpp
+//【功能模块和目的】本机推理服务（仅Linux）：加载一次模型，经Unix域套接字以InferenceProtocol接收单样本请求，
+//                  把并发到达的请求合并为小批量后调用CompiledNetwork::forwardBatch，
+//                  使同一主机上的多个客户端进程共享一个已加载的模型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 批处理改由BatchingExecutor完成，ServerOptions改为BatchingOptions
+//【更改记录】2026年10月19日 模型改由ModelHandle提供，服务期间可热替换
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef INFERENCE_SERVER_HPP
+#define INFERENCE_SERVER_HPP
+
+#include "BatchingExecutor.hpp" // 批处理执行器类头文件
+#include "ModelHandle.hpp"     // 模型句柄类头文件
+#include <atomic>              // 原子变量
+#include <list>                // 链表
+#include <mutex>               // 互斥锁
+#include <set>                 // 集合
+#include <string>              // 字符串所属头文件
+#include <thread>              // 线程
+#include <vector>              // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ServerStats
+//【功能】推理服务的累计统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ServerStats {
+    long long connections = 0; // 累计连接数
+    long long requests = 0;    // 已完成的推理请求数
+    long long batches = 0;     // 已执行的批次数
+    long long errors = 0;      // 错误响应数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】InferenceServer
+//【功能】Unix域套接字推理服务。一个接收线程接受连接，每个连接一个线程读取请求，提交给BatchingExecutor
+//        并等待结果。每个连接登记为执行器的一个提交者，所有连接都有请求排队时立即执行。每个连接上的请求按顺序应答
+//【接口说明】
+//  - InferenceServer(const ModelHandle& model, const std::string& socketPath, const BatchingOptions& options):
+//    构造函数，model须在服务期间有效；服务期间通过model发布的新版本对之后的请求生效
+//  - void run(): 绑定套接字并服务，直到stop被调用后返回
+//  - void stop(): 请求停止，只写一个原子变量，可在信号处理函数中调用
+//  - ServerStats getStats() const: 获取统计
+//  - ~InferenceServer(): 析构函数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 批处理改由BatchingExecutor完成
+//【更改记录】2026年10月19日 改为从ModelHandle取得模型
+//-------------------------------------------------------------------------------------------------------------------
+class InferenceServer {
+public:
+    InferenceServer(const ModelHandle& model, const std::string& socketPath,
+                    const BatchingOptions& options = BatchingOptions());
+    InferenceServer(const InferenceServer&) = delete;
+    InferenceServer& operator=(const InferenceServer&) = delete;
+    void run();
+    void stop();
+    ServerStats getStats() const;
+    ~InferenceServer();
+
+private:
+    void serveConnection(int clientFd);           // 处理一个连接上的全部请求
+    void joinFinishedConnections(std::list<std::thread>& connections); // 回收已结束的连接线程
+    const ModelHandle& model;                     // 推理模型
+    std::string socketPath;                       // 套接字路径
+    BatchingExecutor executor;                    // 批处理执行器
+    std::atomic<bool> stopping;                   // 是否已请求停止
+    mutable std::mutex mutex;                     // 保护以下成员
+    std::set<int> clientFds;                      // 打开的连接
+    std::vector<std::thread::id> finishedConnections; // 已结束、尚未回收的连接线程
+    ServerStats stats;                            // 连接数和错误数
+};
+
+#endif // INFERENCE_SERVER_HPP
@@ -3,11 +3,22 @@
 //【功能模块和目的】神经网络层类的实现，包含神经网络层的所有功能实现
 //【开发者及日期】李孟涵 2025年7月13日
 //【更改记录】2025年7月21日 新增移除所有连接的功能
+//【更改记录】2026年10月19日 修复第一层输入在多次前向传播间累加的问题
+//【更改记录】2026年10月19日 增加可修改的getNeuron重载
+//【更改记录】2026年10月19日 增加析构函数；修复增删神经元后的悬空突触指针和重复释放；层间断开改为线性时间
+//【更改记录】2026年10月19日 updateOutputs增加可编译关闭的分层计时
+//【更改记录】2026年10月19日 增加getNeuronCapacity
+//【更改记录】2026年10月19日 setInput原地写入输入，不再为每个神经元分配临时向量
+//【更改记录】2026年10月19日 增加逐个神经元指定激活函数类型的构造函数
+//【更改记录】2026年10月19日 增加indexOf
 //-------------------------------------------------------------------------------------------------------------------
 
 #include "Layer.hpp"      // 包含层类头文件
 #include "Network.hpp"
+#include "Profiler.hpp"   // 分层计时
 #include "Synapse.hpp"    // 包含突触类头文件
+#include <algorithm>      // 算法库
+#include <functional>     // std::less
 #include <iostream>       // 输入输出流头文件
 #include <vector>         // vector所在头文件
 #include <stdexcept>      // 标准异常头文件
@@ -33,16 +44,75 @@ Layer::Layer(Network* network, int neuronCount, std::vector<double> biases, int
     }
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::Layer
+//【函数功能】Layer类的构造函数，创建指定数量的神经元，每个神经元使用各自的激活函数类型
+//【参数】network - 所属网络，neuronCount - 神经元数量，biases - 偏置值向量，
+//       activationFunctionTypes - 各神经元的激活函数类型，不足的部分为线性（0）
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+Layer::Layer(Network* network, int neuronCount, std::vector<double> biases,
+             const std::vector<int>& activationFunctionTypes)
+    : Layer(network, 0)
+{
+    if (biases.size() < static_cast<size_t>(neuronCount)) {
+        biases.resize(neuronCount, 0.0); // 确保偏置向量有足够的元素, 如果不足默认设置为0.0
+    }
+    neurons.reserve(neuronCount);
+    for (int i = 0; i < neuronCount; ++i) {
+        int activationFunctionType = i < static_cast<int>(activationFunctionTypes.size()) ? activationFunctionTypes[i] : 0;
+        neurons.emplace_back(std::vector<Synapse*>(), biases[i], activationFunctionType, this);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::~Layer
+//【函数功能】Layer类的析构函数，断开并释放与前一层和后一层之间的全部突触
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 清除本层的计时计数
+//-------------------------------------------------------------------------------------------------------------------
+Layer::~Layer() {
+    CANN_PROFILE_FORGET(this);
+    disconnectFrom();
+    disconnect();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::relinkSynapses
+//【函数功能】神经元存放在vector中，扩容或删除元素后地址会改变。本函数让每个神经元的树突
+//        指向它本身（nxt）、轴突从它本身发出（pre），并更新神经元所属的层
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Layer::relinkSynapses() {
+    for (auto& neuron : neurons) {
+        neuron.layer = this;
+        for (auto* dendrite : neuron.Dendrites) {
+            dendrite->setNxt(&neuron);
+        }
+        for (auto* axon : neuron.Axon) {
+            axon->setPre(&neuron);
+        }
+    }
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Layer::addNeuron
 //【函数功能】向层中添加一个新的神经元，并建立必要的连接
 //【参数】neuron - 要添加的神经元对象
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 添加后重新链接突触，修复vector扩容导致的悬空指针
 //-------------------------------------------------------------------------------------------------------------------
 void Layer::addNeuron(const Neuron& neuron) {
     neurons.push_back(neuron);
+    relinkSynapses(); // 扩容后已有神经元的地址可能改变
     
     // 如果当前层不是第一层，需要与前一层的所有神经元建立连接
     if (previousLayer != nullptr) {
@@ -66,7 +136,7 @@ void Layer::addNeuron(const Neuron& neuron) {
 //【参数】index - 要删除的神经元索引
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 修复突触被重复释放的问题，删除后重新链接其余神经元的突触
 //-------------------------------------------------------------------------------------------------------------------
 void Layer::deleteNeuron(int index)
 {
@@ -75,52 +145,12 @@ void Layer::deleteNeuron(int index)
         throw std::out_of_range("Neuron index out of range");
     }
     
-    // 获取要删除的神经元的指针（在删除前保存）
-    Neuron* neuronToDelete = &neurons[index];
-    
-    // 清理所有指向该神经元的连接
-    // 遍历前一层的所有神经元，移除指向要删除神经元的连接
-    if (previousLayer != nullptr) {
-        for (auto& prevNeuron : previousLayer->neurons) {
-            // 清理轴突中指向该神经元的连接
-            for (auto it = prevNeuron.Axon.begin(); it != prevNeuron.Axon.end();) {
-                if ((*it)->getNxt() == neuronToDelete) {
-                    delete *it;
-                    it = prevNeuron.Axon.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-        }
-    }
-    
-    // 遍历后一层的所有神经元，移除来自该神经元的连接
-    if (nextLayer != nullptr) {
-        for (auto& nextNeuron : nextLayer->neurons) {
-            // 清理树突中来自该神经元的连接
-            for (auto it = nextNeuron.Dendrites.begin(); it != nextNeuron.Dendrites.end();) {
-                if ((*it)->getPre() == neuronToDelete) {
-                    delete *it;
-                    it = nextNeuron.Dendrites.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-        }
-    }
+    // 从相邻层神经元中移除并释放该神经元的所有突触（每个突触只释放一次）
+    neurons[index].remove();
     
-    // 清理该神经元自身的连接
-    for (auto* synapse : neurons[index].Axon) {
-        delete synapse;
-    }
-    for (auto* synapse : neurons[index].Dendrites) {
-        delete synapse;
-    }
-    neurons[index].Axon.clear();
-    neurons[index].Dendrites.clear();
-    
-    // 删除神经元
+    // 删除神经元，其后的神经元前移，需要更新指向它们的突触
     neurons.erase(neurons.begin() + index);
+    relinkSynapses();
 }
 //-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Layer::getNeurons
@@ -150,6 +180,22 @@ const Neuron& Layer::getNeuron(int index) const {
     return neurons[index];
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::getNeuron
+//【函数功能】获取指定索引的神经元（可修改）
+//【参数】index - 神经元的索引
+//【返回值】Neuron& - 指定索引的神经元
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+Neuron& Layer::getNeuron(int index) {
+    if (index < 0 || index >= static_cast<int>(neurons.size())) {// 检查神经元索引是否在范围内
+        std::cerr << "Error: Neuron index out of range.\n";
+        throw std::out_of_range("Neuron index out of range");
+    }
+    return neurons[index];
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Layer::setWeights
 //【函数功能】设置当前层神经元的权重
@@ -184,6 +230,53 @@ int Layer::getNeuronCount() const {
     return neurons.size();
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::getSynapseCount
+//【函数功能】获取当前层所有神经元的树突数量之和，即一次updateOutputs处理的突触数
+//【参数】无
+//【返回值】long long - 突触数量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+long long Layer::getSynapseCount() const {
+    long long count = 0;
+    for (const auto& neuron : neurons) {
+        count += static_cast<long long>(neuron.getDendrites().size());
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::getNeuronCapacity
+//【函数功能】获取神经元数组已分配的容量（元素个数），用于统计内存占用
+//【参数】无
+//【返回值】size_t - 容量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t Layer::getNeuronCapacity() const {
+    return neurons.capacity();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Layer::indexOf
+//【函数功能】获取神经元在本层中的下标。先以std::less判断指针是否落在本层的神经元数组内，
+//           只对本层内的指针做减法，空指针或指向其他数组的指针不参与指针运算
+//【参数】neuron - 神经元指针
+//【返回值】int - 下标，为空或不属于本层时返回-1
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int Layer::indexOf(const Neuron* neuron) const {
+    const Neuron* first = neurons.data();
+    const Neuron* last = first + neurons.size();
+    std::less<const Neuron*> before;
+    if (neuron == nullptr || before(neuron, first) || !before(neuron, last)) {
+        return -1;
+    }
+    return static_cast<int>(neuron - first);
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Layer::setBias
 //【函数功能】设置指定神经元的偏置值
@@ -206,7 +299,8 @@ void Layer::setBias(int neuronIndex, double newBias) {
 //【参数】input - 输入值向量
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 改为覆盖输入，修复多次前向传播时第一层输入不断累加的问题
+//【更改记录】2026年10月19日 原地写入，预热后不分配内存
 //-------------------------------------------------------------------------------------------------------------------
 void Layer::setInput(const std::vector<double>& input) {
     if (input.size() != neurons.size()) {// 检查输入大小是否与神经元数量匹配
@@ -218,7 +312,8 @@ void Layer::setInput(const std::vector<double>& input) {
         throw std::runtime_error("Cannot set input: Layer is not the first layer in the network");
     }
     for (size_t i = 0; i < neurons.size(); ++i) {
-        neurons[i].addInput(input[i]);
+        neurons[i].resizeInputs(1);
+        neurons[i].setInput(0, input[i]);
     }
 }
 
@@ -299,15 +394,24 @@ void Layer::setNextLayer(Layer* nextLayer) {
 //【参数】无
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 按层批量移除突触，复杂度由O(n·m·(n+m))降为O(n·m)
 //-------------------------------------------------------------------------------------------------------------------
 void Layer::disconnect()
 {
     if (this->nextLayer != nullptr) {
-        // 先断开神经元级别的连接
+        // 当前层的轴突全部连向下一层：先从下一层神经元的树突中一次性移除来自本层的突触，再释放
+        const Neuron* first = neurons.data();
+        const Neuron* last = first + neurons.size();
+        std::less<const Neuron*> before;
+        for (auto& nextNeuron : this->nextLayer->neurons) {
+            auto& dendrites = nextNeuron.Dendrites;
+            dendrites.erase(std::remove_if(dendrites.begin(), dendrites.end(), [&](const Synapse* synapse) {
+                return !before(synapse->getPre(), first) && before(synapse->getPre(), last);
+            }), dendrites.end());
+        }
         for (auto& neuron : neurons) {
-            for (auto& nextNeuron : this->nextLayer->getNeurons()) {
-                neuron.disconnectTo(const_cast<Neuron*>(&nextNeuron));
+            for (auto* synapse : neuron.Axon) {
+                delete synapse;
             }
             neuron.Axon.clear(); // 清除当前神经元的轴突连接
         }
@@ -322,15 +426,24 @@ void Layer::disconnect()
 // 【参数】无
 // 【返回值】无
 // 【开发者及日期】李孟涵 2025年7月13日
-// 【更改记录】无
+// 【更改记录】2026年10月19日 修复只清空树突列表而未释放突触、前一层轴突残留悬空指针的问题
 //-------------------------------------------------------------------------------------------------------------------
 void Layer::disconnectFrom()
 {
     if (this->previousLayer != nullptr) {
-        // 先断开神经元级别的连接
+        // 当前层的树突全部来自前一层：先从前一层神经元的轴突中一次性移除连向本层的突触，再释放
+        const Neuron* first = neurons.data();
+        const Neuron* last = first + neurons.size();
+        std::less<const Neuron*> before;
+        for (auto& prevNeuron : this->previousLayer->neurons) {
+            auto& axon = prevNeuron.Axon;
+            axon.erase(std::remove_if(axon.begin(), axon.end(), [&](const Synapse* synapse) {
+                return !before(synapse->getNxt(), first) && before(synapse->getNxt(), last);
+            }), axon.end());
+        }
         for (auto& neuron : neurons) {
-            for (auto& prevNeuron : this->previousLayer->getNeurons()) {
-                neuron.disconnectTo(const_cast<Neuron*>(&prevNeuron));
+            for (auto* synapse : neuron.Dendrites) {
+                delete synapse;
             }
             neuron.Dendrites.clear(); // 清除当前神经元的树突连接
         }
@@ -365,9 +478,10 @@ void Layer::connectTo(Layer* newNextLayer) {
 // 【参数】无
 // 【返回值】无
 // 【开发者及日期】李孟涵 2025年7月13日
-// 【更改记录】无
+// 【更改记录】2026年10月19日 定义CANN_PROFILE时记录本次耗时和处理的突触数
 //-------------------------------------------------------------------------------------------------------------------
 void Layer::updateOutputs() {
+    CANN_PROFILE_SCOPE(this, getSynapseCount());
     for (auto& neuron : neurons) {
         neuron.updateOutput();
     }
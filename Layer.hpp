@@ -2,7 +2,11 @@
 //【文件名】Layer.hpp
 //【功能模块和目的】神经网络层类的声明，定义了人工神经网络中一层神经元的组织和管理功能
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加可修改的getNeuron重载；增加析构函数，修复增删神经元后的悬空突触指针
+//【更改记录】2026年10月19日 增加getSynapseCount
+//【更改记录】2026年10月19日 增加getNeuronCapacity
+//【更改记录】2026年10月19日 增加逐个神经元指定激活函数类型的构造函数
+//【更改记录】2026年10月19日 增加indexOf
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef LAYER_HPP
@@ -16,12 +20,20 @@ class Network;
 // 【功能】管理神经网络中的一层神经元，提供层级连接、神经元管理、权重设置、信号传播等功能
 // 【接口说明】提供神经元添加、层连接管理、权重设置、输入输出处理等接口
 //   - Layer(Network* network, int neuronCount, std::vector<double> biases, int activationFunctionType): 构造函数
+//   - Layer(Network* network, int neuronCount, std::vector<double> biases, const std::vector<int>& activationFunctionTypes):
+//     构造函数，逐个神经元指定激活函数类型
+//   - Layer(const Layer&) = delete: 禁止拷贝，神经元之间的突触不能被两个层共享
+//   - ~Layer(): 析构函数，释放与相邻层之间的全部突触
 //   - void addNeuron(const Neuron& neuron): 向层中添加神经元
 //   - void deleteNeuron(int index): 删除指定索引的神经元
 //   - void printNeurons() const: 打印当前层的所有神经元信息
 //   - const std::vector<Neuron>& getNeurons() const: 获取神经元列表
 //   - const Neuron& getNeuron(int index) const: 获取指定索引的神经元
+//   - Neuron& getNeuron(int index): 获取指定索引的神经元（可修改）
 //   - int getNeuronCount() const: 获取神经元数量
+//   - long long getSynapseCount() const: 获取本层神经元的输入突触（树突）总数
+//   - size_t getNeuronCapacity() const: 获取神经元数组已分配的容量
+//   - int indexOf(const Neuron* neuron) const: 获取神经元在本层中的下标，为空或不属于本层时返回-1
 //   - int getIndex() const: 获取当前层的索引
 //   - void setBias(int neuronIndex, double newBias): 设置指定神经元的偏置值
 //   - bool isConnectedTo(const Layer& other) const: 判断与另一层是否连接
@@ -41,18 +53,33 @@ class Network;
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月21日 新增删除所有连接功能，便于network中deleteLayer实现
 // 【更改记录】2025年7月29日 删除索引变量，改为基于网络内位置的动态计算
+// 【更改记录】2026年10月19日 增加可修改的getNeuron重载
+// 【更改记录】2026年10月19日 增加析构函数并禁止拷贝；增删神经元后重新链接突触指针
+// 【更改记录】2026年10月19日 增加getSynapseCount；定义CANN_PROFILE时updateOutputs记录耗时
+// 【更改记录】2026年10月19日 增加getNeuronCapacity
+// 【更改记录】2026年10月19日 增加逐个神经元指定激活函数类型的构造函数
+// 【更改记录】2026年10月19日 增加indexOf
 //-------------------------------------------------------------------------------------------------------------------
 class Layer{
 public:
     Layer(Network* network, int neuronCount = 0,
           std::vector<double> biases = std::vector<double>(),
           int activationFunctionType = 0);               // 构造函数，创建指定数量的神经元并初始化层属性
+    Layer(Network* network, int neuronCount, std::vector<double> biases,
+          const std::vector<int>& activationFunctionTypes); // 构造函数，逐个神经元指定激活函数类型
+    Layer(const Layer&) = delete;                        // 禁止拷贝
+    Layer& operator=(const Layer&) = delete;             // 禁止拷贝赋值
+    ~Layer();                                            // 析构函数，释放与相邻层之间的突触
     void addNeuron(const Neuron& neuron);                // 向层中添加一个新的神经元，并建立必要的连接
     void deleteNeuron(int index);                        // 删除指定索引的神经元
     void printNeurons() const;                           // 打印当前层的所有神经元信息
     const std::vector<Neuron>& getNeurons() const;       // 获取当前层的神经元列表
     const Neuron& getNeuron(int index) const;            // 获取指定索引的神经元
+    Neuron& getNeuron(int index);                        // 获取指定索引的神经元（可修改）
     int getNeuronCount() const;                          // 获取当前层的神经元数量
+    long long getSynapseCount() const;                   // 获取当前层的输入突触总数
+    size_t getNeuronCapacity() const;                    // 获取神经元数组已分配的容量
+    int indexOf(const Neuron* neuron) const;             // 获取神经元在本层中的下标，不属于本层时为-1
     int getIndex() const;                                // 获取当前层的索引
     void setBias(int neuronIndex, double newBias);       // 设置指定神经元的偏置值
     bool isConnectedTo(const Layer& other) const;        // 判断当前层是否与另一层连接
@@ -70,6 +97,7 @@ public:
     void removeAllConnections();                        // 移除当前层所有神经元的连接
     std::vector<double> getOutputs() const;             // 获取当前层所有神经元的输出值
 private:
+    void relinkSynapses();                              // 神经元在vector中移动后，更新突触指向它们的指针
     Network* network;                                   // 所属网络的指针
     Layer* previousLayer;                                // 前一层的指针
     Layer* nextLayer;                                    // 下一层的指针
@@ -0,0 +1,47 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】LayerKernel.hpp
+//【功能模块和目的】紧凑推理网络的层计算函数。每种激活函数类型各实例化一组模板函数，激活计算在编译期确定并
+//                  内联进累加循环；编译网络时为每个激活函数段选定一次，推理时不再逐个神经元判断类型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef LAYER_KERNEL_HPP
+#define LAYER_KERNEL_HPP
+
+#include <cstddef> // size_t所属头文件
+
+struct CompiledLayer;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】LayerKernel
+//【功能】一个激活函数类型对应的层计算函数。各函数处理层执行顺序中[begin, end)位置上的神经元，
+//        调用方保证该区间位于同一激活函数段内
+//【接口说明】
+//  - evaluateInput(layer, begin, end, inputs, outputs): 输入层，outputs[i] = f(inputs[i] + b[i])，按神经元下标存放
+//  - evaluate(layer, begin, end, previous, outputs): 单样本稀疏矩阵-向量乘并激活，previous、outputs按神经元下标存放
+//  - evaluateBatch(layer, previousPositions, batchSize, begin, end, source, target): 批量稀疏矩阵-矩阵乘（不含激活），
+//    source、target按执行顺序存放“神经元 × 样本”，前一层神经元j的行位于previousPositions[j]；各类型共用同一函数
+//  - activate(values, count): 对连续数组原地激活
+//  - static LayerKernel select(int activationType): 选定激活函数类型对应的一组函数，未知类型按线性处理
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct LayerKernel {
+    typedef void (*InputFunction)(const CompiledLayer& layer, size_t begin, size_t end, const double* inputs,
+                                  double* outputs);
+    typedef void (*RowFunction)(const CompiledLayer& layer, size_t begin, size_t end, const double* previous,
+                                double* outputs);
+    typedef void (*BatchFunction)(const CompiledLayer& layer, const int* previousPositions, size_t batchSize,
+                                  size_t begin, size_t end, const double* source, double* target);
+    typedef void (*ActivateFunction)(double* values, size_t count);
+
+    InputFunction evaluateInput = nullptr;   // 输入层
+    RowFunction evaluate = nullptr;          // 单样本
+    BatchFunction evaluateBatch = nullptr;   // 批量
+    ActivateFunction activate = nullptr;     // 整段激活
+
+    static LayerKernel select(int activationType);
+};
+
+#endif // LAYER_KERNEL_HPP
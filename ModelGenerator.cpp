@@ -0,0 +1,249 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ModelGenerator.cpp
+//【功能模块和目的】合成模型生成器类的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "ModelGenerator.hpp" // 合成模型生成器类头文件
+#include <algorithm>          // std::min
+#include <climits>            // INT_MAX
+#include <cmath>              // 数学函数库
+#include <fstream>            // 文件流头文件
+#include <stdexcept>          // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::validate
+//【函数功能】检查模型描述是否合法
+//【参数】spec - 模型描述
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void ModelGenerator::validate(const ModelSpec& spec) {
+    if (spec.widths.empty()) {
+        throw std::invalid_argument("Model needs at least one layer.");
+    }
+    long long neuronCount = 0;
+    for (int width : spec.widths) {
+        if (width <= 0) {
+            throw std::invalid_argument("Layer widths must be positive.");
+        }
+        neuronCount += width;
+    }
+    if (neuronCount > INT_MAX) {// ANN文件中神经元下标为int
+        throw std::invalid_argument("Model has too many neurons.");
+    }
+    if (spec.activationMix.empty() || spec.activationMix.size() > 4) {
+        throw std::invalid_argument("Activation mix needs 1 to 4 weights (linear, sigmoid, tanh, relu).");
+    }
+    double total = 0.0;
+    for (double weight : spec.activationMix) {
+        if (weight < 0.0) {
+            throw std::invalid_argument("Activation mix weights must not be negative.");
+        }
+        total += weight;
+    }
+    if (total <= 0.0) {
+        throw std::invalid_argument("Activation mix must contain a positive weight.");
+    }
+    if (spec.sparsity < 0.0 || spec.sparsity >= 1.0) {
+        throw std::invalid_argument("Sparsity must be in [0, 1).");
+    }
+    if (spec.weightDistribution != "uniform" && spec.weightDistribution != "normal") {
+        throw std::invalid_argument("Weight distribution must be uniform or normal.");
+    }
+    if (spec.weightScale < 0.0 || spec.biasScale < 0.0) {
+        throw std::invalid_argument("Weight and bias scales must not be negative.");
+    }
+    if (spec.precision < 1 || spec.precision > 17) {
+        throw std::invalid_argument("Precision must be between 1 and 17.");
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::generate
+//【函数功能】生成模型并写入构造时指定的文件，写文件时使用1MB缓冲区
+//【参数】spec - 模型描述
+//【返回值】ModelGenerationReport - 生成结果的统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelGenerationReport ModelGenerator::generate(const ModelSpec& spec) {
+    validate(spec);
+    std::vector<char> buffer(1 << 20);
+    std::ofstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create file: " + filename);
+    }
+    file << "# " << filename << "\n";
+    ModelGenerationReport report = generate(spec, file);
+    report.bytes = static_cast<long long>(file.tellp()); // 包含文件头注释
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+    return report;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::generate
+//【函数功能】生成模型并写入流。激活函数、偏置、突触位置和权重各用一个独立的随机数序列，
+//           因此改变稀疏度不会改变偏置，writePrunedAsZero也不会改变保留突触的权重
+//【参数】spec - 模型描述，stream - 输出流
+//【返回值】ModelGenerationReport - 生成结果的统计（流不支持定位时bytes为0）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelGenerationReport ModelGenerator::generate(const ModelSpec& spec, std::ostream& stream) {
+    validate(spec);
+    const uint64_t golden = 0x9E3779B97F4A7C15ULL;
+    std::mt19937_64 activationRandom(spec.seed);
+    std::mt19937_64 biasRandom(spec.seed + golden);
+    std::mt19937_64 maskRandom(spec.seed + 2 * golden);
+    std::mt19937_64 weightRandom(spec.seed + 3 * golden);
+
+    ModelGenerationReport report;
+    std::streampos start = stream.tellp();
+    stream.precision(spec.precision);
+
+    stream << "# synthetic model: seed " << spec.seed << ", sparsity " << spec.sparsity
+           << ", weights " << spec.weightDistribution << "\n";
+    stream << "G " << spec.name << "\n";
+
+    // 神经元：第0层为线性、零偏置的输入层
+    stream << "# Neurons\n";
+    for (size_t l = 0; l < spec.widths.size(); ++l) {
+        int layerActivation = l == 0 ? 0 : pickActivation(spec, activationRandom);
+        for (int i = 0; i < spec.widths[l]; ++i) {
+            double bias = l == 0 ? 0.0 : (2.0 * uniform(biasRandom) - 1.0) * spec.biasScale;
+            int activation = l == 0 || !spec.mixPerNeuron ? layerActivation : pickActivation(spec, activationRandom);
+            stream << "N " << bias << " " << activation << "\n";
+        }
+        report.neuronCount += spec.widths[l];
+    }
+
+    std::vector<int> layerStarts;
+    stream << "# Layers\n";
+    int neuronIndex = 0;
+    for (int width : spec.widths) {
+        layerStarts.push_back(neuronIndex);
+        stream << "L " << neuronIndex << " " << (neuronIndex + width - 1) << "\n";
+        neuronIndex += width;
+    }
+
+    stream << "# Synapses\n";
+    for (int i = 0; i < spec.widths.front(); ++i) {
+        stream << "S -1 " << i << " 1.0\n";
+    }
+    if (spec.widths.size() > 1) {
+        for (int i = 0; i < spec.widths.back(); ++i) {
+            stream << "S " << (layerStarts.back() + i) << " -1 1.0\n";
+        }
+    }
+
+    // 层间突触：逐行生成，按几何分布跳过被省略的突触，耗时与写出的突触数成正比
+    const double keepProbability = 1.0 - spec.sparsity;
+    const bool normalWeights = spec.weightDistribution == "normal";
+    for (size_t l = 1; l < spec.widths.size(); ++l) {
+        const int previousWidth = spec.widths[l - 1];
+        const double scale = spec.scaleByFanIn ? spec.weightScale / std::sqrt(static_cast<double>(previousWidth))
+                                               : spec.weightScale;
+        report.denseSynapseCount += static_cast<long long>(previousWidth) * spec.widths[l];
+        for (int i = 0; i < spec.widths[l]; ++i) {
+            const int target = layerStarts[l] + i;
+            long long next = skipCount(keepProbability, maskRandom);
+            int j = spec.writePrunedAsZero ? 0 : static_cast<int>(std::min<long long>(next, previousWidth));
+            while (j < previousWidth) {
+                if (j == next) {
+                    double weight = normalWeights ? normal(weightRandom) * scale
+                                                  : (2.0 * uniform(weightRandom) - 1.0) * scale;
+                    stream << "S " << (layerStarts[l - 1] + j) << " " << target << " " << weight << "\n";
+                    ++report.synapseCount;
+                    next = j + 1 + skipCount(keepProbability, maskRandom);
+                } else {
+                    stream << "S " << (layerStarts[l - 1] + j) << " " << target << " 0\n";
+                }
+                j = spec.writePrunedAsZero ? j + 1 : static_cast<int>(std::min<long long>(next, previousWidth));
+            }
+        }
+    }
+
+    std::streampos end = stream.tellp();
+    if (start != std::streampos(-1) && end != std::streampos(-1)) {
+        report.bytes = static_cast<long long>(end - start);
+    }
+    return report;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::uniform
+//【函数功能】由随机数引擎的高53位得到[0, 1)上的均匀分布
+//【参数】random - 随机数引擎
+//【返回值】double - 随机数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ModelGenerator::uniform(std::mt19937_64& random) {
+    return static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::normal
+//【函数功能】用Box-Muller变换得到标准正态分布
+//【参数】random - 随机数引擎
+//【返回值】double - 随机数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double ModelGenerator::normal(std::mt19937_64& random) {
+    const double pi = 3.14159265358979323846;
+    double radius = std::sqrt(-2.0 * std::log(1.0 - uniform(random)));
+    return radius * std::cos(2.0 * pi * uniform(random));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::pickActivation
+//【函数功能】按activationMix中的权重随机选取激活函数类型
+//【参数】spec - 模型描述，random - 随机数引擎
+//【返回值】int - 激活函数类型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int ModelGenerator::pickActivation(const ModelSpec& spec, std::mt19937_64& random) {
+    double total = 0.0;
+    for (double weight : spec.activationMix) {
+        total += weight;
+    }
+    double point = uniform(random) * total;
+    int last = 0;
+    for (size_t type = 0; type < spec.activationMix.size(); ++type) {
+        if (spec.activationMix[type] <= 0.0) {
+            continue;
+        }
+        last = static_cast<int>(type);
+        if (point < spec.activationMix[type]) {
+            return last;
+        }
+        point -= spec.activationMix[type];
+    }
+    return last; // 舍入误差时返回最后一个权重为正的类型
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelGenerator::skipCount
+//【函数功能】每个突触独立地以keepProbability保留时，下一个保留突触之前被省略的突触数服从几何分布
+//【参数】keepProbability - 保留概率，random - 随机数引擎
+//【返回值】long long - 被省略的突触数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+long long ModelGenerator::skipCount(double keepProbability, std::mt19937_64& random) {
+    if (keepProbability >= 1.0) {
+        return 0;
+    }
+    double skip = std::floor(std::log(1.0 - uniform(random)) / std::log(1.0 - keepProbability));
+    return skip > static_cast<double>(INT_MAX) ? INT_MAX : static_cast<long long>(skip);
+}
@@ -0,0 +1,84 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ModelGenerator.hpp
+//【功能模块和目的】合成模型生成器类的声明，按层宽、激活函数比例、稀疏度和带种子的权重分布
+//                  直接向磁盘流式写出ANN文件，不在内存中构建Network，用于生成大规模测试模型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef MODEL_GENERATOR_HPP
+#define MODEL_GENERATOR_HPP
+
+#include "FilePorter.hpp" // 文件操作基类头文件
+#include <cstdint>        // 定长整数类型
+#include <ostream>        // 输出流
+#include <random>         // 随机数引擎
+#include <string>         // 字符串所属头文件
+#include <vector>         // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ModelSpec
+//【功能】合成模型的描述。第0层为输入层，固定为线性激活、零偏置；其余层的激活函数按activationMix
+//        中各类型（0线性、1Sigmoid、2tanh、3ReLU）的权重随机选取，mixPerNeuron为false时整层相同。
+//        相邻层之间每个突触以 1 - sparsity 的概率保留；权重服从"uniform"（[-s, s]）或"normal"（标准差s）
+//        分布，scaleByFanIn为true时 s = weightScale / sqrt(前一层宽度)。同一描述总是生成完全相同的文件
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ModelSpec {
+    std::string name = "SyntheticNetwork";            // 网络名称
+    std::vector<int> widths;                          // 每层神经元数量
+    std::vector<double> activationMix = { 0, 1, 0, 0 }; // 各激活函数类型的权重
+    bool mixPerNeuron = false;                        // 按神经元（而非按层）选取激活函数
+    double sparsity = 0.0;                            // 被省略的突触比例，取值[0, 1)
+    bool writePrunedAsZero = false;                   // 被省略的突触写为权重0，使import()与importCompiled()结果一致
+    std::string weightDistribution = "uniform";       // 权重分布："uniform"或"normal"
+    double weightScale = 1.0;                         // 权重尺度
+    bool scaleByFanIn = true;                         // 权重尺度是否除以sqrt(扇入)
+    double biasScale = 0.1;                           // 偏置服从[-biasScale, biasScale]均匀分布
+    uint64_t seed = 20261019;                         // 随机种子
+    int precision = 6;                                // 数值输出的有效数字位数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ModelGenerationReport
+//【功能】生成结果的统计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ModelGenerationReport {
+    long long neuronCount = 0;       // 神经元数量
+    long long synapseCount = 0;      // 写出的层间突触数量（不含权重为0的填充）
+    long long denseSynapseCount = 0; // 全连接时的层间突触数量
+    long long bytes = 0;             // 文件字节数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ModelGenerator
+//【功能】把ModelSpec描述的模型逐行写入ANN文件。神经元、层、突触按文件格式要求的顺序依次生成，
+//        内存占用只与最宽一层有关，与突触总数无关。生成的文件可由ANNImporter::import或importCompiled导入
+//        随机数只使用mt19937_64的原始输出并自行换算为分布，不依赖标准库分布的实现，保证跨平台结果一致
+//【接口说明】继承自FilePorter，目前只支持ANN格式
+//  - explicit ModelGenerator(const std::string& filename): 构造函数，初始化文件名并验证文件类型
+//  - ModelGenerationReport generate(const ModelSpec& spec): 生成模型并写入文件
+//  - static ModelGenerationReport generate(const ModelSpec& spec, std::ostream& stream): 生成模型并写入流
+//  - static void validate(const ModelSpec& spec): 检查模型描述，不合法时抛出std::invalid_argument
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class ModelGenerator : public FilePorter<FilePorterType::EXPORTER> {
+public:
+    explicit ModelGenerator(const std::string& filename)
+        : FilePorter<FilePorterType::EXPORTER>(filename, { "ANN" }) {}
+    ModelGenerationReport generate(const ModelSpec& spec);                                 // 生成到文件
+    static ModelGenerationReport generate(const ModelSpec& spec, std::ostream& stream);   // 生成到流
+    static void validate(const ModelSpec& spec);                                          // 检查模型描述
+
+private:
+    static double uniform(std::mt19937_64& random);                                       // [0, 1)均匀分布
+    static double normal(std::mt19937_64& random);                                        // 标准正态分布
+    static int pickActivation(const ModelSpec& spec, std::mt19937_64& random);            // 按比例选取激活函数
+    static long long skipCount(double keepProbability, std::mt19937_64& random);          // 两个保留突触之间跳过的数量
+};
+
+#endif // MODEL_GENERATOR_HPP
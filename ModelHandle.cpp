@@ -0,0 +1,228 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ModelHandle.cpp
+//【功能模块和目的】模型热替换的实现。读者：占用记录→登记当前版本→重读确认未被替换；
+//                  写者：交换当前版本→把旧版本放入待回收列表→跳过仍被某条记录登记的版本，其余释放
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "ModelHandle.hpp" // 模型句柄类头文件
+#include <algorithm>       // std::find
+#include <cstdint>         // uintptr_t
+#include <new>             // placement new
+#include <utility>         // std::move
+
+namespace {
+
+const size_t CACHE_LINE_BYTES = 64; // 缓存行大小
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelSnapshot::ModelSnapshot
+//【函数功能】构造函数（由ModelHandle::acquire调用）、移动构造函数
+//【参数】record - 占用的记录，version - 受保护的版本；other - 被移动的快照
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelSnapshot::ModelSnapshot(Record* record, const Version* version) : record(record), version(version) {
+}
+
+ModelSnapshot::ModelSnapshot(ModelSnapshot&& other) noexcept : record(other.record), version(other.version) {
+    other.record = nullptr;
+    other.version = nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelSnapshot::~ModelSnapshot
+//【函数功能】析构函数，清除登记并归还记录。版本若已被替换，由下一次publish或reclaim回收
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelSnapshot::~ModelSnapshot() {
+    if (record != nullptr) {
+        record->hazard.store(nullptr, std::memory_order_release);
+        record->active.store(false, std::memory_order_release);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelSnapshot::operator* / ModelSnapshot::operator-> / ModelSnapshot::getVersion
+//【函数功能】访问受保护的模型及其版本号
+//【参数】无
+//【返回值】模型的引用或指针；版本号
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+const CompiledNetwork& ModelSnapshot::operator*() const {
+    return version->network;
+}
+
+const CompiledNetwork* ModelSnapshot::operator->() const {
+    return &version->network;
+}
+
+long long ModelSnapshot::getVersion() const {
+    return version->number;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::ModelHandle
+//【函数功能】构造函数，发布版本1
+//【参数】network - 初始模型
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelHandle::ModelHandle(CompiledNetwork network)
+    : current(new Version{ std::move(network), 1 }), versionNumber(1), records(nullptr) {
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::~ModelHandle
+//【函数功能】析构函数，释放当前版本、待回收版本和全部记录
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelHandle::~ModelHandle() {
+    delete current.load();
+    for (const Version* version : retired) {
+        delete version;
+    }
+    Record* record = records.load();
+    while (record != nullptr) {
+        Record* next = record->next;
+        char* storage = record->storage;
+        record->~Record();
+        delete[] storage;
+        record = next;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::acquireRecord
+//【函数功能】用CAS占用链表中的一条空闲记录；全部被占用时新建一条，按缓存行对齐后用CAS插入表头。
+//           只在并发读者数创新高时分配内存
+//【参数】无
+//【返回值】Record* - 已占用的记录
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelHandle::Record* ModelHandle::acquireRecord() const {
+    for (Record* record = records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+        bool expected = false;
+        if (!record->active.load(std::memory_order_relaxed)
+            && record->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+    static_assert(sizeof(Record) <= CACHE_LINE_BYTES, "Record must fit in one cache line");
+    char* storage = new char[2 * CACHE_LINE_BYTES];
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage);
+    address = (address + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+    Record* record = new (reinterpret_cast<void*>(address)) Record;
+    record->hazard.store(nullptr, std::memory_order_relaxed);
+    record->active.store(true, std::memory_order_relaxed);
+    record->storage = storage;
+    record->next = records.load(std::memory_order_relaxed);
+    while (!records.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    }
+    return record;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::acquire
+//【函数功能】取得当前版本：登记后重读current，两次相同说明登记发生在该版本被替换之前，
+//           写者回收时必然能看到这次登记（登记与重读、交换与扫描均为顺序一致的原子操作）
+//【参数】无
+//【返回值】ModelSnapshot - 受保护的当前版本
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ModelSnapshot ModelHandle::acquire() const {
+    Record* record = acquireRecord();
+    const Version* version = current.load(std::memory_order_acquire);
+    while (true) {
+        record->hazard.store(version, std::memory_order_seq_cst);
+        const Version* check = current.load(std::memory_order_seq_cst);
+        if (check == version) {
+            break;
+        }
+        version = check;
+    }
+    return ModelSnapshot(record, version);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::publish
+//【函数功能】发布新版本。新版本完全构造好之后才交换指针，读者不会看到构造一半的模型；
+//           旧版本放入待回收列表，随即回收一次
+//【参数】network - 新模型
+//【返回值】long long - 新版本号
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+long long ModelHandle::publish(CompiledNetwork network) {
+    Version* version = new Version{ std::move(network), 0 };
+    std::lock_guard<std::mutex> lock(retireMutex);
+    version->number = versionNumber.load(std::memory_order_relaxed) + 1;
+    const Version* old = current.exchange(version, std::memory_order_seq_cst);
+    versionNumber.store(version->number, std::memory_order_release);
+    retired.push_back(old);
+    reclaimLocked();
+    return version->number;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::reclaim
+//【函数功能】回收不再受任何快照保护的旧版本。旧版本最后的读者释放后，可由发布方周期性调用以尽早释放内存
+//【参数】无
+//【返回值】size_t - 仍在等待回收的版本数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t ModelHandle::reclaim() {
+    std::lock_guard<std::mutex> lock(retireMutex);
+    return reclaimLocked();
+}
+
+size_t ModelHandle::reclaimLocked() {
+    if (retired.empty()) {
+        return 0;
+    }
+    std::vector<const Version*> protectedVersions;
+    for (Record* record = records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+        const Version* hazard = record->hazard.load(std::memory_order_seq_cst);
+        if (hazard != nullptr) {
+            protectedVersions.push_back(hazard);
+        }
+    }
+    size_t kept = 0;
+    for (const Version* version : retired) {
+        if (std::find(protectedVersions.begin(), protectedVersions.end(), version) != protectedVersions.end()) {
+            retired[kept++] = version;
+        } else {
+            delete version;
+        }
+    }
+    retired.resize(kept);
+    return kept;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ModelHandle::getVersion
+//【函数功能】获取当前版本号
+//【参数】无
+//【返回值】long long - 版本号
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+long long ModelHandle::getVersion() const {
+    return versionNumber.load(std::memory_order_acquire);
+}
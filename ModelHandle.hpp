@@ -0,0 +1,113 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ModelHandle.hpp
+//【功能模块和目的】服务中模型的热替换：以原子指针发布不可变的CompiledNetwork新版本，读者不加锁地取得当前版本，
+//                  旧版本用风险指针（hazard pointer）保护，最后一个读者释放后才回收。
+//                  正在进行的推理在旧版本上完成，之后的推理使用新版本
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef MODEL_HANDLE_HPP
+#define MODEL_HANDLE_HPP
+
+#include "CompiledNetwork.hpp" // 紧凑推理网络类头文件
+#include <atomic>              // 原子变量
+#include <cstddef>             // size_t所属头文件
+#include <mutex>               // 互斥锁
+#include <vector>              // vector所属头文件
+
+class ModelHandle;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ModelSnapshot
+//【功能】读者持有的一个模型版本。存在期间该版本不会被回收，即使已有更新的版本发布；只能移动不能复制，
+//        须在ModelHandle析构之前销毁
+//【接口说明】
+//  - const CompiledNetwork& operator*() const / const CompiledNetwork* operator->() const: 访问模型
+//  - long long getVersion() const: 版本号，从1开始，每次发布加1
+//  - ~ModelSnapshot(): 析构函数，撤销保护
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class ModelSnapshot {
+public:
+    ModelSnapshot(ModelSnapshot&& other) noexcept;
+    ModelSnapshot(const ModelSnapshot&) = delete;
+    ModelSnapshot& operator=(const ModelSnapshot&) = delete;
+    ModelSnapshot& operator=(ModelSnapshot&&) = delete;
+    const CompiledNetwork& operator*() const;
+    const CompiledNetwork* operator->() const;
+    long long getVersion() const;
+    ~ModelSnapshot();
+
+private:
+    friend class ModelHandle;
+    struct Record;
+    struct Version;
+    ModelSnapshot(Record* record, const Version* version);
+    Record* record;         // 占用的风险指针记录
+    const Version* version; // 受保护的版本
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ModelSnapshot::Version
+//【功能】一个已发布的模型版本，发布后不再修改
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ModelSnapshot::Version {
+    CompiledNetwork network; // 模型
+    long long number;        // 版本号
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ModelSnapshot::Record
+//【功能】一条风险指针记录。读者用CAS占用一条空闲记录，在其中登记正在使用的版本；记录只增不删，
+//        数量等于历史上同时持有快照的最大读者数。每条记录独占一个64字节缓存行，读者之间互不干扰
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ModelSnapshot::Record {
+    std::atomic<const Version*> hazard; // 受保护的版本，未使用时为空
+    std::atomic<bool> active;           // 是否被某个快照占用
+    Record* next;                       // 链表中的下一条记录，加入链表后不再改变
+    char* storage;                      // 为对齐而多分配的原始内存
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ModelHandle
+//【功能】模型版本的发布与回收。acquire只做原子读写和CAS，不加锁；publish与reclaim之间用互斥锁串行
+//【接口说明】
+//  - explicit ModelHandle(CompiledNetwork network): 构造函数，以network作为版本1
+//  - ModelSnapshot acquire() const: 取得当前版本并保护它，可在任意线程调用
+//  - long long publish(CompiledNetwork network): 原子地发布新版本，返回其版本号；旧版本在没有读者时回收
+//  - size_t reclaim(): 回收不再受保护的旧版本，返回仍在等待回收的版本数
+//  - long long getVersion() const: 当前版本号
+//  - ~ModelHandle(): 析构函数，释放全部版本和记录，此时不得再有快照存在
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class ModelHandle {
+public:
+    explicit ModelHandle(CompiledNetwork network);
+    ModelHandle(const ModelHandle&) = delete;
+    ModelHandle& operator=(const ModelHandle&) = delete;
+    ModelSnapshot acquire() const;
+    long long publish(CompiledNetwork network);
+    size_t reclaim();
+    long long getVersion() const;
+    ~ModelHandle();
+
+private:
+    typedef ModelSnapshot::Version Version;
+    typedef ModelSnapshot::Record Record;
+    Record* acquireRecord() const;                // 占用一条空闲记录，没有时新建
+    size_t reclaimLocked();                       // 持有retireMutex时回收
+    std::atomic<const Version*> current;          // 当前版本
+    std::atomic<long long> versionNumber;         // 当前版本号
+    mutable std::atomic<Record*> records;         // 风险指针记录链表
+    std::mutex retireMutex;                       // 串行化发布和回收
+    std::vector<const Version*> retired;          // 已被替换、等待回收的版本
+};
+
+#endif // MODEL_HANDLE_HPP
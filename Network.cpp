@@ -6,14 +6,28 @@
 // 【更改记录】2025年7月23日 增加拷贝构造函数和赋值运算符重载，使用addLayer等函数从基础结构重新构建网络，防止浅拷贝导致的指针错误
 // 【更改记录】2025年7月24日 增加网络名称的设置和获取功能, 在showInfo中增加对网络名称和有效性的显示
 // 【更改记录】2025年7月29日 删除私有成员变量layerCount，改为使用layers.size()获取层数
+// 【更改记录】2026年10月19日 增加设置指定神经元偏置的功能
+// 【更改记录】2026年10月19日 deleteLayer释放被删除的层
+// 【更改记录】2026年10月19日 forward增加可编译关闭的计时和时间线跟踪
+// 【更改记录】2026年10月19日 增加内存占用统计memoryUsage
+// 【更改记录】2026年10月19日 增加forward写入缓冲区的重载，预热后的前向传播不再分配内存
+// 【更改记录】2026年10月19日 增加只读推理infer，激活值写入调用方的工作区，多个线程可共享同一网络
+// 【更改记录】2026年10月19日 拷贝构造和赋值保留每个神经元各自的激活函数类型
+// 【更改记录】2026年10月19日 紧凑表示的估算计入执行顺序和激活函数分段
+// 【更改记录】2026年10月19日 infer先判断前驱非空并落在前一层内，再做指针减法
 //-------------------------------------------------------------------------------------------------------------------
 
 #include "Network.hpp"  // 网络类头文件
 #include "Layer.hpp"    // 层类所在头文件
 #include "Neuron.hpp"   // 神经元类所在头文件
+#include "CompiledNetwork.hpp" // 紧凑层结构，用于估算紧凑表示的大小
+#include "Profiler.hpp" // 分层计时
+#include "Tracer.hpp"   // 时间线跟踪
 #include <iostream>     // 输入输出流头文件
 #include <stdexcept>    // 标准异常头文件
 #include <exception>    // 异常处理头文件
+#include <functional>   // std::less
+#include <set>          // 集合，统计每层的激活函数类型
 
 //-------------------------------------------------------------------------------------------------------------------
 // 【函数名称】Network::Network
@@ -23,6 +37,7 @@
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月24日：增加对网络名称的初始化
 // 【更改记录】2025年7月29日：删除私有成员变量layerCount，改为使用layers.size()获取层数
+// 【更改记录】2026年10月19日 层的跟踪参数标明为index
 //-------------------------------------------------------------------------------------------------------------------
 Network::Network() {
     networkName = "Untitled";
@@ -36,25 +51,21 @@ Network::Network() {
 // 【更改记录】2025年7月23日：从基础结构拷贝构造，解决指针传递问题
 // 【更改记录】2025年7月24日：增加对网络名称的拷贝
 // 【更改记录】2025年7月29日：删除私有成员变量layerCount，改为使用layers.size()获取层数
+// 【更改记录】2026年10月19日：保留每个神经元各自的激活函数类型，不再统一为第一个神经元的类型
 //-------------------------------------------------------------------------------------------------------------------
 Network::Network(const Network& other) :  networkName(other.networkName) {
     // 逐层重新构建网络
     for (const auto* layer : other.layers) {
-        // 收集该层神经元的偏置值
+        // 收集该层神经元的偏置值和激活函数类型
         std::vector<double> biases;
-        const auto& neurons = layer->getNeurons();
-        for (const auto& neuron : neurons) {
+        std::vector<int> activationTypes;
+        for (const auto& neuron : layer->getNeurons()) {
             biases.push_back(neuron.getBias());
-        }
-        
-        // 使用第一个神经元的激活函数类型作为整层的激活函数
-        int activationType = 0;
-        if (!neurons.empty()) {
-            activationType = neurons[0].getActivationFunctionType();
+            activationTypes.push_back(neuron.getActivationFunctionType());
         }
         
         // 创建新层并添加到网络中
-        Layer* newLayer = new Layer(this, layer->getNeuronCount(), biases, activationType);
+        Layer* newLayer = new Layer(this, layer->getNeuronCount(), biases, activationTypes);
         addLayer(newLayer);
     }
     
@@ -86,6 +97,7 @@ Network::Network(const Network& other) :  networkName(other.networkName) {
 // 【开发者及日期】李孟涵 2025年7月21日
 // 【更改记录】2025年7月23日：从基础结构拷贝构造，解决指针传递问题
 // 【更改记录】2025年7月24日：增加网络名称的传递
+// 【更改记录】2026年10月19日：保留每个神经元各自的激活函数类型
 //-------------------------------------------------------------------------------------------------------------------
 Network& Network::operator=(const Network& other) {
     if (this != &other) {
@@ -97,21 +109,16 @@ Network& Network::operator=(const Network& other) {
         networkName = other.networkName;  // 复制网络名称
         // 逐层重新构建网络
         for (const auto* layer : other.layers) {
-            // 收集该层神经元的偏置值
+            // 收集该层神经元的偏置值和激活函数类型
             std::vector<double> biases;
-            const auto& neurons = layer->getNeurons();
-            for (const auto& neuron : neurons) {
+            std::vector<int> activationTypes;
+            for (const auto& neuron : layer->getNeurons()) {
                 biases.push_back(neuron.getBias());
-            }
-            
-            // 使用第一个神经元的激活函数类型作为整层的激活函数
-            int activationType = 0;
-            if (!neurons.empty()) {
-                activationType = neurons[0].getActivationFunctionType();
+                activationTypes.push_back(neuron.getActivationFunctionType());
             }
             
             // 创建新层并添加到网络中
-            Layer* newLayer = new Layer(this, layer->getNeuronCount(), biases, activationType);
+            Layer* newLayer = new Layer(this, layer->getNeuronCount(), biases, activationTypes);
             addLayer(newLayer);
         }
         
@@ -159,6 +166,23 @@ void Network::setWeights(int layerIndex, const std::vector<std::vector<double>>&
     (*it)->setWeights(weights);
 }
 //-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Network::setBias
+//【函数功能】设置指定层中指定神经元的偏置值
+//【参数】layerIndex - 层索引，neuronIndex - 神经元索引，bias - 新的偏置值
+//【返回值】void - 无返回值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Network::setBias(int layerIndex, int neuronIndex, double bias) {
+    if (layerIndex < 0 || layerIndex >= static_cast<int>(layers.size())) {// 检查层索引是否有效
+        std::cerr << "Error: Layer index out of range.\n";
+        throw std::out_of_range("Layer index out of range");
+    }
+    auto it = layers.begin();
+    std::advance(it, layerIndex);
+    (*it)->setBias(neuronIndex, bias);
+}
+//-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Network::addLayer
 //【函数功能】向神经网络中添加一个新的层
 //【参数】layer - 指向要添加的层的指针
@@ -225,8 +249,27 @@ void Network::deleteNeuron(int layerIndex, int neuronIndex) {
 //【返回值】std::vector<std::vector<double>> - 每一层的输出结果
 //【开发者及日期】李孟涵 2025年7月13日
 //【更改记录】2025年7月24日：增加异常处理，检查网络有效性和输入大小
+//【更改记录】2026年10月19日 定义CANN_PROFILE时记录整次前向传播的耗时
+//【更改记录】2026年10月19日 定义CANN_TRACE时记录整次前向传播和每一层的时间线
+//【更改记录】2026年10月19日 改为调用写入缓冲区的重载
 //-------------------------------------------------------------------------------------------------------------------
 std::vector<std::vector<double>> Network::forward(const std::vector<double>& inputs) {
+    std::vector<std::vector<double>> outputs;     // 存储每一层的输出
+    forward(inputs, outputs);
+    return outputs;
+}
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Network::forward
+//【函数功能】执行神经网络的前向传播，把每一层的输出写入outputs。outputs的层数和各层长度与网络一致时
+//           只覆盖其中的值，配合Layer::setInput和Neuron::updateInput的原地写入，预热后整个调用不分配内存
+//【参数】inputs - 输入数据向量，outputs - 每一层的输出结果
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Network::forward(const std::vector<double>& inputs, std::vector<std::vector<double>>& outputs) {
+    CANN_PROFILE_SCOPE(this, 0);
+    CANN_TRACE_SCOPE("forward", "Network::forward");
     if (layers.empty()) {// 检查网络是否为空
         std::cerr << "Error: Network is empty. Cannot perform forward propagation.\n";
         throw std::runtime_error("Network is empty. Cannot perform forward propagation.");
@@ -239,20 +282,93 @@ std::vector<std::vector<double>> Network::forward(const std::vector<double>& inp
         std::cerr << "Error: Network is not valid. Cannot perform forward propagation.\n";
         throw std::runtime_error("Network is not valid. Cannot perform forward propagation.");
     }
-    std::vector<std::vector<double>> outputs;     // 存储每一层的输出
-    std::vector<double> currentInputs = inputs;   // 当前输入，初始为网络输入
-    layers.front()->setInput(currentInputs);
+    layers.front()->setInput(inputs);
+    outputs.resize(layers.size());
+    int layerIndex = 0;
     for (auto& layer : layers) {
+        CANN_TRACE_SCOPE_ARG("forward", "Layer", "index", layerIndex);
         layer->updateOutputs();
-        std::vector<double> layerOutputs;
-        for (const auto& neuron : layer->getNeurons()) {// 获取当前层每个神经元的输出
-            layerOutputs.push_back(neuron.getOutput());
+        const auto& neurons = layer->getNeurons();
+        std::vector<double>& layerOutputs = outputs[layerIndex++];
+        layerOutputs.resize(neurons.size());
+        for (size_t i = 0; i < neurons.size(); ++i) {// 获取当前层每个神经元的输出
+            layerOutputs[i] = neurons[i].getOutput();
         }
-        outputs.push_back(layerOutputs);
-        currentInputs = layerOutputs;             // 下一层的输入是当前层的输出
     }
+}
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Network::infer
+//【函数功能】只读推理：与forward计算相同的结果，但激活值全部写入调用方的工作区，只读取权重、偏置和
+//           激活函数类型，不写神经元和突触。因此多个线程可以各带一个工作区同时对同一个网络推理，
+//           只要推理期间没有线程修改网络结构或参数。工作区形状与网络一致时不分配内存
+//【参数】inputs - 输入数据向量，context - 推理工作区，返回后第i层的激活值在context.getLayer(i)
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 前驱先判断非空并用std::less判断落在前一层内，再换算下标
+//-------------------------------------------------------------------------------------------------------------------
+void Network::infer(const std::vector<double>& inputs, InferenceContext& context) const {
+    CANN_TRACE_SCOPE("forward", "Network::infer");
+    if (layers.empty()) {// 检查网络是否为空
+        std::cerr << "Error: Network is empty. Cannot perform inference.\n";
+        throw std::runtime_error("Network is empty. Cannot perform inference.");
+    }
+    if (static_cast<int>(inputs.size()) != layers.front()->getNeuronCount()) {// 检查输入大小是否与第一层神经元数量匹配
+        std::cerr << "Error: Input size does not match the number of neurons in the first layer.\n";
+        throw std::invalid_argument("Input size does not match the number of neurons in the first layer.");
+    }
+    if (!isValid()) {// 检查网络是否有效
+        std::cerr << "Error: Network is not valid. Cannot perform inference.\n";
+        throw std::runtime_error("Network is not valid. Cannot perform inference.");
+    }
+    context.setLayerCount(static_cast<int>(layers.size()));
+    int layerIndex = 0;
+    for (const Layer* layer : layers) {
+        context.setLayerSize(layerIndex++, layer->getNeuronCount());
+    }
+    context.allocate();
 
-    return outputs;
+    const Neuron* previousNeurons = nullptr; // 前一层神经元数组的起始地址，用于把前驱指针换算成下标
+    const Neuron* previousEnd = nullptr;     // 前一层神经元数组的末尾
+    std::less<const Neuron*> before;         // 任意指针间的全序比较，不要求指向同一数组
+    const double* previousOutputs = nullptr;
+    layerIndex = 0;
+    for (const Layer* layer : layers) {
+        const std::vector<Neuron>& neurons = layer->getNeurons();
+        double* layerOutputs = context.getLayer(layerIndex);
+        for (size_t i = 0; i < neurons.size(); ++i) {
+            const Neuron& neuron = neurons[i];
+            double sum = neuron.getBias();
+            if (layerIndex == 0) {// 第一层：输入直接加到偏置上
+                sum += inputs[i];
+            } else {
+                for (const Synapse* dendrite : neuron.getDendrites()) {
+                    const Neuron* pre = dendrite->getPre();
+                    if (pre == nullptr || before(pre, previousNeurons) || !before(pre, previousEnd)) {
+                        continue; // 与forward一致，没有前驱的突触输入为0
+                    }
+                    sum += previousOutputs[pre - previousNeurons] * dendrite->getWeight();
+                }
+            }
+            layerOutputs[i] = ActivationFunc::apply(neuron.getActivationFunctionType(), sum);
+        }
+        previousNeurons = neurons.data();
+        previousEnd = previousNeurons + neurons.size();
+        previousOutputs = layerOutputs;
+        ++layerIndex;
+    }
+}
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Network::infer
+//【函数功能】使用当前线程的工作区做只读推理，每个线程的工作区各自按缓存行对齐，互不共享缓存行
+//【参数】inputs - 输入数据向量
+//【返回值】std::vector<double> - 最后一层的输出
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<double> Network::infer(const std::vector<double>& inputs) const {
+    thread_local InferenceContext context;
+    infer(inputs, context);
+    return context.getOutputs();
 }
 //-------------------------------------------------------------------------------------------------------------------
 // 【函数名称】Network::deleteLayer
@@ -262,6 +378,7 @@ std::vector<std::vector<double>> Network::forward(const std::vector<double>& inp
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月21日 第一版
 // 【更改记录】2025年7月23日 第二版，增加异常处理
+// 【更改记录】2026年10月19日 释放被删除的层，修复内存泄漏
 //-------------------------------------------------------------------------------------------------------------------
 void Network::deleteLayer(int index) {
     if (index < 0 || index >= layers.size()) {
@@ -271,6 +388,7 @@ void Network::deleteLayer(int index) {
 
     if (layers.size() == 1) {
         // 如果只有一层，直接清空
+        delete layers.front();
         layers.clear();
         return;
     }
@@ -309,7 +427,9 @@ void Network::deleteLayer(int index) {
     }
     
     // 删除当前层
+    Layer* layerToDelete = *it;
     layers.erase(it);
+    delete layerToDelete;
 }
 /* void Network::deleteLayer(int index) //初版deleteLayer函数
 {
@@ -643,14 +763,112 @@ int Network::getLayerCount() const {
     return layers.size();
 }
 //-------------------------------------------------------------------------------------------------------------------
+//【函数名称】heapOverhead
+//【函数功能】估算一次堆分配的分配器额外开销：glibc malloc每块带8字节块头，按16字节对齐，最小32字节
+//【参数】bytes - 申请的字节数
+//【返回值】size_t - 实际占用与申请字节数之差，bytes为0时返回0（未分配）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static size_t heapOverhead(size_t bytes) {
+    if (bytes == 0) {
+        return 0;
+    }
+    size_t chunk = (bytes + sizeof(size_t) + 15) & ~static_cast<size_t>(15);
+    if (chunk < 32) {
+        chunk = 32;
+    }
+    return chunk - bytes;
+}
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Network::memoryUsage
+//【函数功能】统计网络各部分的内存占用。每个Synapse对象只计入其后继神经元所在的层（即按树突计），
+//           向量按已分配的容量计；紧凑表示按CompiledLayer的布局计算：CompiledLayer对象本身，每个神经元一个double偏置、
+//           一个int激活类型以及执行顺序和位置各一个int，非输入层另有神经元数+1个int行偏移，每个突触一个int列下标和
+//           一个double权重；每个激活函数段（层内每种激活函数类型一段）一个int起点、一个int类型和一个LayerKernel，
+//           另有一个int段终点
+//【参数】无
+//【返回值】MemoryUsage - 各层及合计的内存占用
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 紧凑表示计入executionOrder、positions和segmentOffsets、segmentTypes、segmentKernels
+//-------------------------------------------------------------------------------------------------------------------
+MemoryUsage Network::memoryUsage() const {
+    const size_t listNodeBytes = 2 * sizeof(void*) + sizeof(Layer*); // std::list节点：前后指针和元素
+    MemoryUsage usage;
+    usage.networkBytes = sizeof(Network);
+    usage.totals.index = -1;
+    int index = 0;
+    for (const Layer* layer : layers) {
+        LayerMemoryUsage layerUsage;
+        layerUsage.index = index;
+        layerUsage.neuronCount = layer->getNeuronCount();
+        layerUsage.layerBytes = sizeof(Layer) + listNodeBytes;
+        layerUsage.allocatorOverheadBytes = heapOverhead(sizeof(Layer)) + heapOverhead(listNodeBytes);
+        layerUsage.allocationCount = 2;
+        layerUsage.neuronBytes = layer->getNeuronCapacity() * sizeof(Neuron);
+        if (layerUsage.neuronBytes > 0) {
+            layerUsage.allocatorOverheadBytes += heapOverhead(layerUsage.neuronBytes);
+            ++layerUsage.allocationCount;
+        }
+        std::set<int> activationTypes;
+        for (const auto& neuron : layer->getNeurons()) {
+            activationTypes.insert(neuron.getActivationFunctionType());
+            const size_t dendrites = neuron.getDendrites().size();
+            const size_t pointerBlocks[] = { neuron.getDendriteCapacity() * sizeof(Synapse*),
+                                             neuron.getAxonCapacity() * sizeof(Synapse*) };
+            const size_t inputBytes = neuron.getInputCapacity() * sizeof(double);
+            layerUsage.synapseCount += static_cast<long long>(dendrites);
+            layerUsage.synapseBytes += dendrites * sizeof(Synapse);
+            layerUsage.allocatorOverheadBytes += dendrites * heapOverhead(sizeof(Synapse));
+            layerUsage.allocationCount += dendrites;
+            for (size_t bytes : pointerBlocks) {
+                layerUsage.synapsePointerBytes += bytes;
+                layerUsage.allocatorOverheadBytes += heapOverhead(bytes);
+                layerUsage.allocationCount += bytes > 0 ? 1 : 0;
+            }
+            layerUsage.inputBufferBytes += inputBytes;
+            layerUsage.allocatorOverheadBytes += heapOverhead(inputBytes);
+            layerUsage.allocationCount += inputBytes > 0 ? 1 : 0;
+        }
+        layerUsage.totalBytes = layerUsage.layerBytes + layerUsage.neuronBytes + layerUsage.synapseBytes
+                              + layerUsage.synapsePointerBytes + layerUsage.inputBufferBytes
+                              + layerUsage.allocatorOverheadBytes;
+        const size_t neuronCount = static_cast<size_t>(layerUsage.neuronCount);
+        const size_t segmentCount = activationTypes.size();
+        layerUsage.compactBytes = sizeof(CompiledLayer) + neuronCount * (sizeof(double) + 3 * sizeof(int))
+                                + (index > 0 ? (neuronCount + 1) * sizeof(int) : 0)
+                                + static_cast<size_t>(layerUsage.synapseCount) * (sizeof(int) + sizeof(double))
+                                + segmentCount * (2 * sizeof(int) + sizeof(LayerKernel)) + sizeof(int);
+        LayerMemoryUsage& totals = usage.totals;
+        totals.neuronCount += layerUsage.neuronCount;
+        totals.synapseCount += layerUsage.synapseCount;
+        totals.layerBytes += layerUsage.layerBytes;
+        totals.neuronBytes += layerUsage.neuronBytes;
+        totals.synapseBytes += layerUsage.synapseBytes;
+        totals.synapsePointerBytes += layerUsage.synapsePointerBytes;
+        totals.inputBufferBytes += layerUsage.inputBufferBytes;
+        totals.allocatorOverheadBytes += layerUsage.allocatorOverheadBytes;
+        totals.allocationCount += layerUsage.allocationCount;
+        totals.totalBytes += layerUsage.totalBytes;
+        totals.compactBytes += layerUsage.compactBytes;
+        usage.layers.push_back(layerUsage);
+        ++index;
+    }
+    usage.totalBytes = usage.networkBytes + usage.totals.totalBytes;
+    usage.compactBytes = usage.totals.compactBytes;
+    usage.ratio = usage.compactBytes > 0 ? static_cast<double>(usage.totalBytes) / usage.compactBytes : 0.0;
+    return usage;
+}
+//-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Network::~Network
 //【函数功能】Network类的析构函数，释放所有动态分配的Layer
 //【参数】无
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月21日
-//【更改记录】无
+//【更改记录】2026年10月19日 清除网络的计时计数
 //-------------------------------------------------------------------------------------------------------------------
 Network::~Network() {
+    CANN_PROFILE_FORGET(this);
     // 释放所有动态分配的 Layer 对象
     for (auto& layer : layers) {
         delete layer;
@@ -6,15 +6,61 @@
 // 【更改记录】2025年7月23日 增加拷贝构造函数和赋值运算符重载，使用addLayer等函数从基础结构重新构建网络，防止浅拷贝导致的指针错误
 // 【更改记录】2025年7月24日 增加网络名称的设置和获取功能
 // 【更改记录】2025年7月29日 删除私有成员变量layerCount，改为使用layers.size()获取层数
+// 【更改记录】2026年10月19日 增加设置指定神经元偏置的功能，供训练器回写参数
+// 【更改记录】2026年10月19日 增加内存占用统计memoryUsage
+// 【更改记录】2026年10月19日 增加把结果写入调用方缓冲区的forward重载，预热后不分配内存
+// 【更改记录】2026年10月19日 增加不修改网络状态的const推理接口infer，可多线程共享同一网络
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef NETWORK_HPP
 #define NETWORK_HPP
 
 #include "Layer.hpp" // 层类所在头文件
+#include "InferenceContext.hpp" // 推理工作区
+#include <cstddef>   // size_t所属头文件
 #include <list>      // 链表所在头文件
 #include <string>    // 字符串所在头文件
 
+//-------------------------------------------------------------------------------------------------------------------
+// 【结构体名】LayerMemoryUsage
+// 【功能】一层的内存占用（字节）。layerBytes为Layer对象及其链表节点，neuronBytes为神经元数组（按容量），
+//         synapseBytes为本层树突指向的Synapse对象，synapsePointerBytes为各神经元树突、轴突指针数组（按容量），
+//         inputBufferBytes为各神经元输入向量（按容量），allocatorOverheadBytes为以上每次堆分配的分配器额外开销
+//         （按glibc malloc的块头和16字节对齐估算）；compactBytes为同一层在CompiledNetwork紧凑表示下所需的字节数
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct LayerMemoryUsage {
+    int index = 0;                     // 层索引
+    int neuronCount = 0;               // 神经元数量
+    long long synapseCount = 0;        // 输入突触数量
+    size_t layerBytes = 0;             // Layer对象及链表节点
+    size_t neuronBytes = 0;            // 神经元数组
+    size_t synapseBytes = 0;           // Synapse对象
+    size_t synapsePointerBytes = 0;    // 树突、轴突指针数组
+    size_t inputBufferBytes = 0;       // 输入向量
+    size_t allocatorOverheadBytes = 0; // 分配器额外开销（估算）
+    size_t allocationCount = 0;        // 堆分配次数
+    size_t totalBytes = 0;             // 以上合计
+    size_t compactBytes = 0;           // 紧凑表示所需字节数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【结构体名】MemoryUsage
+// 【功能】整个网络的内存占用。totals为各层之和（其index为-1），networkBytes为Network对象本身，
+//         totalBytes和compactBytes均包含networkBytes之外的全部字节，ratio为totalBytes与compactBytes之比
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct MemoryUsage {
+    std::vector<LayerMemoryUsage> layers; // 各层统计
+    LayerMemoryUsage totals;              // 各层合计
+    size_t networkBytes = 0;              // Network对象本身
+    size_t totalBytes = 0;                // 总字节数
+    size_t compactBytes = 0;              // 紧凑表示总字节数
+    double ratio = 0.0;                   // totalBytes / compactBytes
+};
+
 //-------------------------------------------------------------------------------------------------------------------
 // 【类名】Network
 // 【功能】管理完整的神经网络，包括层的添加删除、前向传播、权重设置、网络验证、文件导入导出等功能
@@ -24,8 +70,15 @@
 //   - Network& operator=(const Network& other): 赋值运算符重载
 //   - void addLayer(Layer* layer): 添加新的网络层
 //   - std::vector<std::vector<double>> forward(const std::vector<double>& inputs): 执行前向传播
+//   - void forward(const std::vector<double>& inputs, std::vector<std::vector<double>>& outputs):
+//     执行前向传播，每层输出写入outputs，outputs形状不变时不分配内存
+//   - void infer(const std::vector<double>& inputs, InferenceContext& context) const:
+//     只读推理，各层激活值写入调用方的工作区，不修改神经元和突触；工作区形状不变时不分配内存
+//   - std::vector<double> infer(const std::vector<double>& inputs) const: 使用线程局部工作区的只读推理，
+//     返回最后一层的输出
 //   - bool isValid() const: 验证网络结构合法性
 //   - void setWeights(int layerIndex, const std::vector<std::vector<double>>& weights): 设置权重
+//   - void setBias(int layerIndex, int neuronIndex, double bias): 设置指定神经元的偏置
 //   - void deleteLayer(int index): 删除指定索引的网络层
 //   - void addLayer(int index): 在指定索引处添加新层
 //   - void addNeuron(int layerIndex, double bias, int activationType): 添加神经元
@@ -39,11 +92,16 @@
 //   - const Layer* getLayer(int index) const: 获取指定层
 //   - const std::list<Layer*>& getLayers() const: 获取所有层列表
 //   - int getLayerCount() const: 获取网络层数
+//   - MemoryUsage memoryUsage() const: 统计网络各部分的内存占用并与紧凑表示比较
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月21日 添加了网络层的添加、删除、前向传播等功能
 // 【更改记录】2025年7月23日 增加拷贝构造函数和赋值运算符重载，使用addLayer等函数从基础结构重新构建网络，防止浅拷贝导致的指针错误
 // 【更改记录】2025年7月24日 增加网络名称的设置和获取功能
 // 【更改记录】2025年7月29日 删除私有成员变量layerCount，改为使用layers.size()获取层数
+// 【更改记录】2026年10月19日 增加setBias
+// 【更改记录】2026年10月19日 增加memoryUsage
+// 【更改记录】2026年10月19日 增加forward写入缓冲区的重载
+// 【更改记录】2026年10月19日 增加const推理接口infer
 //-------------------------------------------------------------------------------------------------------------------
 class Network {
 public:
@@ -52,8 +110,12 @@ public:
     Network& operator=(const Network& other);                   // 赋值运算符重载，使用addLayer等函数从基础结构重新构建网络
     void addLayer(Layer* layer);                                // 添加新的网络层
     std::vector<std::vector<double>> forward(const std::vector<double>& inputs); // 执行神经网络的前向传播，计算每一层的输出
+    void forward(const std::vector<double>& inputs, std::vector<std::vector<double>>& outputs); // 前向传播，复用outputs的内存
+    void infer(const std::vector<double>& inputs, InferenceContext& context) const; // 只读推理，激活值写入context
+    std::vector<double> infer(const std::vector<double>& inputs) const; // 使用线程局部工作区的只读推理
     bool isValid() const;                                       // 验证网络结构的合法性
     void setWeights(int layerIndex = 0, const std::vector<std::vector<double>>& weights = {}); // 设置指定层的权重
+    void setBias(int layerIndex, int neuronIndex, double bias); // 设置指定层指定神经元的偏置
     void deleteLayer(int index);                                // 删除指定索引的网络层
     void addLayer(int index);                                   // 在指定索引处添加新的网络层
     void addNeuron(int layerIndex, double bias = 0.0, int activationType = 0); // 向指定层添加一个新的神经元
@@ -67,6 +129,7 @@ public:
     const Layer* getLayer(int index) const;                     // 获取指定索引的网络层
     const std::list<Layer*>& getLayers() const;                 // 获取所有网络层的列表
     int getLayerCount() const;                                  // 获取网络层数
+    MemoryUsage memoryUsage() const;                            // 统计内存占用
 private:                                    // 记录网络层数
     std::list<Layer*> layers;                                   // 用链表存储所有网络层的指针
     std::string networkName;                                    // 网络名称
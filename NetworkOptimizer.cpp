@@ -0,0 +1,280 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】NetworkOptimizer.cpp
+//【功能模块和目的】Network图优化的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加零权重突触和无效神经元的消除
+//【更改记录】2026年10月19日 前驱下标改由Layer::indexOf给出
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "NetworkOptimizer.hpp" // 网络优化类头文件
+#include "Layer.hpp"            // 层类所在头文件
+#include "Neuron.hpp"           // 神经元类所在头文件
+#include "Synapse.hpp"          // 突触类所在头文件
+#include "ActivationFunc.hpp"   // 激活函数类头文件
+#include <iostream>             // 输入输出流头文件
+#include <stdexcept>            // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::denseWeights
+//【函数功能】读取本层与前一层之间的权重，返回“本层神经元数 × 前一层神经元数”的矩阵，不存在的突触为0
+//【参数】layer - 非第一层的层
+//【返回值】std::vector<std::vector<double>> - 权重矩阵
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 前驱下标改由Layer::indexOf给出
+//-------------------------------------------------------------------------------------------------------------------
+std::vector<std::vector<double>> NetworkOptimizer::denseWeights(const Layer& layer) {
+    const Layer* previous = layer.getPreviousLayer();
+    const std::vector<Neuron>& previousNeurons = previous->getNeurons();
+    const std::vector<Neuron>& neurons = layer.getNeurons();
+    std::vector<std::vector<double>> weights(neurons.size(), std::vector<double>(previousNeurons.size(), 0.0));
+    for (size_t i = 0; i < neurons.size(); ++i) {
+        for (const Synapse* dendrite : neurons[i].getDendrites()) {
+            const int column = previous->indexOf(dendrite->getPre());
+            if (column >= 0) {
+                weights[i][column] += dendrite->getWeight();
+            }
+        }
+    }
+    return weights;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::isLinear
+//【函数功能】判断层内神经元是否全部使用线性激活
+//【参数】layer - 层
+//【返回值】bool - 是否全部线性
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool NetworkOptimizer::isLinear(const Layer& layer) {
+    for (const Neuron& neuron : layer.getNeurons()) {
+        if (neuron.getActivationFunctionType() != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::measure
+//【函数功能】统计网络的层数、神经元数和突触数
+//【参数】network - 网络，layers、neurons、synapses - 统计结果
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void NetworkOptimizer::measure(const Network& network, int& layers, long long& neurons, long long& synapses) {
+    layers = network.getLayerCount();
+    neurons = 0;
+    synapses = 0;
+    for (const Layer* layer : network.getLayers()) {
+        neurons += layer->getNeuronCount();
+        synapses += layer->getSynapseCount();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::fuseLinearLayers
+//【函数功能】从第二层起检查每个隐藏层：全部线性且合并后突触更少时，计算W2·W1和W2·b1+b2，
+//           删除该层（deleteLayer会把前后两层全连接），再写入合并后的权重和偏置。
+//           合并后的层仍从同一位置继续检查，因此连续多个线性层会被逐个并入
+//【参数】network - 网络，须为有效网络
+//【返回值】OptimizationReport - 优化结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+OptimizationReport NetworkOptimizer::fuseLinearLayers(Network& network) {
+    if (!network.isValid()) {
+        std::cerr << "Error: Network is not valid. Cannot optimize.\n";
+        throw std::runtime_error("Network is not valid. Cannot optimize.");
+    }
+    OptimizationReport report;
+    measure(network, report.layersBefore, report.neuronsBefore, report.synapsesBefore);
+    int index = 1;
+    while (index + 1 < network.getLayerCount()) {
+        const Layer& middle = *network.getLayer(index);
+        const Layer& next = *network.getLayer(index + 1);
+        const long long previousCount = network.getLayer(index - 1)->getNeuronCount();
+        const long long fusedSynapses = previousCount * next.getNeuronCount();
+        if (!isLinear(middle) || fusedSynapses >= middle.getSynapseCount() + next.getSynapseCount()) {
+            ++index;
+            continue;
+        }
+        std::vector<std::vector<double>> first = denseWeights(middle);
+        std::vector<std::vector<double>> second = denseWeights(next);
+        std::vector<std::vector<double>> fused(next.getNeuronCount(), std::vector<double>(previousCount, 0.0));
+        std::vector<double> biases(next.getNeuronCount());
+        for (int i = 0; i < next.getNeuronCount(); ++i) {
+            biases[i] = next.getNeuron(i).getBias();
+            for (int k = 0; k < middle.getNeuronCount(); ++k) {
+                const double weight = second[i][k];
+                if (weight == 0.0) {
+                    continue;
+                }
+                biases[i] += weight * middle.getNeuron(k).getBias();
+                for (long long j = 0; j < previousCount; ++j) {
+                    fused[i][j] += weight * first[k][j];
+                }
+            }
+        }
+        network.deleteLayer(index);
+        network.setWeights(index, fused);
+        for (int i = 0; i < static_cast<int>(biases.size()); ++i) {
+            network.setBias(index, i, biases[i]);
+        }
+        ++report.fusedLayers;
+    }
+    measure(network, report.layersAfter, report.neuronsAfter, report.synapsesAfter);
+    return report;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::removeZeroWeights
+//【函数功能】删除第二层起权重恰为0的突触。对有限输入，这些突触的信号为0，删除后求和结果不变
+//【参数】network - 网络
+//【返回值】long long - 删除的突触数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+long long NetworkOptimizer::removeZeroWeights(Network& network) {
+    long long removed = 0;
+    for (Layer* layer : network.getLayers()) {
+        if (layer->getPreviousLayer() == nullptr) {// 第一层的树突接收外部输入，不作处理
+            continue;
+        }
+        for (int i = 0; i < layer->getNeuronCount(); ++i) {
+            Neuron& neuron = layer->getNeuron(i);
+            std::vector<Neuron*> zeroInputs;
+            for (const Synapse* dendrite : neuron.getDendrites()) {
+                if (dendrite->getPre() != nullptr && dendrite->getWeight() == 0.0) {
+                    zeroInputs.push_back(dendrite->getPre());
+                }
+            }
+            for (Neuron* pre : zeroInputs) {
+                pre->disconnectTo(&neuron);
+            }
+            removed += static_cast<long long>(zeroInputs.size());
+        }
+    }
+    return removed;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::foldConstantNeurons
+//【函数功能】第三层起，前一层中没有输入突触的神经元输出恒为f(b)，把其信号f(b)·w按树突顺序加到本层神经元的偏置上，
+//           并删除对应突触。exact为true时遇到第一个非常量输入即停止，使偏置与其余信号的求和顺序与原来相同
+//【参数】network - 网络，exact - 是否只折叠树突最前面的常量输入
+//【返回值】long long - 折叠的突触数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 用Layer::indexOf判断前驱是否属于前一层
+//-------------------------------------------------------------------------------------------------------------------
+long long NetworkOptimizer::foldConstantNeurons(Network& network, bool exact) {
+    long long folded = 0;
+    for (Layer* layer : network.getLayers()) {
+        const Layer* previous = layer->getPreviousLayer();
+        if (previous == nullptr || previous->getPreviousLayer() == nullptr) {// 第一层的输出取决于输入
+            continue;
+        }
+        for (int i = 0; i < layer->getNeuronCount(); ++i) {
+            const Neuron& neuron = layer->getNeuron(i);
+            double bias = neuron.getBias();
+            std::vector<Neuron*> constants;
+            for (const Synapse* dendrite : neuron.getDendrites()) {
+                const Neuron* pre = dendrite->getPre();
+                if (previous->indexOf(pre) < 0 || !pre->getDendrites().empty()) {
+                    if (exact) {
+                        break;
+                    }
+                    continue;
+                }
+                bias += ActivationFunc::apply(pre->getActivationFunctionType(), pre->getBias()) * dendrite->getWeight();
+                constants.push_back(dendrite->getPre());
+            }
+            if (constants.empty()) {
+                continue;
+            }
+            network.setBias(layer->getIndex(), i, bias);
+            for (Neuron* pre : constants) {
+                pre->disconnectTo(&layer->getNeuron(i));
+            }
+            folded += static_cast<long long>(constants.size());
+        }
+    }
+    return folded;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::removeUnusedNeurons
+//【函数功能】从倒数第二层向前，删除没有输出突触的隐藏神经元（连同其输入突触），每层至少保留一个神经元。
+//           后面的层先处理，因此因删除而失去全部输出的前一层神经元在同一轮中被删除
+//【参数】network - 网络
+//【返回值】long long - 删除的神经元数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+long long NetworkOptimizer::removeUnusedNeurons(Network& network) {
+    long long removed = 0;
+    for (int index = network.getLayerCount() - 2; index >= 1; --index) {
+        const Layer& layer = *network.getLayer(index);
+        for (int i = layer.getNeuronCount() - 1; i >= 0 && layer.getNeuronCount() > 1; --i) {
+            if (layer.getNeuron(i).getAxonCount() == 0) {
+                network.deleteNeuron(index, i);
+                ++removed;
+            }
+        }
+    }
+    return removed;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::eliminateDeadNeurons
+//【函数功能】反复删除零权重突触、折叠常量神经元、删除无输出的神经元，直到网络不再变化
+//【参数】network - 网络，须为有效网络；exact - 是否保证forward的结果逐位不变
+//【返回值】OptimizationReport - 优化结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+OptimizationReport NetworkOptimizer::eliminateDeadNeurons(Network& network, bool exact) {
+    if (!network.isValid()) {
+        std::cerr << "Error: Network is not valid. Cannot optimize.\n";
+        throw std::runtime_error("Network is not valid. Cannot optimize.");
+    }
+    OptimizationReport report;
+    measure(network, report.layersBefore, report.neuronsBefore, report.synapsesBefore);
+    while (true) {
+        long long removedSynapses = removeZeroWeights(network);
+        long long foldedSynapses = foldConstantNeurons(network, exact);
+        long long removedNeurons = removeUnusedNeurons(network);
+        if (removedSynapses == 0 && foldedSynapses == 0 && removedNeurons == 0) {
+            break;
+        }
+        report.removedSynapses += removedSynapses;
+        report.foldedSynapses += foldedSynapses;
+        report.removedNeurons += removedNeurons;
+    }
+    measure(network, report.layersAfter, report.neuronsAfter, report.synapsesAfter);
+    return report;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】NetworkOptimizer::optimize
+//【函数功能】依次执行全部优化遍：先消除无效神经元，再合并线性层，最后清理合并产生的零权重，报告总的规模变化。
+//           线性层合并本身只保证舍入误差范围内相同，因此这里的消除也折叠全部常量输入
+//【参数】network - 网络
+//【返回值】OptimizationReport - 优化结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加无效神经元消除
+//-------------------------------------------------------------------------------------------------------------------
+OptimizationReport NetworkOptimizer::optimize(Network& network) {
+    OptimizationReport report = eliminateDeadNeurons(network, false);
+    OptimizationReport fused = fuseLinearLayers(network);
+    OptimizationReport cleaned = eliminateDeadNeurons(network, false);
+    report.layersAfter = cleaned.layersAfter;
+    report.neuronsAfter = cleaned.neuronsAfter;
+    report.synapsesAfter = cleaned.synapsesAfter;
+    report.fusedLayers = fused.fusedLayers;
+    report.removedSynapses += cleaned.removedSynapses;
+    report.foldedSynapses += cleaned.foldedSynapses;
+    report.removedNeurons += cleaned.removedNeurons;
+    return report;
+}
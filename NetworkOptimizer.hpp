@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】NetworkOptimizer.hpp
+//【功能模块和目的】Network的图优化：把连续的线性层按代数关系合并，消除零权重突触和不影响输出的神经元，
+//                  减少推理时的乘加次数。优化直接修改传入的网络，并报告优化前后的层数、神经元数和突触数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加零权重突触和无效神经元的消除
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef NETWORK_OPTIMIZER_HPP
+#define NETWORK_OPTIMIZER_HPP
+
+#include "Network.hpp" // 网络类头文件
+#include <vector>      // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】OptimizationReport
+//【功能】一次优化的结果：优化前后的规模（突触数即每次前向传播的乘加次数）和各优化遍的处理数量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加消除的突触数、神经元数和折叠的突触数
+//-------------------------------------------------------------------------------------------------------------------
+struct OptimizationReport {
+    int layersBefore = 0;            // 优化前的层数
+    int layersAfter = 0;             // 优化后的层数
+    long long neuronsBefore = 0;     // 优化前的神经元数
+    long long neuronsAfter = 0;      // 优化后的神经元数
+    long long synapsesBefore = 0;    // 优化前的突触数
+    long long synapsesAfter = 0;     // 优化后的突触数
+    int fusedLayers = 0;             // 被合并掉的线性层数
+    long long removedSynapses = 0;   // 删除的零权重突触数（随神经元删除的突触不计入）
+    long long removedNeurons = 0;    // 删除的无效神经元数
+    long long foldedSynapses = 0;    // 常量神经元被折叠进后一层偏置的输出突触数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】NetworkOptimizer
+//【功能】Network的优化遍。线性层合并：隐藏层L的神经元全部使用线性激活（类型0）时，
+//        L+1层的输出 f(W2·(W1·x+b1)+b2) = f((W2·W1)·x + (W2·b1+b2))，可删除L层，
+//        把L-1层直接以W2·W1全连接到L+1层。只在合并后的突触数少于合并前两层突触数之和时合并，
+//        并反复进行直到没有可合并的层。第一层（输入层）和最后一层（输出层）不会被删除。
+//        合并改变了浮点运算的顺序，输出与原网络只在舍入误差范围内相同。
+//        无效神经元消除：删除权重为0的突触；没有输入突触的隐藏神经元输出为常量f(b)，把w·f(b)加到后一层
+//        神经元的偏置上并删除该突触；没有输出突触的隐藏神经元不影响输出，予以删除。反复进行直到不再变化。
+//        exact为true时只折叠位于后一层神经元树突最前面的常量输入，此时求和顺序不变，对有限输入forward的结果
+//        与原网络逐位相同；为false时折叠全部常量输入，结果只在舍入误差范围内相同
+//【接口说明】
+//  - static OptimizationReport fuseLinearLayers(Network& network): 合并线性层
+//  - static OptimizationReport eliminateDeadNeurons(Network& network, bool exact = true): 消除零权重突触和无效神经元
+//  - static OptimizationReport optimize(Network& network): 执行全部优化遍
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加eliminateDeadNeurons
+//-------------------------------------------------------------------------------------------------------------------
+class NetworkOptimizer {
+public:
+    static OptimizationReport fuseLinearLayers(Network& network);
+    static OptimizationReport eliminateDeadNeurons(Network& network, bool exact = true);
+    static OptimizationReport optimize(Network& network);
+
+private:
+    static std::vector<std::vector<double>> denseWeights(const Layer& layer); // 本层与前一层之间的稠密权重矩阵
+    static bool isLinear(const Layer& layer);                                  // 本层神经元是否全部为线性激活
+    static void measure(const Network& network, int& layers, long long& neurons, long long& synapses); // 统计规模
+    static long long removeZeroWeights(Network& network);                      // 删除零权重突触
+    static long long foldConstantNeurons(Network& network, bool exact);        // 把常量神经元的输出折叠进偏置
+    static long long removeUnusedNeurons(Network& network);                    // 删除没有输出突触的隐藏神经元
+};
+
+#endif // NETWORK_OPTIMIZER_HPP
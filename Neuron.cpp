@@ -4,6 +4,9 @@
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月13日 不将树突轴突作为两个类 2025年7月21日 新增去除无效连接功能
 // 【更改记录】2025年7月29日 删除索引变量，改为基于网络内位置的动态计算
+// 【更改记录】2026年10月19日 增加getDendrites；updateOutput不再调用getPosition
+// 【更改记录】2026年10月19日 增加getDendriteCapacity、getAxonCapacity
+// 【更改记录】2026年10月19日 updateInput原地写入细胞体输入，不再分配临时向量
 //-------------------------------------------------------------------------------------------------------------------
 
 #include "Neuron.hpp"     // 神经元类头文件
@@ -178,6 +181,32 @@ std::vector<double> Neuron::getWeights() const {
     return weights;
 }
 //-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Neuron::getDendrites
+//【函数功能】获取当前神经元的树突列表，可通过Synapse::getPre得到前驱神经元
+//【参数】无
+//【返回值】const std::vector<Synapse*>& - 树突列表
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+const std::vector<Synapse*>& Neuron::getDendrites() const {
+    return Dendrites;
+}
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Neuron::getDendriteCapacity / Neuron::getAxonCapacity
+//【函数功能】获取树突、轴突列表已分配的容量（元素个数），用于统计内存占用
+//【参数】无
+//【返回值】size_t - 容量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t Neuron::getDendriteCapacity() const {
+    return Dendrites.capacity();
+}
+
+size_t Neuron::getAxonCapacity() const {
+    return Axon.capacity();
+}
+//-------------------------------------------------------------------------------------------------------------------
 // 【函数名称】Neuron::setWeights
 // 【函数功能】设置当前神经元的突触权重
 // 【参数】weights - 突触权重的向量
@@ -298,17 +327,16 @@ void Neuron::cleanInvalidSynapses(const std::vector<Neuron*>& invalidNeurons) {
 //【参数】无
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 直接写入细胞体的输入向量，树突数不变时不分配内存
 //-------------------------------------------------------------------------------------------------------------------
 void Neuron::updateInput() {
-    std::vector<double> inputs;
     for (const auto& dendrite : Dendrites) {
         dendrite->setInput(dendrite->getPre() != nullptr ? dendrite->getPre()->getOutput() : 0.0);// 设置树突输入信号
     }
-    for (const auto& dendrite : Dendrites) {
-        inputs.push_back(dendrite->getSignal());// 收集所有树突的输入信号
+    Soma::resizeInputs(Dendrites.size());
+    for (size_t i = 0; i < Dendrites.size(); ++i) {
+        Soma::setInput(i, Dendrites[i]->getSignal());// 收集所有树突的输入信号
     }
-    Soma::setInputs(inputs); // 设置细胞体输入信号
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -317,10 +345,10 @@ void Neuron::updateInput() {
 //【参数】无
 //【返回值】无
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 直接用前一层是否存在判断是否为第一层，避免每次更新都线性查找位置
 //-------------------------------------------------------------------------------------------------------------------
 void Neuron::updateOutput() {
-    if (getPosition().first != 0) {
+    if (layer == nullptr || layer->getPreviousLayer() != nullptr) {// 非第一层：从树突收集输入
         updateInput(); // 更新树突输入信号
     }
     Soma::updateOutput(); // 更新细胞体输出信号
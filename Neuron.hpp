@@ -4,6 +4,8 @@
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月13日 不将树突轴突作为两个类
 // 【更改记录】2025年7月29日 删除私有成员变量layerIndex和index，改为基于层内位置的动态计算
+// 【更改记录】2026年10月19日 增加getDendrites，供编译紧凑网络时读取连接关系
+// 【更改记录】2026年10月19日 增加树突、轴突容量的查询，用于内存占用统计
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef NEURON_HPP
@@ -13,6 +15,7 @@
 #include <utility>
 #include <vector> //vector所属头文件
 class Network;
+class Layer;
 //-------------------------------------------------------------------------------------------------------------------
 // 【类名】Neuron
 // 【功能】实现人工神经网络中的神经元，继承自Soma类，提供神经元的连接、权重设置、信号传播等功能
@@ -23,6 +26,7 @@ class Network;
 //   - void connectTo(Neuron* other, double weight): 连接到另一神经元
 //   - void disconnectTo(Neuron* other): 断开与另一神经元的连接
 //   - std::vector<double> getWeights() const: 获取树突权重
+//   - const std::vector<Synapse*>& getDendrites() const: 获取树突列表
 //   - void setWeights(const std::vector<double>& weights): 设置树突权重
 //   - void setWeight(int index, double weight): 设置特定树突权重
 //   - void setLayer(Layer* newLayer): 设置所属层
@@ -30,6 +34,7 @@ class Network;
 //   - void showConnections() const: 显示连接信息
 //   - int getDendriteCount() const: 获取树突数量
 //   - int getAxonCount() const: 获取轴突数量
+//   - size_t getDendriteCapacity() const / size_t getAxonCapacity() const: 获取树突、轴突列表已分配的容量
 //   - void setBias(double newBias): 设置偏置
 //   - void remove(): 移除当前神经元
 //   - void cleanInvalidSynapses(const std::vector<Neuron*>& invalidNeurons): 清理无效突触
@@ -39,6 +44,8 @@ class Network;
 // 【开发者及日期】李孟涵 2025年7月13日
 // 【更改记录】2025年7月13日 不将树突轴突作为两个类
 // 【更改记录】2025年7月29日 删除私有成员变量layerIndex和index，改为基于层内位置的动态计算
+// 【更改记录】2026年10月19日 增加getDendrites
+// 【更改记录】2026年10月19日 增加getDendriteCapacity、getAxonCapacity
 //-------------------------------------------------------------------------------------------------------------------
 class Neuron:public Soma{ // 继承自Soma类，提供神经元的基本功能
     friend class Layer;                                      // 允许Layer类访问私有成员
@@ -52,6 +59,7 @@ public:
     void connectTo(Neuron* other, double weight = 1.0);     // 将当前神经元连接到另一个神经元
     void disconnectTo(Neuron* other);                      // 断开与另一个神经元的连接
     std::vector<double> getWeights() const;                // 获取当前神经元的树突权重
+    const std::vector<Synapse*>& getDendrites() const;     // 获取当前神经元的树突列表
     void setWeights(const std::vector<double>& weights);   // 设置当前神经元的树突权重
     void setWeight(int index, double weight);              // 设置特定树突的权重
     void setLayer(Layer* newLayer);                        // 设置所属层
@@ -59,6 +67,8 @@ public:
     void showConnections() const;                          // 显示当前神经元的连接信息
     int getDendriteCount() const;                           // 获取当前神经元的树突数量
     int getAxonCount() const;                               // 获取当前神经元的轴突数量
+    size_t getDendriteCapacity() const;                     // 获取树突列表已分配的容量
+    size_t getAxonCapacity() const;                         // 获取轴突列表已分配的容量
     void setBias(double newBias);                          // 设置当前神经元的偏置
     void remove();                                         // 移除当前神经元
     void cleanInvalidSynapses(const std::vector<Neuron*>& invalidNeurons); // 清理无效的突触连接
@@ -0,0 +1,188 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ParallelTrainer.cpp
+//【功能模块和目的】多进程数据并行训练器类的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "ParallelTrainer.hpp" // 数据并行训练器类头文件
+#include <algorithm>           // 算法库
+#include <iostream>            // 输入输出流头文件
+#include <stdexcept>           // 标准异常头文件
+
+#ifdef __linux__
+#include <signal.h>    // kill
+#include <sys/wait.h>  // waitpid
+#include <unistd.h>    // fork、_exit、usleep
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ParallelTrainer::ParallelTrainer
+//【函数功能】ParallelTrainer类的构造函数，设置工作进程数量和全归约算法
+//【参数】workerCount - 工作进程数量，algorithm - 梯度全归约算法
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ParallelTrainer::ParallelTrainer(int workerCount, AllreduceAlgorithm algorithm)
+    : workerCount(workerCount)
+    , algorithm(algorithm)
+{
+    if (workerCount <= 0) {
+        std::cerr << "Error: Worker count must be positive.\n";
+        throw std::invalid_argument("Worker count must be positive.");
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ParallelTrainer::getWorkerCount
+//【函数功能】获取工作进程数量
+//【参数】无
+//【返回值】int - 工作进程数量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int ParallelTrainer::getWorkerCount() const {
+    return workerCount;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ParallelTrainer::runWorker
+//【函数功能】工作进程的训练循环。每个全局小批量中只计算本进程分片内样本的梯度之和，
+//        与损失一起全归约后，用全局平均梯度更新参数。训练结束后0号进程把参数和
+//        最后一轮平均损失写入0号数据槽，交给父进程读取
+//【参数】rank - 工作进程编号，trainer - 本进程的训练器副本，allreduce - 共享内存全归约，
+//        inputs - 输入样本，targets - 目标样本，options - 训练超参数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void ParallelTrainer::runWorker(int rank, Trainer& trainer, SharedMemoryAllreduce& allreduce,
+                                const std::vector<std::vector<double>>& inputs,
+                                const std::vector<std::vector<double>>& targets,
+                                const TrainingOptions& options) const {
+    const int parameterCount = trainer.getParameterCount();
+    const int sampleCount = static_cast<int>(inputs.size());
+    std::vector<double> gradient(parameterCount + 1); // 最后一个元素携带损失，与梯度一同归约
+    std::vector<int> indices;
+    double epochLoss = 0.0;
+    for (int epoch = 0; epoch < options.epochs; ++epoch) {
+        epochLoss = 0.0;
+        for (int begin = 0; begin < sampleCount; begin += options.batchSize) {
+            int end = std::min(begin + options.batchSize, sampleCount);
+            indices.clear();
+            for (int i = begin + rank; i < end; i += workerCount) {
+                indices.push_back(i);
+            }
+            std::fill(gradient.begin(), gradient.end(), 0.0);
+            gradient[parameterCount] = trainer.computeBatchGradient(inputs, targets, indices, gradient);
+            allreduce.allreduce(rank, gradient);
+            epochLoss += gradient[parameterCount];
+            trainer.applyGradient(gradient, -options.learningRate / (end - begin));
+        }
+    }
+    if (rank == 0) {
+        double* result = allreduce.getSlot(0);
+        std::copy(trainer.getParameters().begin(), trainer.getParameters().end(), result);
+        result[parameterCount] = sampleCount > 0 ? epochLoss / sampleCount : 0.0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ParallelTrainer::train
+//【函数功能】创建共享内存后fork出各工作进程执行训练，父进程等待全部退出；任一进程失败时
+//        终止其余进程并抛出异常。成功后读取0号进程回传的参数并写回网络
+//【参数】network - 待训练的网络，inputs - 输入样本，targets - 目标样本，options - 训练超参数
+//【返回值】double - 最后一轮的平均损失
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 工作进程沿用options中的梯度检查点间隔
+//-------------------------------------------------------------------------------------------------------------------
+double ParallelTrainer::train(Network& network,
+                              const std::vector<std::vector<double>>& inputs,
+                              const std::vector<std::vector<double>>& targets,
+                              const TrainingOptions& options) {
+#ifdef __linux__
+    Trainer trainer(network);
+    trainer.validateSamples(inputs, targets);
+    if (options.batchSize <= 0 || options.epochs < 0) {
+        std::cerr << "Error: Invalid training options.\n";
+        throw std::invalid_argument("Invalid training options.");
+    }
+    trainer.setCheckpointInterval(options.checkpointInterval);
+    const int parameterCount = trainer.getParameterCount();
+    SharedMemoryAllreduce allreduce(workerCount, parameterCount + 1, algorithm);
+
+    std::cout.flush(); // 避免子进程重复输出父进程缓冲区中的内容
+    std::cerr.flush();
+    std::vector<pid_t> workers;
+    for (int rank = 0; rank < workerCount; ++rank) {
+        pid_t pid = fork();
+        if (pid == 0) {// 工作进程：训练后直接_exit，不执行父进程对象的析构
+            int status = 0;
+            try {
+                runWorker(rank, trainer, allreduce, inputs, targets, options);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Training worker " << rank << " failed: " << e.what() << std::endl;
+                status = 1;
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            _exit(status);
+        }
+        if (pid < 0) {// fork失败，终止已启动的工作进程
+            for (pid_t worker : workers) {
+                kill(worker, SIGKILL);
+                waitpid(worker, nullptr, 0);
+            }
+            std::cerr << "Error: Failed to fork training worker " << rank << ".\n";
+            throw std::runtime_error("Failed to fork training worker.");
+        }
+        workers.push_back(pid);
+    }
+
+    // 轮询等待工作进程；任一进程异常退出时其余进程会阻塞在屏障上，需要将其终止
+    bool failed = false;
+    std::vector<bool> finished(workers.size(), false);
+    size_t remaining = workers.size();
+    while (remaining > 0) {
+        for (size_t i = 0; i < workers.size(); ++i) {
+            int status = 0;
+            if (!finished[i] && waitpid(workers[i], &status, WNOHANG) == workers[i]) {
+                finished[i] = true;
+                --remaining;
+                if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                    failed = true;
+                }
+            }
+        }
+        if (failed) {
+            for (size_t i = 0; i < workers.size(); ++i) {
+                if (!finished[i]) {
+                    kill(workers[i], SIGKILL);
+                    waitpid(workers[i], nullptr, 0);
+                    finished[i] = true;
+                }
+            }
+            remaining = 0;
+        } else if (remaining > 0) {
+            usleep(1000);
+        }
+    }
+    if (failed) {
+        std::cerr << "Error: Data-parallel training failed.\n";
+        throw std::runtime_error("Data-parallel training failed.");
+    }
+
+    const double* result = allreduce.getSlot(0);
+    trainer.setParameters(std::vector<double>(result, result + parameterCount));
+    trainer.applyTo(network);
+    return result[parameterCount];
+#else
+    (void)network;
+    (void)inputs;
+    (void)targets;
+    (void)options;
+    std::cerr << "Error: Data-parallel training is only supported on Linux.\n";
+    throw std::runtime_error("Data-parallel training is only supported on Linux.");
+#endif
+}
@@ -0,0 +1,46 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ParallelTrainer.hpp
+//【功能模块和目的】多进程数据并行训练器类的声明，在单台Linux主机上启动多个工作进程并经共享内存合并梯度
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef PARALLEL_TRAINER_HPP
+#define PARALLEL_TRAINER_HPP
+
+#include "Trainer.hpp"               // 训练器类头文件
+#include "SharedMemoryAllreduce.hpp" // 共享内存全归约类头文件
+#include <vector>                    // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ParallelTrainer
+//【功能】数据并行训练：fork出workerCount个工作进程，每个进程拥有独立的地址空间和分配器。
+//        每个全局小批量中第k个样本由 k % workerCount 号进程负责（即各进程固定持有数据集的一个分片），
+//        各进程计算本地梯度之和后经SharedMemoryAllreduce求和，再各自执行相同的参数更新，
+//        因此与相同批大小的单进程Trainer::train在浮点求和顺序误差内得到同一模型
+//【接口说明】
+//  - explicit ParallelTrainer(int workerCount, AllreduceAlgorithm algorithm): 构造函数
+//  - double train(Network& network, ...): 训练并把结果写回network，返回最后一轮的平均损失
+//  - int getWorkerCount() const: 获取工作进程数量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class ParallelTrainer {
+public:
+    explicit ParallelTrainer(int workerCount, AllreduceAlgorithm algorithm = AllreduceAlgorithm::RING); // 构造函数
+    double train(Network& network,
+                 const std::vector<std::vector<double>>& inputs,
+                 const std::vector<std::vector<double>>& targets,
+                 const TrainingOptions& options);        // 数据并行训练
+    int getWorkerCount() const;                          // 获取工作进程数量
+
+private:
+    void runWorker(int rank, Trainer& trainer, SharedMemoryAllreduce& allreduce,
+                   const std::vector<std::vector<double>>& inputs,
+                   const std::vector<std::vector<double>>& targets,
+                   const TrainingOptions& options) const; // 工作进程的训练循环
+    int workerCount;                                     // 工作进程数量
+    AllreduceAlgorithm algorithm;                        // 梯度全归约算法
+};
+
+#endif // PARALLEL_TRAINER_HPP
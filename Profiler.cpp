@@ -0,0 +1,391 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Profiler.cpp
+//【功能模块和目的】前向传播分层计时的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 record改为经线程局部缓存直接累加本线程的计数，不再加锁和查哈希表
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "Profiler.hpp" // 计时类头文件
+#include "Network.hpp"  // 网络类头文件
+#include <atomic>       // 原子变量
+#include <chrono>       // 计时
+#include <cstdint>      // uintptr_t
+#include <deque>        // 双端队列，扩充时不移动已有元素
+#include <memory>       // 智能指针
+#include <mutex>        // 互斥锁
+#include <thread>       // std::this_thread
+#include <unordered_map> // 哈希表
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#endif
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】CounterSlot
+//【功能】一个线程中一个被测对象的计数。只有所属线程写入（读出加一再写回，不需要加锁前缀的原子操作），
+//        查询线程以relaxed读取，因此只需保证单个字段不被撕裂
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct CounterSlot {
+    std::atomic<long long> calls{ 0 };          // 调用次数
+    std::atomic<unsigned long long> ticks{ 0 }; // 累计时钟周期数
+    std::atomic<long long> synapses{ 0 };       // 累计处理的突触数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ThreadCounters
+//【功能】一个线程的计数表，第i个元素为编号为i的被测对象的计数。锁只保护表的扩充和查询时的遍历，
+//        record命中缓存时不加锁
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 由按地址的哈希表改为按编号的计数数组
+//-------------------------------------------------------------------------------------------------------------------
+struct ThreadCounters {
+    std::mutex mutex;              // 保护slots的扩充
+    std::deque<CounterSlot> slots; // 各编号的计数，扩充时已有元素的地址不变
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】CacheEntry
+//【功能】线程局部缓存的一项：被测对象及其在本线程计数表中的计数，key为空表示空位
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct CacheEntry {
+    const void* key = nullptr;   // 被测对象
+    CounterSlot* slot = nullptr; // 本线程中的计数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】LocalCache
+//【功能】线程局部的开放寻址表（线性探测），从被测对象映射到本线程的计数。只由所属线程访问，不加锁；
+//        项数不超过容量的一半，容量为2的幂。generation与全局代数不同时整表作废
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct LocalCache {
+    unsigned generation = 0;         // 建表时的全局代数
+    size_t used = 0;                 // 已用项数
+    std::vector<CacheEntry> entries; // 各项
+};
+
+const size_t CACHE_INITIAL_SIZE = 64; // 线程局部缓存的初始容量
+
+std::mutex registryMutex;                                // 保护registry、slotIndices和freeSlots
+std::vector<std::shared_ptr<ThreadCounters>> registry;   // 所有线程的计数表，线程结束后仍保留
+std::unordered_map<const void*, size_t> slotIndices;     // 被测对象的编号，首次记录时分配
+std::vector<size_t> freeSlots;                           // forget后可重新分配的编号
+size_t slotCount = 0;                                    // 已分配过的最大编号+1
+std::atomic<unsigned> generation(1);                     // forget时加一，使各线程的缓存作废
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】cacheIndex
+//【函数功能】计算key在容量为mask+1的缓存中的起始位置。对象地址的低位多为对齐产生的0，
+//           乘以黄金分割常数后取高位，使相邻对象分散
+//【参数】key - 被测对象，mask - 容量-1
+//【返回值】size_t - 起始位置
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t cacheIndex(const void* key, size_t mask) {
+    const unsigned long long address = static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(key));
+    return static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】insertEntry
+//【函数功能】把一项插入缓存，项数超过容量的一半时先把容量加倍并重新插入已有各项
+//【参数】cache - 缓存，key - 被测对象，slot - 本线程中的计数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void insertEntry(LocalCache& cache, const void* key, CounterSlot* slot) {
+    if ((cache.used + 1) * 2 > cache.entries.size()) {
+        std::vector<CacheEntry> old;
+        old.swap(cache.entries);
+        cache.entries.resize(old.empty() ? CACHE_INITIAL_SIZE : old.size() * 2);
+        cache.used = 0;
+        for (const CacheEntry& entry : old) {
+            if (entry.key != nullptr) {
+                insertEntry(cache, entry.key, entry.slot);
+            }
+        }
+    }
+    const size_t mask = cache.entries.size() - 1;
+    size_t index = cacheIndex(key, mask);
+    while (cache.entries[index].key != nullptr) {
+        index = (index + 1) & mask;
+    }
+    cache.entries[index].key = key;
+    cache.entries[index].slot = slot;
+    ++cache.used;
+}
+
+ThreadCounters& localCounters() {
+    thread_local std::shared_ptr<ThreadCounters> local;
+    if (!local) {
+        local = std::make_shared<ThreadCounters>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.push_back(local);
+    }
+    return *local;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】lookupSlot
+//【函数功能】缓存未命中时取得key在当前线程的计数：在登记表中取得或分配key的编号，必要时扩充本线程的计数表
+//【参数】key - 被测对象
+//【返回值】CounterSlot* - 本线程中key的计数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CounterSlot* lookupSlot(const void* key) {
+    ThreadCounters& local = localCounters();
+    size_t index = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = slotIndices.find(key);
+        if (it != slotIndices.end()) {
+            index = it->second;
+        } else {
+            if (!freeSlots.empty()) {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            } else {
+                index = slotCount++;
+            }
+            slotIndices[key] = index;
+        }
+    }
+    std::lock_guard<std::mutex> lock(local.mutex);
+    if (local.slots.size() <= index) {
+        local.slots.resize(index + 1);
+    }
+    return &local.slots[index];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】clearSlot
+//【函数功能】把一个计数清零，调用方持有其所属线程计数表的锁
+//【参数】slot - 计数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void clearSlot(CounterSlot& slot) {
+    slot.calls.store(0, std::memory_order_relaxed);
+    slot.ticks.store(0, std::memory_order_relaxed);
+    slot.synapses.store(0, std::memory_order_relaxed);
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::isEnabled
+//【函数功能】判断编译时是否定义了CANN_PROFILE
+//【参数】无
+//【返回值】bool - 是否启用计时
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+bool Profiler::isEnabled() {
+#ifdef CANN_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::readTicks
+//【函数功能】读取时钟周期：x86上为时间戳计数器，其他平台为steady_clock的纳秒数
+//【参数】无
+//【返回值】unsigned long long - 时钟周期
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+unsigned long long Profiler::readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::getTicksPerSecond
+//【函数功能】获取每秒时钟周期数。x86上首次调用时用20毫秒对照steady_clock校准一次（现代CPU的
+//           时间戳计数器频率恒定，与睿频无关）
+//【参数】无
+//【返回值】double - 每秒时钟周期数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double Profiler::getTicksPerSecond() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double ticksPerSecond = []() {
+        auto startTime = std::chrono::steady_clock::now();
+        unsigned long long startTicks = readTicks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        unsigned long long endTicks = readTicks();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return static_cast<double>(endTicks - startTicks) / seconds;
+    }();
+    return ticksPerSecond;
+#else
+    return 1e9;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::record
+//【函数功能】把一次调用累加到当前线程的计数。按key的地址在线程局部缓存中找到本线程的计数，
+//           命中时不加锁、不访问共享的登记表，只做三次relaxed读写；未命中（每个线程每个key首次记录，
+//           或任一对象forget之后）才经lookupSlot加锁取得
+//【参数】key - 被测对象，ticks - 本次耗时的时钟周期数，synapses - 本次处理的突触数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为经线程局部缓存直接累加，不再加锁
+//-------------------------------------------------------------------------------------------------------------------
+void Profiler::record(const void* key, unsigned long long ticks, long long synapses) {
+    thread_local LocalCache cache;
+    const unsigned current = generation.load(std::memory_order_relaxed);
+    if (cache.generation != current) {
+        cache.entries.assign(cache.entries.size(), CacheEntry());
+        cache.used = 0;
+        cache.generation = current;
+    }
+    CounterSlot* found = nullptr;
+    if (!cache.entries.empty()) {
+        const size_t mask = cache.entries.size() - 1;
+        for (size_t index = cacheIndex(key, mask); cache.entries[index].key != nullptr; index = (index + 1) & mask) {
+            if (cache.entries[index].key == key) {
+                found = cache.entries[index].slot;
+                break;
+            }
+        }
+    }
+    if (found == nullptr) {
+        found = lookupSlot(key);
+        insertEntry(cache, key, found);
+    }
+    CounterSlot& slot = *found;
+    slot.calls.store(slot.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot.ticks.store(slot.ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+    slot.synapses.store(slot.synapses.load(std::memory_order_relaxed) + synapses, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::getCounters
+//【函数功能】汇总所有线程中key的计数。与record并发时读到的是各字段某一时刻的值
+//【参数】key - 被测对象
+//【返回值】ProfileCounters - 汇总的计数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 按编号读取各线程的计数
+//-------------------------------------------------------------------------------------------------------------------
+ProfileCounters Profiler::getCounters(const void* key) {
+    ProfileCounters total;
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    auto it = slotIndices.find(key);
+    if (it == slotIndices.end()) {
+        return total;
+    }
+    const size_t index = it->second;
+    for (const auto& thread : registry) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        if (index < thread->slots.size()) {
+            const CounterSlot& slot = thread->slots[index];
+            total.calls += slot.calls.load(std::memory_order_relaxed);
+            total.ticks += slot.ticks.load(std::memory_order_relaxed);
+            total.synapses += slot.synapses.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::getNetworkProfile
+//【函数功能】获取网络forward的计时结果和各层updateOutputs的计时结果
+//【参数】network - 网络
+//【返回值】NetworkProfile - 计时结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+NetworkProfile Profiler::getNetworkProfile(const Network& network) {
+    NetworkProfile profile;
+    profile.enabled = isEnabled();
+    const double ticksPerSecond = getTicksPerSecond();
+    ProfileCounters forward = getCounters(&network);
+    profile.forwardCalls = forward.calls;
+    profile.forwardSeconds = forward.ticks / ticksPerSecond;
+    profile.forwardsPerSecond = profile.forwardSeconds > 0.0 ? forward.calls / profile.forwardSeconds : 0.0;
+    int index = 0;
+    for (const Layer* layer : network.getLayers()) {
+        ProfileCounters counters = getCounters(layer);
+        LayerProfile layerProfile;
+        layerProfile.index = index++;
+        layerProfile.neuronCount = layer->getNeuronCount();
+        layerProfile.calls = counters.calls;
+        layerProfile.seconds = counters.ticks / ticksPerSecond;
+        layerProfile.synapses = counters.synapses;
+        if (layerProfile.seconds > 0.0) {
+            layerProfile.callsPerSecond = counters.calls / layerProfile.seconds;
+            layerProfile.synapsesPerSecond = counters.synapses / layerProfile.seconds;
+        }
+        if (profile.forwardSeconds > 0.0) {
+            layerProfile.share = layerProfile.seconds / profile.forwardSeconds;
+        }
+        profile.layers.push_back(layerProfile);
+    }
+    return profile;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::reset
+//【函数功能】清空所有线程的计数，编号保持不变。应在没有前向传播进行时调用，
+//           否则与之并发的一次记录可能覆盖清零
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为把各线程的计数清零
+//-------------------------------------------------------------------------------------------------------------------
+void Profiler::reset() {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    for (const auto& thread : registry) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        for (CounterSlot& slot : thread->slots) {
+            clearSlot(slot);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Profiler::forget
+//【函数功能】删除所有线程中key的计数并回收其编号，同时使各线程缓存的旧项失效，
+//           地址被新对象复用后不会沿用旧计数。调用时key不得正在被记录（对象析构时满足）
+//【参数】key - 被测对象
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 改为清零并回收编号，使线程局部缓存失效
+//-------------------------------------------------------------------------------------------------------------------
+void Profiler::forget(const void* key) {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    auto it = slotIndices.find(key);
+    if (it == slotIndices.end()) {
+        return;
+    }
+    const size_t index = it->second;
+    for (const auto& thread : registry) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        if (index < thread->slots.size()) {
+            clearSlot(thread->slots[index]);
+        }
+    }
+    slotIndices.erase(it);
+    freeSlots.push_back(index);
+    generation.fetch_add(1);
+}
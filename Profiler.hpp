@@ -0,0 +1,121 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Profiler.hpp
+//【功能模块和目的】前向传播热路径的分层计时。定义CANN_PROFILE编译时，Network::forward和Layer::updateOutputs
+//                  把每次调用的时钟周期数和处理的突触数累加到线程局部计数器；未定义时CANN_PROFILE_SCOPE
+//                  展开为空语句，热路径上没有任何额外代码，查询接口返回全零结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 记录时不再加锁
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <vector> // vector所属头文件
+
+class Network;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ProfileCounters
+//【功能】一个被测对象（层或网络）的累计计数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ProfileCounters {
+    long long calls = 0;          // 调用次数
+    unsigned long long ticks = 0; // 累计时钟周期数
+    long long synapses = 0;       // 累计处理的突触数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】LayerProfile
+//【功能】一层的计时结果。share为本层耗时占前向传播总耗时的比例
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct LayerProfile {
+    int index = 0;                  // 层索引
+    int neuronCount = 0;            // 神经元数量
+    long long calls = 0;            // updateOutputs调用次数
+    double seconds = 0.0;           // 累计耗时
+    long long synapses = 0;         // 累计处理的突触数
+    double callsPerSecond = 0.0;    // 每秒调用次数（按本层耗时计）
+    double synapsesPerSecond = 0.0; // 每秒处理的突触数
+    double share = 0.0;             // 占前向传播总耗时的比例
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】NetworkProfile
+//【功能】一个网络的计时结果。enabled为false时程序编译时未定义CANN_PROFILE，其余字段均为0
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct NetworkProfile {
+    bool enabled = false;              // 是否编译了计时
+    long long forwardCalls = 0;        // forward调用次数
+    double forwardSeconds = 0.0;       // forward累计耗时
+    double forwardsPerSecond = 0.0;    // 每秒forward次数
+    std::vector<LayerProfile> layers;  // 各层结果
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】Profiler
+//【功能】计时计数器的记录与查询。每个被测对象首次记录时分配一个编号，每个线程按编号写自己的计数，
+//        并在线程局部缓存中记住各对象对应的计数，因此记录时不加锁、不查哈希表，只有查询、清空和删除时加锁。
+//        x86上用RDTSC读取时钟周期，首次查询时对照steady_clock校准频率；其他平台使用纳秒
+//【接口说明】
+//  - static bool isEnabled(): 编译时是否定义了CANN_PROFILE
+//  - static unsigned long long readTicks(): 读取时钟周期
+//  - static double getTicksPerSecond(): 每秒时钟周期数
+//  - static void record(const void* key, unsigned long long ticks, long long synapses): 记录一次调用
+//  - static ProfileCounters getCounters(const void* key): 汇总所有线程中key的计数
+//  - static NetworkProfile getNetworkProfile(const Network& network): 获取网络及其各层的计时结果
+//  - static void reset(): 清空所有计数，应在没有前向传播进行时调用
+//  - static void forget(const void* key): 删除key的计数并回收其编号（对象析构时调用，避免地址复用后计数混在一起）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 按编号记录，记录时不加锁
+//-------------------------------------------------------------------------------------------------------------------
+class Profiler {
+public:
+    static bool isEnabled();
+    static unsigned long long readTicks();
+    static double getTicksPerSecond();
+    static void record(const void* key, unsigned long long ticks, long long synapses);
+    static ProfileCounters getCounters(const void* key);
+    static NetworkProfile getNetworkProfile(const Network& network);
+    static void reset();
+    static void forget(const void* key);
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ProfileScope
+//【功能】在构造和析构之间计时，析构时把结果记录到key名下
+//【接口说明】
+//  - ProfileScope(const void* key, long long synapses): 构造函数，开始计时
+//  - ~ProfileScope(): 析构函数，结束计时并记录
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class ProfileScope {
+public:
+    ProfileScope(const void* key, long long synapses)
+        : key(key), synapses(synapses), start(Profiler::readTicks()) {}
+    ~ProfileScope() { Profiler::record(key, Profiler::readTicks() - start, synapses); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const void* key;          // 被测对象
+    long long synapses;       // 本次处理的突触数
+    unsigned long long start; // 开始时的时钟周期
+};
+
+// 在当前作用域内计时；未定义CANN_PROFILE时不求值任何参数
+#ifdef CANN_PROFILE
+#define CANN_PROFILE_SCOPE(key, synapses) ProfileScope cannProfileScope((key), (synapses))
+#define CANN_PROFILE_FORGET(key) Profiler::forget(key)
+#else
+#define CANN_PROFILE_SCOPE(key, synapses) ((void)0)
+#define CANN_PROFILE_FORGET(key) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
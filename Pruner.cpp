@@ -0,0 +1,300 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Pruner.cpp
+//【功能模块和目的】剪枝器类的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 evaluate的加速比改为剪枝前后同一CSR内核的比较
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "Pruner.hpp" // 剪枝器类头文件
+#include <algorithm>  // 算法库
+#include <chrono>     // 计时
+#include <cmath>      // 数学函数库
+#include <iostream>   // 输入输出流头文件
+#include <stdexcept>  // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::Pruner
+//【函数功能】Pruner类的构造函数，编译待剪枝的网络
+//【参数】network - 待剪枝的网络
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+Pruner::Pruner(Network& network)
+    : network(network)
+    , compiled(network)
+{}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::filterLayer
+//【函数功能】按标记复制一层，只保留keep为true的突触，偏置和激活函数不变
+//【参数】layer - 原层，keep - 每个突触是否保留
+//【返回值】CompiledLayer - 剪枝后的层
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CompiledLayer Pruner::filterLayer(const CompiledLayer& layer, const std::vector<bool>& keep) {
+    CompiledLayer result;
+    result.biases = layer.biases;
+    result.activationTypes = layer.activationTypes;
+    if (layer.rowOffsets.empty()) {
+        return result;
+    }
+    result.rowOffsets.push_back(0);
+    for (int i = 0; i < layer.getNeuronCount(); ++i) {
+        for (int k = layer.rowOffsets[i]; k < layer.rowOffsets[i + 1]; ++k) {
+            if (keep[k]) {
+                result.columnIndices.push_back(layer.columnIndices[k]);
+                result.values.push_back(layer.values[k]);
+            }
+        }
+        result.rowOffsets.push_back(static_cast<int>(result.values.size()));
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::pruneByThreshold
+//【函数功能】删除绝对值小于阈值的突触
+//【参数】threshold - 权重绝对值阈值
+//【返回值】CompiledNetwork - 剪枝后的稀疏网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork Pruner::pruneByThreshold(double threshold) const {
+    if (threshold < 0.0) {
+        std::cerr << "Error: Pruning threshold cannot be negative.\n";
+        throw std::invalid_argument("Pruning threshold cannot be negative.");
+    }
+    CompiledNetwork result;
+    result.setName(compiled.getName());
+    for (int l = 0; l < compiled.getLayerCount(); ++l) {
+        const CompiledLayer& layer = compiled.getLayer(l);
+        std::vector<bool> keep(layer.values.size());
+        for (size_t k = 0; k < layer.values.size(); ++k) {
+            keep[k] = std::fabs(layer.values[k]) >= threshold;
+        }
+        result.addLayer(filterLayer(layer, keep));
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::pruneTopKPerNeuron
+//【函数功能】每个神经元只保留绝对值最大的keepCount个输入突触，绝对值相同时保留下标较小者
+//【参数】keepCount - 每个神经元保留的突触数量
+//【返回值】CompiledNetwork - 剪枝后的稀疏网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork Pruner::pruneTopKPerNeuron(int keepCount) const {
+    if (keepCount < 0) {
+        std::cerr << "Error: Keep count cannot be negative.\n";
+        throw std::invalid_argument("Keep count cannot be negative.");
+    }
+    CompiledNetwork result;
+    result.setName(compiled.getName());
+    for (int l = 0; l < compiled.getLayerCount(); ++l) {
+        const CompiledLayer& layer = compiled.getLayer(l);
+        std::vector<bool> keep(layer.values.size(), false);
+        std::vector<int> order;
+        for (int i = 0; i + 1 < static_cast<int>(layer.rowOffsets.size()); ++i) {
+            order.clear();
+            for (int k = layer.rowOffsets[i]; k < layer.rowOffsets[i + 1]; ++k) {
+                order.push_back(k);
+            }
+            int count = std::min(keepCount, static_cast<int>(order.size()));
+            std::partial_sort(order.begin(), order.begin() + count, order.end(), [&layer](int a, int b) {
+                double x = std::fabs(layer.values[a]), y = std::fabs(layer.values[b]);
+                return x > y || (x == y && a < b);
+            });
+            for (int k = 0; k < count; ++k) {
+                keep[order[k]] = true;
+            }
+        }
+        result.addLayer(filterLayer(layer, keep));
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::pruneTopKPerLayer
+//【函数功能】每层只保留绝对值最大的keepCount个突触，绝对值相同时保留下标较小者
+//【参数】keepCount - 每层保留的突触数量
+//【返回值】CompiledNetwork - 剪枝后的稀疏网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork Pruner::pruneTopKPerLayer(int keepCount) const {
+    if (keepCount < 0) {
+        std::cerr << "Error: Keep count cannot be negative.\n";
+        throw std::invalid_argument("Keep count cannot be negative.");
+    }
+    CompiledNetwork result;
+    result.setName(compiled.getName());
+    for (int l = 0; l < compiled.getLayerCount(); ++l) {
+        const CompiledLayer& layer = compiled.getLayer(l);
+        std::vector<int> order(layer.values.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+            order[k] = static_cast<int>(k);
+        }
+        int count = std::min(keepCount, static_cast<int>(order.size()));
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), [&layer](int a, int b) {
+            double x = std::fabs(layer.values[a]), y = std::fabs(layer.values[b]);
+            return x > y || (x == y && a < b);
+        });
+        std::vector<bool> keep(layer.values.size(), false);
+        for (int k = 0; k < count; ++k) {
+            keep[order[k]] = true;
+        }
+        result.addLayer(filterLayer(layer, keep));
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::measureLoss
+//【函数功能】计算一组输出相对目标的平均损失 0.5*||y-t||² 和最大值下标准确率
+//【参数】outputs - 网络输出，targets - 目标值，accuracy - 输出准确率
+//【返回值】double - 平均损失
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double Pruner::measureLoss(const std::vector<std::vector<double>>& outputs,
+                           const std::vector<std::vector<double>>& targets,
+                           double& accuracy) {
+    double loss = 0.0;
+    size_t correct = 0;
+    for (size_t s = 0; s < outputs.size(); ++s) {
+        for (size_t i = 0; i < outputs[s].size(); ++i) {
+            double diff = outputs[s][i] - targets[s][i];
+            loss += 0.5 * diff * diff;
+        }
+        if (std::max_element(outputs[s].begin(), outputs[s].end()) - outputs[s].begin() ==
+            std::max_element(targets[s].begin(), targets[s].end()) - targets[s].begin()) {
+            ++correct;
+        }
+    }
+    accuracy = outputs.empty() ? 0.0 : static_cast<double>(correct) / outputs.size();
+    return outputs.empty() ? 0.0 : loss / outputs.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::evaluate
+//【函数功能】在验证集上分别用未剪枝和剪枝后的CompiledNetwork::forward逐样本推理，比较损失、准确率和耗时，
+//        两边使用同一CSR内核，加速比只反映剪枝本身；另外记录原网络Network::forward（对象图）的耗时供参考
+//【参数】pruned - 剪枝后的网络，inputs - 验证输入，targets - 验证目标，
+//        repeats - 计时时重复遍历验证集的次数
+//【返回值】PruningReport - 剪枝报告
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 基线改为未剪枝的compiled，对象图耗时单独记录为graphSeconds
+//-------------------------------------------------------------------------------------------------------------------
+PruningReport Pruner::evaluate(const CompiledNetwork& pruned,
+                               const std::vector<std::vector<double>>& inputs,
+                               const std::vector<std::vector<double>>& targets,
+                               int repeats) const {
+    if (inputs.size() != targets.size() || inputs.empty()) {
+        std::cerr << "Error: Validation inputs and targets must be non-empty and of the same count.\n";
+        throw std::invalid_argument("Validation inputs and targets must be non-empty and of the same count.");
+    }
+    for (const auto& target : targets) {
+        if (static_cast<int>(target.size()) != compiled.getOutputSize()) {
+            std::cerr << "Error: Target size does not match the network output size.\n";
+            throw std::invalid_argument("Target size does not match the network output size.");
+        }
+    }
+    if (repeats <= 0) {
+        std::cerr << "Error: Repeat count must be positive.\n";
+        throw std::invalid_argument("Repeat count must be positive.");
+    }
+    PruningReport report;
+    report.denseSynapseCount = compiled.getSynapseCount();
+    report.keptSynapseCount = pruned.getSynapseCount();
+    report.sparsity = report.denseSynapseCount == 0 ? 0.0 :
+        1.0 - static_cast<double>(report.keptSynapseCount) / report.denseSynapseCount;
+
+    std::vector<std::vector<double>> denseOutputs(inputs.size());
+    std::vector<std::vector<double>> sparseOutputs(inputs.size());
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t s = 0; s < inputs.size(); ++s) {
+            denseOutputs[s] = compiled.forward(inputs[s]).back();
+        }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t s = 0; s < inputs.size(); ++s) {
+            sparseOutputs[s] = pruned.forward(inputs[s]).back();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t s = 0; s < inputs.size(); ++s) {
+            network.forward(inputs[s]);
+        }
+    }
+    auto graphEnd = std::chrono::steady_clock::now();
+    report.denseSeconds = std::chrono::duration<double>(middle - start).count();
+    report.sparseSeconds = std::chrono::duration<double>(end - middle).count();
+    report.graphSeconds = std::chrono::duration<double>(graphEnd - end).count();
+    report.speedup = report.sparseSeconds > 0.0 ? report.denseSeconds / report.sparseSeconds : 0.0;
+
+    report.baselineLoss = measureLoss(denseOutputs, targets, report.baselineAccuracy);
+    report.prunedLoss = measureLoss(sparseOutputs, targets, report.prunedAccuracy);
+    report.lossDelta = report.prunedLoss - report.baselineLoss;
+    report.accuracyDelta = report.prunedAccuracy - report.baselineAccuracy;
+    return report;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Pruner::pruneIteratively
+//【函数功能】迭代剪枝：按权重绝对值排序，每轮把全局稀疏度提高sparsityStep，取对应分位数作为阈值剪枝，
+//        并在验证集上测量损失；损失相对原网络的增加量超过maxLossIncrease时停止，
+//        返回最后一个满足条件的网络，并填写其剪枝报告
+//【参数】inputs - 验证输入，targets - 验证目标，maxLossIncrease - 允许的平均损失增加量，
+//        sparsityStep - 每轮增加的稀疏度（0, 1]，report - 输出剪枝报告
+//【返回值】CompiledNetwork - 满足精度约束的最稀疏网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+CompiledNetwork Pruner::pruneIteratively(const std::vector<std::vector<double>>& inputs,
+                                         const std::vector<std::vector<double>>& targets,
+                                         double maxLossIncrease,
+                                         double sparsityStep,
+                                         PruningReport& report) const {
+    if (sparsityStep <= 0.0 || sparsityStep > 1.0 || maxLossIncrease < 0.0) {
+        std::cerr << "Error: Invalid iterative pruning options.\n";
+        throw std::invalid_argument("Invalid iterative pruning options.");
+    }
+    report = evaluate(compiled, inputs, targets);
+    const double lossLimit = report.baselineLoss + maxLossIncrease;
+
+    std::vector<double> magnitudes;
+    for (int l = 0; l < compiled.getLayerCount(); ++l) {
+        for (double value : compiled.getLayer(l).values) {
+            magnitudes.push_back(std::fabs(value));
+        }
+    }
+    std::sort(magnitudes.begin(), magnitudes.end());
+
+    CompiledNetwork best = compiled;
+    double bestThreshold = 0.0;
+    double accuracy = 0.0;
+    for (int step = 1; step * sparsityStep <= 1.0 + 1e-12; ++step) {
+        size_t removeCount = static_cast<size_t>(std::min(1.0, step * sparsityStep) * magnitudes.size());
+        double threshold = removeCount >= magnitudes.size() ?
+            std::nextafter(magnitudes.empty() ? 0.0 : magnitudes.back(), HUGE_VAL) : magnitudes[removeCount];
+        if (threshold <= bestThreshold) {
+            continue; // 大量相同的权重使阈值没有变化
+        }
+        CompiledNetwork candidate = pruneByThreshold(threshold);
+        if (measureLoss(candidate.forwardBatch(inputs), targets, accuracy) > lossLimit) {
+            break;
+        }
+        best = candidate;
+        bestThreshold = threshold;
+    }
+    report = evaluate(best, inputs, targets);
+    report.threshold = bestThreshold;
+    return best;
+}
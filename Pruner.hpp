@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Pruner.hpp
+//【功能模块和目的】剪枝器类的声明，按权重绝对值剪除突触并输出CSR稀疏网络，同时给出加速比和精度变化报告
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 加速比改为同一CSR内核下剪枝前后的比较，对象图耗时单独报告
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef PRUNER_HPP
+#define PRUNER_HPP
+
+#include "CompiledNetwork.hpp" // 紧凑推理网络类头文件
+#include "Network.hpp"         // 网络类头文件
+#include <cstddef>             // size_t所属头文件
+#include <vector>              // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】PruningReport
+//【功能】剪枝结果报告：保留的突触数量、稀疏度，剪枝前后在验证集上的损失与准确率，以及推理耗时和加速比
+//        损失为每个样本 0.5*||y-t||² 的平均值（与Trainer一致）；准确率为输出最大值下标与目标最大值下标
+//        相同的样本比例，仅对分类类输出有意义。加速比只反映剪枝本身：剪枝前后都用CompiledNetwork::forward计时
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 denseSeconds改为未剪枝的CompiledNetwork耗时，增加graphSeconds
+//-------------------------------------------------------------------------------------------------------------------
+struct PruningReport {
+    size_t denseSynapseCount = 0;  // 剪枝前的突触数量
+    size_t keptSynapseCount = 0;   // 剪枝后保留的突触数量
+    double sparsity = 0.0;         // 被剪除的突触比例
+    double threshold = 0.0;        // 迭代剪枝最终采用的阈值（其他方式为0）
+    double baselineLoss = 0.0;     // 原网络的平均损失
+    double prunedLoss = 0.0;       // 剪枝后的平均损失
+    double lossDelta = 0.0;        // 损失变化量
+    double baselineAccuracy = 0.0; // 原网络的准确率
+    double prunedAccuracy = 0.0;   // 剪枝后的准确率
+    double accuracyDelta = 0.0;    // 准确率变化量
+    double denseSeconds = 0.0;     // 未剪枝的CompiledNetwork在验证集上的推理耗时
+    double sparseSeconds = 0.0;    // 剪枝后的CompiledNetwork在验证集上的推理耗时
+    double speedup = 0.0;          // 剪枝带来的加速比 denseSeconds / sparseSeconds
+    double graphSeconds = 0.0;     // 原网络（对象图Network::forward）在验证集上的推理耗时，仅供参考
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】Pruner
+//【功能】对Network执行幅值剪枝。网络先被编译为CompiledNetwork，剪枝只删除CSR中的条目，
+//        不修改原网络；结果可用ANNExporter导出为只含剩余突触的稀疏ANN文件
+//【接口说明】
+//  - explicit Pruner(Network& network): 构造函数，编译网络；network用于计算基线，须在Pruner使用期间有效
+//  - CompiledNetwork pruneByThreshold(double threshold) const: 删除|w| < threshold的突触
+//  - CompiledNetwork pruneTopKPerNeuron(int keepCount) const: 每个神经元只保留|w|最大的keepCount个输入突触
+//  - CompiledNetwork pruneTopKPerLayer(int keepCount) const: 每层只保留|w|最大的keepCount个突触
+//  - CompiledNetwork pruneIteratively(...) const: 逐步提高稀疏度并在验证集上测量，返回损失增加量不超过上限的最稀疏网络
+//  - PruningReport evaluate(...) const: 在验证集上比较原网络与剪枝网络的损失、准确率和推理耗时
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class Pruner {
+public:
+    explicit Pruner(Network& network);                                 // 构造函数
+    CompiledNetwork pruneByThreshold(double threshold) const;          // 阈值剪枝
+    CompiledNetwork pruneTopKPerNeuron(int keepCount) const;           // 每个神经元保留前k个突触
+    CompiledNetwork pruneTopKPerLayer(int keepCount) const;            // 每层保留前k个突触
+    CompiledNetwork pruneIteratively(const std::vector<std::vector<double>>& inputs,
+                                     const std::vector<std::vector<double>>& targets,
+                                     double maxLossIncrease,
+                                     double sparsityStep,
+                                     PruningReport& report) const;     // 迭代剪枝并测量
+    PruningReport evaluate(const CompiledNetwork& pruned,
+                           const std::vector<std::vector<double>>& inputs,
+                           const std::vector<std::vector<double>>& targets,
+                           int repeats = 1) const;                     // 生成剪枝报告
+
+private:
+    static CompiledLayer filterLayer(const CompiledLayer& layer, const std::vector<bool>& keep); // 按标记保留突触
+    static double measureLoss(const std::vector<std::vector<double>>& outputs,
+                              const std::vector<std::vector<double>>& targets,
+                              double& accuracy);                       // 计算平均损失和准确率
+    Network& network;             // 原网络
+    CompiledNetwork compiled;     // 原网络的编译结果
+};
+
+#endif // PRUNER_HPP
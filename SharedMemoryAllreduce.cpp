@@ -0,0 +1,264 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】SharedMemoryAllreduce.cpp
+//【功能模块和目的】基于POSIX共享内存的多进程全归约类的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "SharedMemoryAllreduce.hpp" // 全归约类头文件
+#include <algorithm>                 // 算法库
+#include <iostream>                  // 输入输出流头文件
+#include <stdexcept>                 // 标准异常头文件
+#include <string>                    // 字符串头文件
+
+#ifdef __linux__
+#include <fcntl.h>     // O_CREAT等标志
+#include <pthread.h>   // 进程间共享屏障
+#include <sys/mman.h>  // shm_open和mmap
+#include <unistd.h>    // ftruncate和getpid
+#include <atomic>      // 生成唯一共享内存名称的计数器
+
+namespace {
+const size_t CACHE_LINE_SIZE = 64; // 数据槽按缓存行对齐，避免不同进程写同一缓存行
+
+size_t alignToCacheLine(size_t bytes) {
+    return (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::SharedMemoryAllreduce
+//【函数功能】创建POSIX共享内存对象并映射，初始化进程间共享屏障。映射后立即shm_unlink，
+//        映射随fork被子进程继承，进程异常退出时也不会在/dev/shm中残留对象
+//【参数】participantCount - 参与者数量，elementCount - 每次归约的元素个数，algorithm - 全归约算法
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+SharedMemoryAllreduce::SharedMemoryAllreduce(int participantCount, int elementCount, AllreduceAlgorithm algorithm)
+    : participantCount(participantCount)
+    , elementCount(elementCount)
+    , algorithm(algorithm)
+    , slotStride(0)
+    , regionSize(0)
+    , region(nullptr)
+    , slots(nullptr)
+{
+    if (participantCount <= 0 || elementCount < 0) {
+        std::cerr << "Error: Invalid allreduce participant or element count.\n";
+        throw std::invalid_argument("Invalid allreduce participant or element count.");
+    }
+    static std::atomic<int> counter(0);
+    std::string name = "/cann_allreduce_" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "Error: shm_open failed for " << name << ".\n";
+        throw std::runtime_error("Failed to create shared memory: " + name);
+    }
+    size_t headerSize = alignToCacheLine(sizeof(pthread_barrier_t));
+    slotStride = alignToCacheLine(elementCount * sizeof(double)) / sizeof(double);
+    regionSize = headerSize + slotStride * sizeof(double) * participantCount;
+    if (ftruncate(fd, static_cast<off_t>(regionSize)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        std::cerr << "Error: ftruncate failed for " << name << ".\n";
+        throw std::runtime_error("Failed to size shared memory: " + name);
+    }
+    region = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    shm_unlink(name.c_str());
+    if (region == MAP_FAILED) {
+        region = nullptr;
+        std::cerr << "Error: mmap failed for " << name << ".\n";
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+    slots = reinterpret_cast<double*>(static_cast<char*>(region) + headerSize);
+
+    pthread_barrierattr_t attribute;
+    pthread_barrierattr_init(&attribute);
+    pthread_barrierattr_setpshared(&attribute, PTHREAD_PROCESS_SHARED);
+    int result = pthread_barrier_init(static_cast<pthread_barrier_t*>(region), &attribute, participantCount);
+    pthread_barrierattr_destroy(&attribute);
+    if (result != 0) {
+        munmap(region, regionSize);
+        region = nullptr;
+        std::cerr << "Error: pthread_barrier_init failed.\n";
+        throw std::runtime_error("Failed to initialize process-shared barrier.");
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::~SharedMemoryAllreduce
+//【函数功能】销毁屏障并解除共享内存映射。工作进程应以_exit退出，不执行本析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+SharedMemoryAllreduce::~SharedMemoryAllreduce() {
+    if (region != nullptr) {
+        pthread_barrier_destroy(static_cast<pthread_barrier_t*>(region));
+        munmap(region, regionSize);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::barrier
+//【函数功能】等待所有参与者到达屏障
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void SharedMemoryAllreduce::barrier() {
+    pthread_barrier_wait(static_cast<pthread_barrier_t*>(region));
+}
+
+#else // 非Linux平台不支持进程间共享内存全归约
+
+SharedMemoryAllreduce::SharedMemoryAllreduce(int participantCount, int elementCount, AllreduceAlgorithm algorithm)
+    : participantCount(participantCount)
+    , elementCount(elementCount)
+    , algorithm(algorithm)
+    , slotStride(0)
+    , regionSize(0)
+    , region(nullptr)
+    , slots(nullptr)
+{
+    std::cerr << "Error: Shared memory allreduce is only supported on Linux.\n";
+    throw std::runtime_error("Shared memory allreduce is only supported on Linux.");
+}
+
+SharedMemoryAllreduce::~SharedMemoryAllreduce() = default;
+
+void SharedMemoryAllreduce::barrier() {}
+
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::allreduce
+//【函数功能】将data写入本参与者的数据槽，按所选算法与其他参与者逐元素求和，结果写回data。
+//        所有参与者必须以相同的调用顺序调用本函数
+//【参数】rank - 参与者编号（0 ~ participantCount-1），data - 待归约数据，长度须为elementCount
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void SharedMemoryAllreduce::allreduce(int rank, std::vector<double>& data) {
+    if (rank < 0 || rank >= participantCount) {
+        std::cerr << "Error: Allreduce rank out of range.\n";
+        throw std::out_of_range("Allreduce rank out of range");
+    }
+    if (static_cast<int>(data.size()) != elementCount) {
+        std::cerr << "Error: Allreduce data size mismatch.\n";
+        throw std::invalid_argument("Allreduce data size mismatch.");
+    }
+    std::copy(data.begin(), data.end(), getSlot(rank));
+    barrier();
+    if (algorithm == AllreduceAlgorithm::TREE) {
+        treeAllreduce(rank, data);
+    } else {
+        ringAllreduce(rank);
+        std::copy(getSlot(rank), getSlot(rank) + elementCount, data.begin());
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::ringAllreduce
+//【函数功能】环形全归约：数据分为participantCount块。归约-散射阶段第s步，参与者r把左邻居
+//        第(r-s-1)块累加到自己的同一块；N-1步后r持有第(r+1)块的完整和。全收集阶段第s步，
+//        r从左邻居复制第(r-s)块。每步读写的块互不重叠，每步之后经过屏障
+//【参数】rank - 参与者编号
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void SharedMemoryAllreduce::ringAllreduce(int rank) {
+    const int n = participantCount;
+    double* own = getSlot(rank);
+    const double* left = getSlot((rank + n - 1) % n);
+    for (int step = 0; step < n - 1; ++step) {// 归约-散射
+        int chunk = ((rank - step - 1) % n + n) % n;
+        for (int i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+            own[i] += left[i];
+        }
+        barrier();
+    }
+    for (int step = 0; step < n - 1; ++step) {// 全收集
+        int chunk = ((rank - step) % n + n) % n;
+        std::copy(left + chunkBegin(chunk), left + chunkBegin(chunk + 1), own + chunkBegin(chunk));
+        barrier();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::treeAllreduce
+//【函数功能】二叉树全归约：第d层(d=1,2,4...)编号为2d倍数的参与者累加编号r+d的数据槽，
+//        log2(N)层后0号槽为总和，各参与者再从0号槽复制结果
+//【参数】rank - 参与者编号，data - 结果输出
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void SharedMemoryAllreduce::treeAllreduce(int rank, std::vector<double>& data) {
+    for (int distance = 1; distance < participantCount; distance *= 2) {
+        if (rank % (2 * distance) == 0 && rank + distance < participantCount) {
+            double* own = getSlot(rank);
+            const double* child = getSlot(rank + distance);
+            for (int i = 0; i < elementCount; ++i) {
+                own[i] += child[i];
+            }
+        }
+        barrier();
+    }
+    std::copy(getSlot(0), getSlot(0) + elementCount, data.begin());
+    barrier(); // 所有参与者读完0号槽后才允许下一次归约覆盖
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::chunkBegin
+//【函数功能】计算环形算法中第chunk块的起始下标，各块长度至多相差1
+//【参数】chunk - 块编号（0 ~ participantCount）
+//【返回值】int - 起始下标
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int SharedMemoryAllreduce::chunkBegin(int chunk) const {
+    return static_cast<int>(static_cast<long long>(elementCount) * chunk / participantCount);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::getSlot
+//【函数功能】获取指定参与者的数据槽地址
+//【参数】rank - 参与者编号
+//【返回值】double* - 数据槽地址
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double* SharedMemoryAllreduce::getSlot(int rank) {
+    return slots + slotStride * rank;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::getParticipantCount
+//【函数功能】获取参与者数量
+//【参数】无
+//【返回值】int - 参与者数量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int SharedMemoryAllreduce::getParticipantCount() const {
+    return participantCount;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】SharedMemoryAllreduce::getElementCount
+//【函数功能】获取每次归约的元素个数
+//【参数】无
+//【返回值】int - 元素个数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int SharedMemoryAllreduce::getElementCount() const {
+    return elementCount;
+}
@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】SharedMemoryAllreduce.hpp
+//【功能模块和目的】基于POSIX共享内存的多进程全归约（allreduce）类的声明，供数据并行训练合并梯度
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef SHARED_MEMORY_ALLREDUCE_HPP
+#define SHARED_MEMORY_ALLREDUCE_HPP
+
+#include <cstddef> // size_t所属头文件
+#include <vector>  // vector所属头文件
+
+enum class AllreduceAlgorithm { RING, TREE };// 全归约算法：环形（归约-散射+全收集）或二叉树（归约+广播）
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】SharedMemoryAllreduce
+//【功能】在fork之前由父进程创建一块共享内存，内含进程间共享的屏障和每个参与者一个的数据槽；
+//        fork出的各工作进程以自己的rank调用allreduce，得到所有参与者数据的逐元素之和。
+//        仅依赖本机共享内存，不需要任何网络服务（仅支持Linux）
+//【接口说明】
+//  - SharedMemoryAllreduce(int participantCount, int elementCount, AllreduceAlgorithm algorithm): 构造函数
+//  - ~SharedMemoryAllreduce(): 析构函数，销毁屏障并解除映射（只应由创建者进程调用）
+//  - void allreduce(int rank, std::vector<double>& data): 全归约求和，结果写回data
+//  - double* getSlot(int rank): 获取指定参与者的数据槽，可用于进程间回传结果
+//  - int getParticipantCount() const: 获取参与者数量
+//  - int getElementCount() const: 获取每次归约的元素个数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class SharedMemoryAllreduce {
+public:
+    SharedMemoryAllreduce(int participantCount, int elementCount,
+                          AllreduceAlgorithm algorithm = AllreduceAlgorithm::RING); // 创建共享内存和屏障
+    ~SharedMemoryAllreduce();                                  // 销毁屏障并解除映射
+    void allreduce(int rank, std::vector<double>& data);       // 全归约求和
+    double* getSlot(int rank);                                 // 获取指定参与者的数据槽
+    int getParticipantCount() const;                           // 获取参与者数量
+    int getElementCount() const;                               // 获取元素个数
+
+private:
+    void barrier();                                            // 等待所有参与者到达
+    void ringAllreduce(int rank);                              // 环形全归约
+    void treeAllreduce(int rank, std::vector<double>& data);   // 二叉树归约后广播
+    int chunkBegin(int chunk) const;                           // 环形算法中第chunk块的起始下标
+    int participantCount;                                      // 参与者数量
+    int elementCount;                                          // 每次归约的元素个数
+    AllreduceAlgorithm algorithm;                              // 全归约算法
+    size_t slotStride;                                         // 相邻数据槽间隔（按缓存行对齐，单位为double）
+    size_t regionSize;                                         // 共享内存区域大小（字节）
+    void* region;                                              // 共享内存映射起始地址
+    double* slots;                                             // 第一个数据槽的地址
+    SharedMemoryAllreduce(const SharedMemoryAllreduce&) = delete;            // 禁止拷贝
+    SharedMemoryAllreduce& operator=(const SharedMemoryAllreduce&) = delete; // 禁止赋值
+};
+
+#endif // SHARED_MEMORY_ALLREDUCE_HPP
@@ -2,7 +2,8 @@
 //【文件名】Soma.cpp
 //【功能模块和目的】神经元胞体类的实现，包含胞体的所有功能实现
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加getInputCapacity
+//【更改记录】2026年10月19日 增加resizeInputs、setInput
 //-------------------------------------------------------------------------------------------------------------------
 
 #include "Soma.hpp" // 细胞体所属头文件
@@ -56,6 +57,18 @@ std::vector<double> Soma::getInputs() const {
     return inputs;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Soma::getInputCapacity
+//【函数功能】获取输入向量已分配的容量（元素个数），用于统计内存占用
+//【参数】无
+//【返回值】size_t - 容量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t Soma::getInputCapacity() const {
+    return inputs.capacity();
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Soma::setInputs
 //【函数功能】设置胞体的输入信号并更新输出
@@ -68,6 +81,30 @@ void Soma::setInputs(const std::vector<double>& inputs) {
     this->inputs = inputs;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Soma::resizeInputs
+//【函数功能】把输入向量调整为count个元素。vector缩小时不释放容量，因此输入个数不变时反复调用不会分配内存
+//【参数】count - 输入个数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Soma::resizeInputs(size_t count) {
+    inputs.resize(count);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Soma::setInput
+//【函数功能】设置第index个输入信号，调用前须用resizeInputs保证元素个数足够
+//【参数】index - 输入下标，input - 输入信号值
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Soma::setInput(size_t index, double input) {
+    inputs[index] = input;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //【函数名称】Soma::setBias
 //【函数功能】设置胞体的偏置值并更新输出
@@ -122,15 +159,10 @@ void Soma::setActivationFunctionType(int type) {
 //【参数】sum - 输入信号的加权和
 //【返回值】double - 激活后的输出信号
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 改为调用ActivationFunc::apply，与训练器共用同一类型分派
 //-------------------------------------------------------------------------------------------------------------------
 double Soma::activate(double sum) const {
-    switch (activationFunctionType) {
-        case 1: return ActivationFunc::sigmoid(sum); // Sigmoid 激活函数
-        case 2: return ActivationFunc::tanh(sum);    // Tanh 激活函数
-        case 3: return ActivationFunc::relu(sum);    // ReLU 激活函数
-        default: return ActivationFunc::linear(sum); // Linear 激活函数
-    }
+    return ActivationFunc::apply(activationFunctionType, sum);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -2,13 +2,15 @@
 //【文件名】Soma.hpp
 //【功能模块和目的】神经元胞体类的声明，定义了神经元的基本计算功能，继承自激活函数类
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加getInputCapacity，用于内存占用统计
+//【更改记录】2026年10月19日 增加resizeInputs、setInput，前向传播时原地写入输入，不再分配临时向量
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef SOMA_HPP
 #define SOMA_HPP
 
 #include "ActivationFunc.hpp" // 激活函数所属头文件
+#include <cstddef> // size_t所属头文件
 #include <vector> // vector所属头文件
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -19,7 +21,10 @@
 //  - Soma(std::vector<double> inputs, double bias, int activationFunctionType): 构造函数
 //  - void addInput(double input): 添加输入信号到输入向量
 //  - std::vector<double> getInputs() const: 获取当前输入向量
+//  - size_t getInputCapacity() const: 获取输入向量已分配的容量
 //  - void setInputs(const std::vector<double>& inputs): 设置输入向量
+//  - void resizeInputs(size_t count): 把输入向量调整为count个元素，容量足够时不分配内存
+//  - void setInput(size_t index, double input): 设置第index个输入
 //  - void setBias(double bias): 设置偏置值
 //  - double getBias() const: 获取当前偏置值
 //  - void setActivationFunctionType(int type): 设置激活函数类型
@@ -28,7 +33,8 @@
 //  - double getOutput() const: 获取当前输出值
 //  - virtual ~Soma(): 虚析构函数
 //【开发者及日期】李孟涵 2025年7月13日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加getInputCapacity
+//【更改记录】2026年10月19日 增加resizeInputs、setInput
 //-------------------------------------------------------------------------------------------------------------------
 class Soma : public ActivationFunc { // 继承自激活函数类，从激活函数功能出发
 public:
@@ -38,7 +44,10 @@ public:
          int activationFunctionType = 0);        // 构造函数，初始化输入向量、偏置和激活函数类型
     void addInput(double input);                 // 添加输入信号到输入向量
     std::vector<double> getInputs() const;       // 获取当前输入向量
+    size_t getInputCapacity() const;             // 获取输入向量已分配的容量
     void setInputs(const std::vector<double>& inputs); // 设置输入向量
+    void resizeInputs(size_t count);             // 调整输入向量的元素个数
+    void setInput(size_t index, double input);   // 设置第index个输入
     void setBias(double bias);                   // 设置偏置值
     double getBias() const;                      // 获取当前偏置值
     void setActivationFunctionType(int type);    // 设置激活函数类型
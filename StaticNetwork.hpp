@@ -0,0 +1,258 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】StaticNetwork.hpp
+//【功能模块和目的】固定结构的小型网络（仅头文件）。各层的宽度和激活函数类型是模板参数，权重存放在std::array中，
+//                  推理不分配堆内存，小层的循环在编译期完全展开，适合结构固定的嵌入式小模型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 载入权重时用Layer::indexOf换算前驱下标
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef STATIC_NETWORK_HPP
+#define STATIC_NETWORK_HPP
+
+#include "ActivationFunc.hpp" // 激活函数类头文件
+#include "Layer.hpp"          // 层类头文件
+#include "Network.hpp"        // 网络类头文件
+#include "Neuron.hpp"         // 神经元类头文件
+#include "Synapse.hpp"        // 突触类头文件
+#include <array>              // std::array
+#include <cstddef>            // size_t所属头文件
+#include <iostream>           // 输入输出流头文件
+#include <stdexcept>          // 标准异常头文件
+#include <string>             // 字符串所属头文件
+#include <tuple>              // std::tuple
+#include <type_traits>        // std::integral_constant
+
+//-------------------------------------------------------------------------------------------------------------------
+//【模板名】StaticUnroll / StaticFor
+//【功能】编译期循环：StaticFor<N>::run(body)依次以0..N-1调用body。N不超过STATIC_UNROLL_LIMIT时递归展开，
+//        不留循环；更大时退化为边界为常量的普通循环，避免模板实例化过深
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+const int STATIC_UNROLL_LIMIT = 16; // 完全展开的最大循环次数
+
+template <int Index, int End>
+struct StaticUnroll {
+    template <typename Body>
+    static void run(Body& body) {
+        body(Index);
+        StaticUnroll<Index + 1, End>::run(body);
+    }
+};
+
+template <int End>
+struct StaticUnroll<End, End> {
+    template <typename Body>
+    static void run(Body&) {}
+};
+
+template <int N, bool Unrolled = (N <= STATIC_UNROLL_LIMIT)>
+struct StaticFor {
+    template <typename Body>
+    static void run(Body& body) {
+        StaticUnroll<0, N>::run(body);
+    }
+};
+
+template <int N>
+struct StaticFor<N, false> {
+    template <typename Body>
+    static void run(Body& body) {
+        for (int i = 0; i < N; ++i) {
+            body(i);
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【模板名】StaticLayer
+//【功能】从In个神经元到Out个神经元的全连接层，Act为本层激活函数类型（0线性、1Sigmoid、2tanh、3ReLU）。
+//        weights按行存放，weights[i * In + j]为前一层神经元j到本层神经元i的权重，缺失的突触为0
+//【接口说明】
+//  - static const int inputs / outputs / activation: 模板参数
+//  - void evaluate(const double* input, double* output) const: output[i] = f(b[i] + Σ w[i][j]·input[j])
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+template <int In, int Out, int Act>
+struct StaticLayer {
+    static_assert(In > 0 && Out > 0, "StaticLayer widths must be positive");
+    static const int inputs = In;      // 前一层宽度
+    static const int outputs = Out;    // 本层宽度
+    static const int activation = Act; // 激活函数类型
+
+    std::array<double, In * Out> weights{}; // 权重，按行存放
+    std::array<double, Out> biases{};       // 偏置
+
+    void evaluate(const double* input, double* output) const {
+        const double* row = weights.data();
+        const double* bias = biases.data();
+        auto neuron = [input, output, row, bias](int i) {
+            double sum = bias[i];
+            const double* w = row + i * In;
+            auto synapse = [&sum, w, input](int j) { sum += w[j] * input[j]; };
+            StaticFor<In>::run(synapse);
+            output[i] = ActivationKernel<Act>::apply(sum);
+        };
+        StaticFor<Out>::run(neuron);
+    }
+};
+
+template <int In, int Out, int Act> const int StaticLayer<In, Out, Act>::inputs;
+template <int In, int Out, int Act> const int StaticLayer<In, Out, Act>::outputs;
+template <int In, int Out, int Act> const int StaticLayer<In, Out, Act>::activation;
+
+//-------------------------------------------------------------------------------------------------------------------
+//【模板名】StaticShapeCheck
+//【功能】编译期检查相邻两层的宽度是否衔接
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+template <typename... Layers>
+struct StaticShapeCheck : std::true_type {};
+
+template <typename First, typename Second, typename... Rest>
+struct StaticShapeCheck<First, Second, Rest...>
+    : std::integral_constant<bool, First::outputs == Second::inputs && StaticShapeCheck<Second, Rest...>::value> {};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】StaticNetwork
+//【功能】由若干StaticLayer组成的固定结构网络。对应的Network第0层为输入层（宽度为第一个StaticLayer的In），
+//        输出为 x + b，要求为线性激活；之后每个StaticLayer对应Network的一层。推理只使用栈上的std::array，
+//        计算顺序与Network::forward按前一层神经元顺序求和时相同
+//【接口说明】
+//  - StaticNetwork(): 默认构造函数，权重和偏置为0
+//  - explicit StaticNetwork(const Network& network): 从Network加载，结构不符时抛出std::invalid_argument
+//  - void load(const Network& network): 从Network加载参数，检查层数、宽度和每个神经元的激活函数类型
+//  - std::array<double, OutputSize> infer(const std::array<double, InputSize>& input) const: 推理
+//  - void infer(const double* input, double* output) const: 推理，input、output分别有InputSize、OutputSize个元素
+//  - std::array<double, InputSize>& inputBiases() / Layer& layer<I>(): 直接访问参数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+template <typename... Layers>
+class StaticNetwork {
+    static_assert(sizeof...(Layers) > 0, "StaticNetwork needs at least one layer");
+    static_assert(StaticShapeCheck<Layers...>::value, "StaticNetwork layer widths do not match");
+
+    typedef std::tuple<Layers...> LayerTuple;
+    static const size_t LAYER_COUNT = sizeof...(Layers);
+    typedef typename std::tuple_element<0, LayerTuple>::type FirstLayer;
+    typedef typename std::tuple_element<LAYER_COUNT - 1, LayerTuple>::type LastLayer;
+
+public:
+    static const int InputSize = FirstLayer::inputs;  // 输入宽度
+    static const int OutputSize = LastLayer::outputs; // 输出宽度
+
+    template <size_t I>
+    using LayerType = typename std::tuple_element<I, LayerTuple>::type;
+
+    StaticNetwork() : biases{} {}
+
+    explicit StaticNetwork(const Network& network) : biases{} {
+        load(network);
+    }
+
+    void load(const Network& network) {
+        if (network.getLayerCount() != static_cast<int>(LAYER_COUNT) + 1) {
+            fail("StaticNetwork expects " + std::to_string(LAYER_COUNT + 1) + " layers, got "
+                 + std::to_string(network.getLayerCount()));
+        }
+        const Layer& input = *network.getLayer(0);
+        checkLayer(input, 0, InputSize, 0);
+        for (int i = 0; i < InputSize; ++i) {
+            biases[i] = input.getNeuron(i).getBias();
+        }
+        loadLayer(network, std::integral_constant<size_t, 0>());
+    }
+
+    std::array<double, OutputSize> infer(const std::array<double, InputSize>& input) const {
+        std::array<double, OutputSize> output;
+        infer(input.data(), output.data());
+        return output;
+    }
+
+    void infer(const double* input, double* output) const {
+        std::array<double, InputSize> current;
+        double* values = current.data();
+        const double* bias = biases.data();
+        auto neuron = [values, input, bias](int i) { values[i] = input[i] + bias[i]; };
+        StaticFor<InputSize>::run(neuron);
+        forwardFrom(current, output, std::integral_constant<size_t, 0>());
+    }
+
+    std::array<double, InputSize>& inputBiases() { return biases; }
+    const std::array<double, InputSize>& inputBiases() const { return biases; }
+
+    template <size_t I>
+    LayerType<I>& layer() { return std::get<I>(layers); }
+
+    template <size_t I>
+    const LayerType<I>& layer() const { return std::get<I>(layers); }
+
+private:
+    static void fail(const std::string& message) {
+        std::cerr << "Error: " << message << "\n";
+        throw std::invalid_argument(message);
+    }
+
+    // 检查层宽和每个神经元的激活函数类型
+    static void checkLayer(const Layer& layer, int index, int width, int activation) {
+        if (layer.getNeuronCount() != width) {
+            fail("StaticNetwork layer " + std::to_string(index) + " expects " + std::to_string(width)
+                 + " neurons, got " + std::to_string(layer.getNeuronCount()));
+        }
+        for (const Neuron& neuron : layer.getNeurons()) {
+            if (neuron.getActivationFunctionType() != activation) {
+                fail("StaticNetwork layer " + std::to_string(index) + " expects activation type "
+                     + std::to_string(activation) + ", got " + std::to_string(neuron.getActivationFunctionType()));
+            }
+        }
+    }
+
+    template <size_t I>
+    void loadLayer(const Network& network, std::integral_constant<size_t, I>) {
+        LayerType<I>& target = std::get<I>(layers);
+        const int width = LayerType<I>::outputs;
+        const int previousWidth = LayerType<I>::inputs;
+        const Layer& source = *network.getLayer(static_cast<int>(I) + 1);
+        checkLayer(source, static_cast<int>(I) + 1, width, LayerType<I>::activation);
+        const Layer& previous = *network.getLayer(static_cast<int>(I));
+        target.weights.fill(0.0);
+        for (int i = 0; i < width; ++i) {
+            const Neuron& neuron = source.getNeuron(i);
+            target.biases[i] = neuron.getBias();
+            for (const Synapse* dendrite : neuron.getDendrites()) {
+                const int column = previous.indexOf(dendrite->getPre());
+                if (column >= 0 && column < previousWidth) {
+                    target.weights[i * previousWidth + column] += dendrite->getWeight();
+                }
+            }
+        }
+        loadLayer(network, std::integral_constant<size_t, I + 1>());
+    }
+
+    void loadLayer(const Network&, std::integral_constant<size_t, LAYER_COUNT>) {}
+
+    template <size_t I, typename Values>
+    void forwardFrom(const Values& input, double* output, std::integral_constant<size_t, I>) const {
+        std::array<double, LayerType<I>::outputs> next;
+        std::get<I>(layers).evaluate(input.data(), next.data());
+        forwardFrom(next, output, std::integral_constant<size_t, I + 1>());
+    }
+
+    void forwardFrom(const std::array<double, OutputSize>& input, double* output,
+                     std::integral_constant<size_t, LAYER_COUNT>) const {
+        auto copy = [output, &input](int i) { output[i] = input[i]; };
+        StaticFor<OutputSize>::run(copy);
+    }
+
+    std::array<double, InputSize> biases; // 输入层偏置
+    LayerTuple layers;                    // 各层参数
+};
+
+template <typename... Layers> const size_t StaticNetwork<Layers...>::LAYER_COUNT;
+template <typename... Layers> const int StaticNetwork<Layers...>::InputSize;
+template <typename... Layers> const int StaticNetwork<Layers...>::OutputSize;
+
+#endif // STATIC_NETWORK_HPP
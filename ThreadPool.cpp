@@ -0,0 +1,338 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ThreadPool.cpp
+//【功能模块和目的】任务窃取线程池的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 定义CANN_TRACE时为工作线程命名，记录每个任务和parallelFor的每一块
+//【更改记录】2026年10月19日 增加isWorkerThread
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "ThreadPool.hpp" // 线程池类头文件
+#include "Tracer.hpp"     // 时间线跟踪
+#include <algorithm>      // std::max
+#include <exception>      // std::exception_ptr
+#include <iostream>       // 输入输出流头文件
+#include <stdexcept>      // 标准异常头文件
+#include <string>         // 字符串所属头文件
+#include <utility>        // std::move
+
+#ifdef __linux__
+#include <pthread.h>      // pthread_setaffinity_np
+#include <sched.h>        // cpu_set_t
+#endif
+
+namespace {
+
+thread_local const ThreadPool* currentPool = nullptr; // 当前线程所属的线程池
+thread_local int currentIndex = -1;                   // 当前线程在所属线程池中的索引
+
+std::mutex sharedMutex;                               // 保护以下两个变量
+ThreadPoolOptions sharedOptions;                      // 共享线程池的参数
+std::unique_ptr<ThreadPool> sharedPool;               // 共享线程池
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ThreadPool::ParallelForState
+//【功能】一次parallelFor的共享状态：remaining为尚未执行完的元素个数，降为0时调用者返回
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//【更改记录】2026年10月19日 parallelFor每一块的跟踪参数标明为count
+//-------------------------------------------------------------------------------------------------------------------
+struct ThreadPool::ParallelForState {
+    const std::function<void(size_t, size_t)>* body; // 循环体，调用者等待期间有效
+    size_t grain;                                    // 粒度
+    std::atomic<size_t> remaining;                   // 未完成的元素个数
+    std::mutex mutex;                                // 保护error
+    std::exception_ptr error;                        // 第一个异常
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::ThreadPool
+//【函数功能】构造函数，检查参数并启动工作线程
+//【参数】options - 线程池参数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) : pending(0), stopping(false) {
+    if (options.workers < 0) {
+        std::cerr << "Error: Worker count must not be negative.\n";
+        throw std::invalid_argument("Worker count must not be negative");
+    }
+    int count = options.workers;
+    if (count == 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+        count = count > 0 ? count : 1;
+    }
+#ifndef __linux__
+    if (options.pinThreads) {
+        std::cerr << "Warning: CPU pinning is only supported on Linux and was ignored.\n";
+    }
+#endif
+    for (int i = 0; i < count; ++i) {
+        workers.emplace_back(new Worker);
+    }
+    for (int i = 0; i < count; ++i) {// 全部队列创建后再启动线程，窃取时不会访问到未创建的队列
+        workers[i]->thread = std::thread(&ThreadPool::run, this, i, options.pinThreads);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::~ThreadPool
+//【函数功能】析构函数，请求停止，工作线程执行完所有已提交的任务后退出
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::shared / ThreadPool::configureShared
+//【函数功能】获取库内共享的线程池（首次调用时按configureShared设置的参数创建）；设置其参数
+//【参数】options - 线程池参数
+//【返回值】shared返回ThreadPool& - 共享线程池
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+ThreadPool& ThreadPool::shared() {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (!sharedPool) {
+        sharedPool.reset(new ThreadPool(sharedOptions));
+    }
+    return *sharedPool;
+}
+
+void ThreadPool::configureShared(const ThreadPoolOptions& options) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (sharedPool) {
+        std::cerr << "Error: The shared thread pool has already been created.\n";
+        throw std::logic_error("The shared thread pool has already been created");
+    }
+    if (options.workers < 0) {
+        std::cerr << "Error: Worker count must not be negative.\n";
+        throw std::invalid_argument("Worker count must not be negative");
+    }
+    sharedOptions = options;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::getWorkerCount / ThreadPool::isWorkerThread / ThreadPool::currentWorker
+//【函数功能】获取工作线程数；判断当前线程是否为本池的工作线程；获取当前线程在本池中的索引
+//【参数】无
+//【返回值】int - 线程数；bool - 是否为本池的工作线程；索引，不是本池的工作线程时为-1
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加isWorkerThread
+//-------------------------------------------------------------------------------------------------------------------
+int ThreadPool::getWorkerCount() const {
+    return static_cast<int>(workers.size());
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return currentWorker() >= 0;
+}
+
+int ThreadPool::currentWorker() const {
+    return currentPool == this ? currentIndex : -1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::submit
+//【函数功能】提交任务：工作线程提交到自己队列的尾部，其他线程提交到公共队列；然后唤醒一个空闲的工作线程。
+//           唤醒前先获取一次sleepMutex，保证检查pending后进入等待的线程不会错过这次通知
+//【参数】task - 任务
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void ThreadPool::submit(std::function<void()> task) {
+    if (!task) {
+        std::cerr << "Error: Task must not be empty.\n";
+        throw std::invalid_argument("Task must not be empty");
+    }
+    const int index = currentWorker();
+    if (index >= 0) {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        injected.push_back(std::move(task));
+    }
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::runOneTask
+//【函数功能】依次尝试：自己队列的尾部、公共队列的头部、从下一个线程起各队列的头部（窃取），
+//           取到任务后执行，任务抛出的异常被忽略
+//【参数】无
+//【返回值】bool - 是否执行了任务
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 定义CANN_TRACE时记录每个任务
+//-------------------------------------------------------------------------------------------------------------------
+bool ThreadPool::runOneTask() {
+    if (pending.load() <= 0) {
+        return false;
+    }
+    std::function<void()> task;
+    const int index = currentWorker();
+    if (index >= 0) {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        if (!workers[index]->tasks.empty()) {
+            task = std::move(workers[index]->tasks.back());
+            workers[index]->tasks.pop_back();
+        }
+    }
+    if (!task) {
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        if (!injected.empty()) {
+            task = std::move(injected.front());
+            injected.pop_front();
+        }
+    }
+    const int count = static_cast<int>(workers.size());
+    for (int offset = 1; !task && offset <= count; ++offset) {
+        Worker& victim = *workers[(index + offset + count) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    pending.fetch_sub(1);
+    CANN_TRACE_SCOPE("pool", "task");
+    try {
+        task();
+    } catch (...) {
+        // 任务自行处理异常；这里只保护工作线程
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::run
+//【函数功能】工作线程：按需绑定CPU，循环执行任务，没有任务时等待唤醒；请求停止后执行完剩余任务再退出
+//【参数】index - 线程索引，pin - 是否绑定CPU
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 定义CANN_TRACE时在时间线上命名为pool-worker-索引
+//-------------------------------------------------------------------------------------------------------------------
+void ThreadPool::run(int index, bool pin) {
+    currentPool = this;
+    currentIndex = index;
+#ifdef CANN_TRACE
+    Tracer::setThreadName("pool-worker-" + std::to_string(index));
+#endif
+#ifdef __linux__
+    if (pin) {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0 && CPU_COUNT(&allowed) > 0) {
+            int target = index % CPU_COUNT(&allowed);
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+                    cpu_set_t single;
+                    CPU_ZERO(&single);
+                    CPU_SET(cpu, &single);
+                    pthread_setaffinity_np(pthread_self(), sizeof(single), &single);
+                    break;
+                }
+            }
+        }
+    }
+#else
+    (void)pin;
+#endif
+    while (true) {
+        if (runOneTask()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stopping.load() && pending.load() <= 0) {
+            return;
+        }
+        wake.wait(lock, [this]() { return pending.load() > 0 || stopping.load(); });
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::parallelFor
+//【函数功能】并行执行[begin, end)。粒度取minGrain与“范围/(线程数×4)”中的较大者，使每个线程约分到4块，
+//           既有窃取余地又不会因块太小而以调度开销为主。区间由调用线程开始对半拆分，拆出的后一半作为任务提交，
+//           空闲线程窃取到的总是剩余的最大块。调用线程在等待期间执行池中的任务
+//【参数】begin、end - 范围，body - 循环体，minGrain - 最小粒度
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 定义CANN_TRACE时记录不拆分时的整块
+//-------------------------------------------------------------------------------------------------------------------
+void ThreadPool::parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body,
+                             size_t minGrain) {
+    if (end <= begin) {
+        return;
+    }
+    const size_t count = end - begin;
+    const size_t chunks = workers.size() * 4;
+    const size_t grain = std::max(std::max<size_t>(minGrain, 1), (count + chunks - 1) / chunks);
+    if (count <= grain) {
+        CANN_TRACE_SCOPE_ARG("pool", "parallelFor chunk", "count", static_cast<long long>(count));
+        body(begin, end);
+        return;
+    }
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+    state->body = &body;
+    state->grain = grain;
+    state->remaining.store(count);
+    runRange(state, begin, end);
+    while (state->remaining.load() > 0) {
+        if (!runOneTask()) {
+            std::this_thread::yield();
+        }
+    }
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】ThreadPool::runRange
+//【函数功能】把区间对半拆分，后一半提交为任务，直到不超过粒度后执行循环体并扣减剩余个数
+//【参数】state - 共享状态，begin、end - 区间
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 定义CANN_TRACE时记录每一块，参数为元素个数
+//-------------------------------------------------------------------------------------------------------------------
+void ThreadPool::runRange(const std::shared_ptr<ParallelForState>& state, size_t begin, size_t end) {
+    while (end - begin > state->grain) {
+        const size_t middle = begin + (end - begin) / 2;
+        submit([this, state, middle, end]() { runRange(state, middle, end); });
+        end = middle;
+    }
+    try {
+        CANN_TRACE_SCOPE_ARG("pool", "parallelFor chunk", "count", static_cast<long long>(end - begin));
+        (*state->body)(begin, end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error) {
+            state->error = std::current_exception();
+        }
+    }
+    state->remaining.fetch_sub(end - begin);
+}
@@ -0,0 +1,94 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ThreadPool.hpp
+//【功能模块和目的】库内共享的任务窃取线程池：每个工作线程一个任务双端队列，空闲时从其他线程的队列窃取任务；
+//                  提供parallelFor（按范围大小和线程数自适应划分粒度），可选把工作线程绑定到CPU。
+//                  库内的并行功能都从同一个池取线程，避免各自创建线程导致超额订阅
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加isWorkerThread
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>             // 原子变量
+#include <condition_variable> // 条件变量
+#include <cstddef>            // size_t所属头文件
+#include <deque>              // 双端队列
+#include <functional>         // std::function
+#include <memory>             // 智能指针
+#include <mutex>              // 互斥锁
+#include <thread>             // 线程
+#include <vector>             // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ThreadPoolOptions
+//【功能】线程池参数。workers为0时使用硬件线程数；pinThreads为true时把第i个工作线程绑定到
+//        进程允许使用的第i个CPU（仅Linux，其他平台忽略）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ThreadPoolOptions {
+    int workers = 0;         // 工作线程数
+    bool pinThreads = false; // 是否绑定CPU
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ThreadPool
+//【功能】任务窃取线程池。工作线程提交的任务放入自己队列的尾部并从尾部取出（后进先出，缓存友好），
+//        窃取时从其他队列的头部取（先进先出，取到的是较大的任务）；其他线程提交的任务进入公共队列。
+//        每个队列由各自的互斥锁保护，锁只在同一队列的所有者与窃取者之间竞争。
+//        等待parallelFor完成的线程会一起执行池中的任务，因此可在任务中嵌套调用parallelFor
+//【接口说明】
+//  - explicit ThreadPool(const ThreadPoolOptions& options): 构造函数，启动工作线程
+//  - void submit(std::function<void()> task): 提交任务，任务抛出的异常被忽略
+//  - void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t minGrain):
+//    把[begin, end)划分为若干子区间并行调用body(子区间起点, 子区间终点)，全部完成后返回；
+//    每块不小于minGrain，范围不超过一块时直接在调用线程执行；body抛出的第一个异常在全部完成后重新抛出
+//  - int getWorkerCount() const: 工作线程数
+//  - bool isWorkerThread() const: 调用线程是否为本池的工作线程；在池的任务中等待其他任务会占住工作线程，
+//    调用者可据此避免阻塞
+//  - static ThreadPool& shared(): 库内共享的线程池，首次调用时创建
+//  - static void configureShared(const ThreadPoolOptions& options): 设置共享线程池的参数，须在首次使用前调用，
+//    之后调用抛出std::logic_error
+//  - ~ThreadPool(): 析构函数，执行完已提交的任务后停止工作线程
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加isWorkerThread
+//-------------------------------------------------------------------------------------------------------------------
+class ThreadPool {
+public:
+    explicit ThreadPool(const ThreadPoolOptions& options = ThreadPoolOptions());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    void submit(std::function<void()> task);
+    void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t minGrain = 1);
+    int getWorkerCount() const;
+    bool isWorkerThread() const;
+    static ThreadPool& shared();
+    static void configureShared(const ThreadPoolOptions& options);
+    ~ThreadPool();
+
+private:
+    //---------------------------------------------------------------------------------------------------------------
+    //【结构体名】Worker
+    //【功能】一个工作线程及其任务队列
+    //---------------------------------------------------------------------------------------------------------------
+    struct Worker {
+        std::mutex mutex;                         // 保护tasks
+        std::deque<std::function<void()>> tasks;  // 任务队列：所有者在尾部存取，窃取者从头部取
+        std::thread thread;                       // 工作线程
+    };
+    struct ParallelForState;                      // 一次parallelFor的共享状态
+    void run(int index, bool pin);                // 工作线程主循环
+    bool runOneTask();                            // 取出并执行一个任务，没有任务时返回false
+    void runRange(const std::shared_ptr<ParallelForState>& state, size_t begin, size_t end); // 拆分并执行一个区间
+    int currentWorker() const;                    // 当前线程在本池中的索引，不是本池的工作线程时为-1
+    std::vector<std::unique_ptr<Worker>> workers; // 工作线程
+    std::mutex injectedMutex;                     // 保护injected
+    std::deque<std::function<void()>> injected;   // 非工作线程提交的任务
+    std::atomic<long long> pending;               // 已提交、尚未被取出的任务数
+    std::mutex sleepMutex;                        // 配合wake使用
+    std::condition_variable wake;                 // 有新任务或停止时唤醒空闲的工作线程
+    std::atomic<bool> stopping;                   // 是否已请求停止
+};
+
+#endif // THREAD_POOL_HPP
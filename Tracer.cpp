@@ -0,0 +1,222 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Tracer.cpp
+//【功能模块和目的】时间线跟踪的实现
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 事件参数以参数名为键输出
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "Tracer.hpp" // 跟踪类头文件
+#include <atomic>     // 原子变量
+#include <chrono>     // 计时
+#include <cstdio>     // snprintf
+#include <fstream>    // 文件流头文件
+#include <iostream>   // 输入输出流头文件
+#include <memory>     // 智能指针
+#include <mutex>      // 互斥锁
+#include <stdexcept>  // 标准异常头文件
+#include <vector>     // vector所属头文件
+
+#ifdef __unix__
+#include <unistd.h>   // getpid
+#endif
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】TraceEvent
+//【功能】一个完整事件（Chrome Trace Event中ph为"X"的事件）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加argumentName
+//-------------------------------------------------------------------------------------------------------------------
+struct TraceEvent {
+    const char* category;     // 事件类别
+    const char* name;         // 事件名称
+    double start;             // 开始时间（微秒）
+    double duration;          // 持续时间（微秒）
+    const char* argumentName; // 参数名
+    long long argument;       // 整数参数，小于0时不输出
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ThreadTrace
+//【功能】一个线程的事件缓冲区
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct ThreadTrace {
+    int threadId = 0;               // 线程编号
+    std::string threadName;         // 线程名称
+    std::mutex mutex;               // 保护events和threadName
+    std::vector<TraceEvent> events; // 事件
+};
+
+std::atomic<bool> enabled(false);                     // 是否正在记录
+std::mutex registryMutex;                             // 保护registry
+std::vector<std::shared_ptr<ThreadTrace>> registry;   // 所有线程的缓冲区
+
+ThreadTrace& localTrace() {
+    thread_local std::shared_ptr<ThreadTrace> local;
+    if (!local) {
+        local = std::make_shared<ThreadTrace>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        local->threadId = static_cast<int>(registry.size());
+        registry.push_back(local);
+    }
+    return *local;
+}
+
+std::string escape(const std::string& text) {
+    std::string result;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::enable / Tracer::disable / Tracer::isEnabled
+//【函数功能】开始、停止记录，查询是否正在记录
+//【参数】无
+//【返回值】isEnabled返回bool - 是否正在记录
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Tracer::enable() {
+    nowMicroseconds(); // 确定时间原点
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+bool Tracer::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::nowMicroseconds
+//【函数功能】读取steady_clock，以首次调用的时刻为原点
+//【参数】无
+//【返回值】double - 微秒数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+double Tracer::nowMicroseconds() {
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::record
+//【函数功能】把一个完整事件追加到当前线程的缓冲区
+//【参数】category - 事件类别，name - 事件名称，start - 开始时间（微秒），duration - 持续时间（微秒），
+//        argumentName - 参数名，argument - 整数参数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加argumentName
+//-------------------------------------------------------------------------------------------------------------------
+void Tracer::record(const char* category, const char* name, double start, double duration,
+                    const char* argumentName, long long argument) {
+    ThreadTrace& local = localTrace();
+    std::lock_guard<std::mutex> lock(local.mutex);
+    local.events.push_back({ category, name, start, duration, argumentName, argument });
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::setThreadName
+//【函数功能】设置当前线程在时间线上显示的名称
+//【参数】name - 线程名称
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Tracer::setThreadName(const std::string& name) {
+    ThreadTrace& local = localTrace();
+    std::lock_guard<std::mutex> lock(local.mutex);
+    local.threadName = name;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::writeJson
+//【函数功能】输出Chrome Trace Event JSON（对象格式），先输出各线程的名称元数据，再输出全部完整事件
+//【参数】stream - 输出流
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 参数以事件自带的参数名为键输出
+//-------------------------------------------------------------------------------------------------------------------
+void Tracer::writeJson(std::ostream& stream) {
+#ifdef __unix__
+    const long long processId = static_cast<long long>(getpid());
+#else
+    const long long processId = 1;
+#endif
+    std::streamsize precision = stream.precision();
+    stream.precision(15);
+    stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    for (const auto& thread : registry) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        std::string threadName = thread->threadName.empty() ? "thread " + std::to_string(thread->threadId)
+                                                            : thread->threadName;
+        stream << (first ? "\n" : ",\n") << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << processId
+               << ", \"tid\": " << thread->threadId << ", \"args\": {\"name\": \"" << escape(threadName) << "\"}}";
+        first = false;
+        for (const auto& event : thread->events) {
+            stream << ",\n  {\"name\": \"" << escape(event.name) << "\", \"cat\": \"" << escape(event.category)
+                   << "\", \"ph\": \"X\", \"ts\": " << event.start << ", \"dur\": " << event.duration
+                   << ", \"pid\": " << processId << ", \"tid\": " << thread->threadId;
+            if (event.argument >= 0) {
+                stream << ", \"args\": {\"" << escape(event.argumentName) << "\": " << event.argument << "}";
+            }
+            stream << "}";
+        }
+    }
+    stream << "\n]}\n";
+    stream.precision(precision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::writeJson
+//【函数功能】把Chrome Trace Event JSON写入文件
+//【参数】path - 文件路径
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Tracer::writeJson(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Failed to create trace file: " << path << "\n";
+        throw std::runtime_error("Failed to create trace file: " + path);
+    }
+    writeJson(file);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Tracer::clear
+//【函数功能】清空所有线程已记录的事件，保留线程编号和名称
+//【参数】无
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Tracer::clear() {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    for (const auto& thread : registry) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        thread->events.clear();
+    }
+}
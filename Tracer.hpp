@@ -0,0 +1,94 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Tracer.hpp
+//【功能模块和目的】时间线跟踪。定义CANN_TRACE编译时，导入（解析/连线）、导出各阶段、前向传播及其各层
+//                  以作用域为单位记录开始时间和持续时间，输出为Chrome Trace Event格式的JSON，
+//                  可在chrome://tracing或Perfetto中查看；未定义时CANN_TRACE_SCOPE展开为空语句
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 事件参数带上参数名，不再一律输出为index
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <ostream> // 输出流
+#include <string>  // 字符串所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】Tracer
+//【功能】跟踪事件的记录与输出。编译进程序后仍需调用enable才开始记录，未启用时每个作用域只多一次原子读。
+//        每个线程写自己的事件缓冲区，线程结束后缓冲区保留到输出为止；线程号按首次记录的顺序从0编号
+//【接口说明】
+//  - static void enable() / static void disable(): 开始/停止记录
+//  - static bool isEnabled(): 是否正在记录
+//  - static double nowMicroseconds(): 自首次调用起的微秒数
+//  - static void record(const char* category, const char* name, double start, double duration,
+//                       const char* argumentName, long long argument):
+//    记录一个完整事件，参数以argumentName为键输出，argument小于0时不输出参数
+//  - static void setThreadName(const std::string& name): 设置当前线程在时间线上显示的名称
+//  - static void writeJson(std::ostream& stream): 输出Chrome Trace Event JSON
+//  - static void writeJson(const std::string& path): 输出到文件
+//  - static void clear(): 清空已记录的事件
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 record增加参数名argumentName
+//-------------------------------------------------------------------------------------------------------------------
+class Tracer {
+public:
+    static void enable();
+    static void disable();
+    static bool isEnabled();
+    static double nowMicroseconds();
+    static void record(const char* category, const char* name, double start, double duration,
+                       const char* argumentName, long long argument);
+    static void setThreadName(const std::string& name);
+    static void writeJson(std::ostream& stream);
+    static void writeJson(const std::string& path);
+    static void clear();
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】TraceScope
+//【功能】跟踪构造和析构之间的区间。构造时未启用记录则析构时也不记录
+//【接口说明】
+//  - TraceScope(const char* category, const char* name, const char* argumentName = "", long long argument = -1):
+//    构造函数，category、name和argumentName须为字符串字面量等生命周期足够长的字符串，
+//    argument为可选的整数参数，argumentName为其在时间线上显示的参数名（如层索引为"index"）
+//  - ~TraceScope(): 析构函数，记录事件
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加参数名argumentName
+//-------------------------------------------------------------------------------------------------------------------
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name, const char* argumentName = "", long long argument = -1)
+        : category(category), name(name), argumentName(argumentName), argument(argument),
+          start(Tracer::isEnabled() ? Tracer::nowMicroseconds() : -1.0) {}
+    ~TraceScope() {
+        if (start >= 0.0) {
+            Tracer::record(category, name, start, Tracer::nowMicroseconds() - start, argumentName, argument);
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category;     // 事件类别
+    const char* name;         // 事件名称
+    const char* argumentName; // 参数名
+    long long argument;       // 整数参数
+    double start;             // 开始时间（微秒），未启用时为-1
+};
+
+// 跟踪从当前位置到作用域结束的区间，同一作用域内可使用多次；argumentName为参数在时间线上的名称，
+// 须与argument的含义一致（如"index"、"count"）；未定义CANN_TRACE时不求值任何参数
+#define CANN_TRACE_CONCAT_INNER(a, b) a##b
+#define CANN_TRACE_CONCAT(a, b) CANN_TRACE_CONCAT_INNER(a, b)
+#ifdef CANN_TRACE
+#define CANN_TRACE_SCOPE(category, name) \
+    TraceScope CANN_TRACE_CONCAT(cannTraceScope, __LINE__)((category), (name))
+#define CANN_TRACE_SCOPE_ARG(category, name, argumentName, argument) \
+    TraceScope CANN_TRACE_CONCAT(cannTraceScope, __LINE__)((category), (name), (argumentName), (argument))
+#else
+#define CANN_TRACE_SCOPE(category, name) ((void)0)
+#define CANN_TRACE_SCOPE_ARG(category, name, argumentName, argument) ((void)sizeof(argument)) // 不求值，只避免未使用变量的警告
+#endif
+
+#endif // TRACER_HPP
@@ -0,0 +1,454 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Trainer.cpp
+//【功能模块和目的】训练器类的实现，包含参数提取、批量前向/反向传播和梯度下降
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加梯度检查点模式
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "Trainer.hpp"        // 训练器类头文件
+#include "ActivationFunc.hpp" // 激活函数类头文件
+#include <algorithm>          // 算法库
+#include <cmath>              // 数学函数库
+#include <iostream>           // 输入输出流头文件
+#include <stdexcept>          // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::Trainer
+//【函数功能】从网络中提取每层宽度、激活函数类型、权重和偏置，组织为连续的参数向量
+//【参数】network - 待训练的网络
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+Trainer::Trainer(const Network& network) : checkpointInterval(1) {
+    if (!network.isValid()) {// 检查网络是否有效
+        std::cerr << "Error: Cannot train an invalid network.\n";
+        throw std::invalid_argument("Cannot train an invalid network.");
+    }
+    for (const auto* layer : network.getLayers()) {
+        const auto& neurons = layer->getNeurons();
+        int layerIndex = static_cast<int>(widths.size());
+        std::vector<int> types;
+        weightOffsets.push_back(static_cast<int>(parameters.size())); // 第0层没有权重，仅占位
+        if (layerIndex > 0) {
+            // 权重矩阵按行存放，第i行为本层神经元i的树突权重
+            for (const auto& neuron : neurons) {
+                if (neuron.getDendriteCount() != widths.back()) {// 训练器按稠密矩阵处理，要求与前一层全连接
+                    std::cerr << "Error: Layer " << layerIndex << " is not fully connected to the previous layer.\n";
+                    throw std::invalid_argument("Trainer requires fully connected layers.");
+                }
+                auto weights = neuron.getWeights();
+                parameters.insert(parameters.end(), weights.begin(), weights.end());
+            }
+        }
+        biasOffsets.push_back(static_cast<int>(parameters.size()));
+        for (const auto& neuron : neurons) {
+            parameters.push_back(neuron.getBias());
+            types.push_back(neuron.getActivationFunctionType());
+        }
+        widths.push_back(layer->getNeuronCount());
+        activationTypes.push_back(types);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::getParameterCount
+//【函数功能】获取参数个数
+//【参数】无
+//【返回值】int - 参数个数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int Trainer::getParameterCount() const {
+    return static_cast<int>(parameters.size());
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::getParameters
+//【函数功能】获取参数向量
+//【参数】无
+//【返回值】const std::vector<double>& - 参数向量
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+const std::vector<double>& Trainer::getParameters() const {
+    return parameters;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::setParameters
+//【函数功能】设置参数向量，长度必须与当前参数个数一致
+//【参数】newParameters - 新的参数向量
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::setParameters(const std::vector<double>& newParameters) {
+    if (newParameters.size() != parameters.size()) {
+        std::cerr << "Error: Parameter count mismatch.\n";
+        throw std::invalid_argument("Parameter count mismatch.");
+    }
+    parameters = newParameters;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::validateSamples
+//【函数功能】检查输入与目标样本的数量一致，且宽度分别与第一层和最后一层神经元数量一致
+//【参数】inputs - 输入样本，targets - 目标输出样本
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::validateSamples(const std::vector<std::vector<double>>& inputs,
+                              const std::vector<std::vector<double>>& targets) const {
+    if (inputs.size() != targets.size()) {
+        std::cerr << "Error: Input and target sample counts do not match.\n";
+        throw std::invalid_argument("Input and target sample counts do not match.");
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (static_cast<int>(inputs[i].size()) != widths.front() ||
+            static_cast<int>(targets[i].size()) != widths.back()) {
+            std::cerr << "Error: Sample " << i << " does not match the network input/output size.\n";
+            throw std::invalid_argument("Sample size does not match the network input/output size.");
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::forwardLayer
+//【函数功能】对一批样本计算单层输出。第0层输出为 f(x + b)，其余层为 f(W·a + b)
+//【参数】layer - 层索引，previous - 前一层输出（第0层为网络输入），按样本连续存放；
+//        output - 本层输出缓冲区，batchSize - 样本数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::forwardLayer(int layer, const double* previous, double* output, int batchSize) const {
+    const int width = widths[layer];
+    const double* bias = parameters.data() + biasOffsets[layer];
+    const auto& types = activationTypes[layer];
+    if (layer == 0) {
+        for (int s = 0; s < batchSize; ++s) {
+            for (int i = 0; i < width; ++i) {
+                output[s * width + i] = ActivationFunc::apply(types[i], previous[s * width + i] + bias[i]);
+            }
+        }
+        return;
+    }
+    const int previousWidth = widths[layer - 1];
+    const double* weights = parameters.data() + weightOffsets[layer];
+    for (int s = 0; s < batchSize; ++s) {
+        const double* in = previous + s * previousWidth;
+        for (int i = 0; i < width; ++i) {
+            const double* row = weights + i * previousWidth;
+            double sum = bias[i];
+            for (int j = 0; j < previousWidth; ++j) {
+                sum += row[j] * in[j];
+            }
+            output[s * width + i] = ActivationFunc::apply(types[i], sum);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::backwardLayer
+//【函数功能】对一批样本执行单层反向传播：将输出梯度乘以激活函数导数得到加权和梯度，
+//        累加权重与偏置梯度，并计算前一层输出的梯度
+//【参数】layer - 层索引，previous - 前一层输出（第0层为网络输入），output - 本层输出，
+//        delta - 输入为损失对本层输出的梯度，原地变为损失对加权和的梯度；
+//        previousDelta - 损失对前一层输出的梯度（可为nullptr），gradient - 梯度累加缓冲区，batchSize - 样本数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::backwardLayer(int layer, const double* previous, const double* output, double* delta,
+                            double* previousDelta, double* gradient, int batchSize) const {
+    const int width = widths[layer];
+    const auto& types = activationTypes[layer];
+    double* biasGradient = gradient + biasOffsets[layer];
+    for (int s = 0; s < batchSize; ++s) {
+        for (int i = 0; i < width; ++i) {
+            double& d = delta[s * width + i];
+            d *= ActivationFunc::derivative(types[i], output[s * width + i]);
+            biasGradient[i] += d;
+        }
+    }
+    if (layer == 0) {
+        return; // 第0层没有权重
+    }
+    const int previousWidth = widths[layer - 1];
+    const double* weights = parameters.data() + weightOffsets[layer];
+    double* weightGradient = gradient + weightOffsets[layer];
+    if (previousDelta != nullptr) {
+        std::fill(previousDelta, previousDelta + batchSize * previousWidth, 0.0);
+    }
+    for (int s = 0; s < batchSize; ++s) {
+        const double* in = previous + s * previousWidth;
+        const double* d = delta + s * width;
+        for (int i = 0; i < width; ++i) {
+            const double* row = weights + i * previousWidth;
+            double* rowGradient = weightGradient + i * previousWidth;
+            for (int j = 0; j < previousWidth; ++j) {
+                rowGradient[j] += d[i] * in[j];
+            }
+            if (previousDelta != nullptr) {
+                double* pd = previousDelta + s * previousWidth;
+                for (int j = 0; j < previousWidth; ++j) {
+                    pd[j] += row[j] * d[i];
+                }
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::computeBatchGradient
+//【函数功能】对指定样本做批量前向传播，再逐层反向传播，将损失 0.5*||y-t||² 对参数的梯度之和累加到gradient。
+//        前向时只保存检查点层（层号为检查点间隔的倍数，以及最后一层）的激活值；反向时对每个检查点区间
+//        (b, e]，从检查点b重新计算区间内部各层的激活值，反向传播完该区间后立即释放。
+//        间隔为1时每层都是检查点，不发生重算
+//【参数】inputs - 输入样本，targets - 目标样本，sampleIndices - 参与计算的样本下标，
+//        gradient - 梯度累加缓冲区，长度不小于参数个数（多出的元素不被修改）
+//【返回值】double - 这些样本的损失之和
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加梯度检查点，按区间重算激活值
+//-------------------------------------------------------------------------------------------------------------------
+double Trainer::computeBatchGradient(const std::vector<std::vector<double>>& inputs,
+                                     const std::vector<std::vector<double>>& targets,
+                                     const std::vector<int>& sampleIndices,
+                                     std::vector<double>& gradient) const {
+    if (gradient.size() < parameters.size()) {
+        std::cerr << "Error: Gradient buffer is smaller than the parameter count.\n";
+        throw std::invalid_argument("Gradient buffer is smaller than the parameter count.");
+    }
+    const int batchSize = static_cast<int>(sampleIndices.size());
+    const int layerCount = static_cast<int>(widths.size());
+    const int interval = getEffectiveCheckpointInterval();
+    if (batchSize == 0) {
+        return 0.0;
+    }
+    // 收集输入
+    std::vector<double> batchInput(batchSize * widths.front());
+    for (int s = 0; s < batchSize; ++s) {
+        const auto& input = inputs.at(sampleIndices[s]);
+        std::copy(input.begin(), input.end(), batchInput.begin() + s * widths.front());
+    }
+    // 前向传播，只保存检查点层的激活值
+    std::vector<std::vector<double>> checkpoints(layerCount);
+    std::vector<double> current(batchSize * widths.front());
+    std::vector<double> next;
+    forwardLayer(0, batchInput.data(), current.data(), batchSize);
+    for (int l = 0; l < layerCount; ++l) {
+        if (l > 0) {
+            next.resize(batchSize * widths[l]);
+            forwardLayer(l, current.data(), next.data(), batchSize);
+            current.swap(next);
+        }
+        if (l % interval == 0 || l == layerCount - 1) {
+            checkpoints[l] = current;
+        }
+    }
+    std::vector<double>().swap(current);
+    std::vector<double>().swap(next);
+    // 计算损失和输出层梯度
+    double loss = 0.0;
+    const int outputWidth = widths.back();
+    const std::vector<double>& output = checkpoints.back();
+    std::vector<double> delta(batchSize * outputWidth);
+    for (int s = 0; s < batchSize; ++s) {
+        const auto& target = targets.at(sampleIndices[s]);
+        for (int i = 0; i < outputWidth; ++i) {
+            double error = output[s * outputWidth + i] - target[i];
+            delta[s * outputWidth + i] = error;
+            loss += 0.5 * error * error;
+        }
+    }
+    // 按检查点区间 (b, e] 自顶向下反向传播
+    std::vector<double> previousDelta;
+    std::vector<std::vector<double>> segment; // segment[i] 为第 b+1+i 层重算得到的激活值
+    for (int e = layerCount - 1; e > 0;) {
+        const int b = (e - 1) / interval * interval;
+        segment.resize(e - b - 1);
+        for (int l = b + 1; l < e; ++l) {// 从检查点b重算区间内部各层
+            const std::vector<double>& previous = (l - 1 == b) ? checkpoints[b] : segment[l - b - 2];
+            segment[l - b - 1].resize(batchSize * widths[l]);
+            forwardLayer(l, previous.data(), segment[l - b - 1].data(), batchSize);
+        }
+        for (int l = e; l > b; --l) {
+            const std::vector<double>& layerOutput = (l == e) ? checkpoints[e] : segment[l - b - 1];
+            const std::vector<double>& previous = (l - 1 == b) ? checkpoints[b] : segment[l - b - 2];
+            previousDelta.resize(batchSize * widths[l - 1]);
+            backwardLayer(l, previous.data(), layerOutput.data(), delta.data(), previousDelta.data(),
+                          gradient.data(), batchSize);
+            delta.swap(previousDelta);
+        }
+        std::vector<double>().swap(checkpoints[e]); // 区间处理完毕，释放其激活值
+        segment.clear();
+        e = b;
+    }
+    backwardLayer(0, batchInput.data(), checkpoints[0].data(), delta.data(), nullptr, gradient.data(), batchSize);
+    return loss;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::setCheckpointInterval
+//【函数功能】设置梯度检查点间隔：1表示保存所有层的激活值（默认）；k>1表示只保存每第k层的激活值，
+//        其余在反向传播时重算；0表示自动取约√L，使激活值峰值内存从O(L)层降至约O(√L)层
+//【参数】interval - 检查点间隔
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::setCheckpointInterval(int interval) {
+    if (interval < 0) {
+        std::cerr << "Error: Checkpoint interval must not be negative.\n";
+        throw std::invalid_argument("Checkpoint interval must not be negative.");
+    }
+    checkpointInterval = interval;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::getCheckpointInterval
+//【函数功能】获取设置的梯度检查点间隔
+//【参数】无
+//【返回值】int - 检查点间隔（0表示自动）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int Trainer::getCheckpointInterval() const {
+    return checkpointInterval;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::getEffectiveCheckpointInterval
+//【函数功能】获取实际使用的检查点间隔，自动模式下取 round(√L)，且不小于1
+//【参数】无
+//【返回值】int - 实际检查点间隔
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int Trainer::getEffectiveCheckpointInterval() const {
+    if (checkpointInterval > 0) {
+        return checkpointInterval;
+    }
+    return std::max(1, static_cast<int>(std::lround(std::sqrt(static_cast<double>(widths.size())))));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::getPeakActivationBytes
+//【函数功能】估计在当前检查点间隔下，一个批次反向传播时同时驻留的激活值字节数峰值
+//        （所有检查点层之和，加上最大区间内需要重算的层之和），便于按内存预算选择批大小
+//【参数】batchSize - 批大小
+//【返回值】size_t - 激活值峰值字节数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+size_t Trainer::getPeakActivationBytes(int batchSize) const {
+    const int layerCount = static_cast<int>(widths.size());
+    const int interval = getEffectiveCheckpointInterval();
+    size_t checkpointNeurons = 0;
+    size_t segmentNeurons = 0;
+    for (int l = 0; l < layerCount; ++l) {
+        if (l % interval == 0 || l == layerCount - 1) {
+            checkpointNeurons += widths[l];
+        }
+    }
+    for (int e = layerCount - 1; e > 0;) {
+        const int b = (e - 1) / interval * interval;
+        size_t neurons = 0;
+        for (int l = b + 1; l < e; ++l) {
+            neurons += widths[l];
+        }
+        segmentNeurons = std::max(segmentNeurons, neurons);
+        e = b;
+    }
+    return (checkpointNeurons + segmentNeurons) * static_cast<size_t>(batchSize) * sizeof(double);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::applyGradient
+//【函数功能】按比例将梯度加到参数上，梯度下降时scale取 -学习率/批大小
+//【参数】gradient - 梯度向量（仅使用前getParameterCount()个元素），scale - 比例系数
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::applyGradient(const std::vector<double>& gradient, double scale) {
+    if (gradient.size() < parameters.size()) {
+        std::cerr << "Error: Gradient buffer is smaller than the parameter count.\n";
+        throw std::invalid_argument("Gradient buffer is smaller than the parameter count.");
+    }
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        parameters[i] += scale * gradient[i];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::train
+//【函数功能】单进程小批量梯度下降，按样本顺序划分批次，每批用平均梯度更新一次参数
+//【参数】inputs - 输入样本，targets - 目标样本，options - 训练超参数
+//【返回值】double - 最后一轮的平均损失
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 按options设置梯度检查点间隔
+//-------------------------------------------------------------------------------------------------------------------
+double Trainer::train(const std::vector<std::vector<double>>& inputs,
+                      const std::vector<std::vector<double>>& targets,
+                      const TrainingOptions& options) {
+    validateSamples(inputs, targets);
+    if (options.batchSize <= 0 || options.epochs < 0) {
+        std::cerr << "Error: Invalid training options.\n";
+        throw std::invalid_argument("Invalid training options.");
+    }
+    setCheckpointInterval(options.checkpointInterval);
+    const int sampleCount = static_cast<int>(inputs.size());
+    std::vector<double> gradient(parameters.size());
+    std::vector<int> indices;
+    double epochLoss = 0.0;
+    for (int epoch = 0; epoch < options.epochs; ++epoch) {
+        epochLoss = 0.0;
+        for (int begin = 0; begin < sampleCount; begin += options.batchSize) {
+            int end = std::min(begin + options.batchSize, sampleCount);
+            indices.clear();
+            for (int i = begin; i < end; ++i) {
+                indices.push_back(i);
+            }
+            std::fill(gradient.begin(), gradient.end(), 0.0);
+            epochLoss += computeBatchGradient(inputs, targets, indices, gradient);
+            applyGradient(gradient, -options.learningRate / (end - begin));
+        }
+    }
+    return sampleCount > 0 ? epochLoss / sampleCount : 0.0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】Trainer::applyTo
+//【函数功能】将训练后的权重和偏置写回网络，网络结构必须与构造时一致
+//【参数】network - 目标网络
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+void Trainer::applyTo(Network& network) const {
+    if (network.getLayerCount() != static_cast<int>(widths.size())) {
+        std::cerr << "Error: Network structure does not match the trainer.\n";
+        throw std::invalid_argument("Network structure does not match the trainer.");
+    }
+    for (int l = 0; l < static_cast<int>(widths.size()); ++l) {
+        if (network.getLayer(l)->getNeuronCount() != widths[l]) {
+            std::cerr << "Error: Network structure does not match the trainer.\n";
+            throw std::invalid_argument("Network structure does not match the trainer.");
+        }
+        if (l > 0) {
+            const int previousWidth = widths[l - 1];
+            std::vector<std::vector<double>> weights(widths[l]);
+            for (int i = 0; i < widths[l]; ++i) {
+                auto row = parameters.begin() + weightOffsets[l] + i * previousWidth;
+                weights[i].assign(row, row + previousWidth);
+            }
+            network.setWeights(l, weights);
+        }
+        for (int i = 0; i < widths[l]; ++i) {
+            network.setBias(l, i, parameters[biasOffsets[l] + i]);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】Trainer.hpp
+//【功能模块和目的】训练器类的声明，基于反向传播和小批量梯度下降训练全连接神经网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加梯度检查点模式
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef TRAINER_HPP
+#define TRAINER_HPP
+
+#include "Network.hpp" // 网络类头文件
+#include <cstddef>     // size_t所属头文件
+#include <vector>      // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】TrainingOptions
+//【功能】训练超参数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct TrainingOptions {
+    double learningRate = 0.01; // 学习率
+    int epochs = 1;             // 训练轮数
+    int batchSize = 1;          // 全局小批量大小（数据并行时为所有工作进程合计的批大小）
+    int checkpointInterval = 1; // 梯度检查点间隔：1为保存所有层激活值，k>1为每k层保存一次，0为自动取约√L
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】Trainer
+//【功能】将网络参数拷贝为连续的参数向量，以均方误差为损失进行前向/反向传播与梯度下降，
+//        训练结束后再写回Network。连续参数向量便于多进程间直接做梯度归约
+//【接口说明】
+//  - explicit Trainer(const Network& network): 构造函数，从网络中提取结构和参数，要求相邻层全连接
+//  - int getParameterCount() const: 获取参数个数
+//  - const std::vector<double>& getParameters() const: 获取参数向量
+//  - void setParameters(const std::vector<double>& parameters): 设置参数向量
+//  - void validateSamples(...) const: 检查样本与网络输入输出宽度是否匹配
+//  - double computeBatchGradient(...) const: 计算指定样本的梯度之和（累加到gradient），返回损失之和
+//  - void applyGradient(const std::vector<double>& gradient, double scale): 参数 += scale * 梯度
+//  - double train(...): 单进程训练，返回最后一轮的平均损失
+//  - void applyTo(Network& network) const: 将参数写回网络
+//  - void setCheckpointInterval(int interval): 设置梯度检查点间隔
+//  - int getCheckpointInterval() const: 获取梯度检查点间隔
+//  - size_t getPeakActivationBytes(int batchSize) const: 估计一个批次的激活值内存峰值
+//  参数向量布局：第0层为各神经元偏置；第l(l>=1)层先按行存放权重矩阵W[i][j]
+//  （前一层神经元j到本层神经元i），再存放本层偏置
+//  梯度检查点：间隔为k时前向只保存第0、k、2k…层及最后一层的激活值，反向时逐区间重算，
+//  以约一倍的额外前向计算换取O(L/k + k)层的激活值内存
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加梯度检查点模式
+//-------------------------------------------------------------------------------------------------------------------
+class Trainer {
+public:
+    explicit Trainer(const Network& network);                    // 从网络提取结构和参数
+    int getParameterCount() const;                               // 获取参数个数
+    const std::vector<double>& getParameters() const;            // 获取参数向量
+    void setParameters(const std::vector<double>& parameters);   // 设置参数向量
+    void validateSamples(const std::vector<std::vector<double>>& inputs,
+                         const std::vector<std::vector<double>>& targets) const; // 检查样本宽度
+    double computeBatchGradient(const std::vector<std::vector<double>>& inputs,
+                                const std::vector<std::vector<double>>& targets,
+                                const std::vector<int>& sampleIndices,
+                                std::vector<double>& gradient) const; // 累加指定样本的梯度，返回损失之和
+    void applyGradient(const std::vector<double>& gradient, double scale); // 按比例更新参数
+    double train(const std::vector<std::vector<double>>& inputs,
+                 const std::vector<std::vector<double>>& targets,
+                 const TrainingOptions& options);                // 单进程小批量梯度下降
+    void applyTo(Network& network) const;                        // 将参数写回网络
+    void setCheckpointInterval(int interval);                    // 设置梯度检查点间隔
+    int getCheckpointInterval() const;                           // 获取梯度检查点间隔
+    size_t getPeakActivationBytes(int batchSize) const;          // 估计一个批次的激活值内存峰值
+
+private:
+    void forwardLayer(int layer, const double* previous, double* output, int batchSize) const; // 单层批量前向
+    void backwardLayer(int layer, const double* previous, const double* output, double* delta,
+                       double* previousDelta, double* gradient, int batchSize) const;       // 单层批量反向
+    int getEffectiveCheckpointInterval() const;    // 实际使用的检查点间隔
+    int checkpointInterval;                        // 梯度检查点间隔，0为自动
+    std::vector<int> widths;                       // 每层神经元数量
+    std::vector<std::vector<int>> activationTypes; // 每层每个神经元的激活函数类型
+    std::vector<int> weightOffsets;                // 每层权重在参数向量中的起始位置（第0层无权重）
+    std::vector<int> biasOffsets;                  // 每层偏置在参数向量中的起始位置
+    std::vector<double> parameters;                // 连续存放的全部参数
+};
+
+#endif // TRAINER_HPP
@@ -2,7 +2,8 @@
 //【文件名】View.cpp
 //【功能模块和目的】用户界面类的实现，负责所有的用户交互和显示功能
 //【开发者及日期】李孟涵 2025年7月30日
-//【更改记录】无
+//【更改记录】2026年10月19日 网络信息中显示分层计时结果
+//【更改记录】2026年10月19日 网络信息中显示内存占用
 //-------------------------------------------------------------------------------------------------------------------
 
 #include <iomanip>  // 格式化输出头文件
@@ -188,6 +189,68 @@ void View::showProgress(const std::string& message) {
 //-------------------------------------------------------------------------------------------------------------------
 void View::showNetworkInfo(const Network& network) {
     network.showInfo();
+    showMemoryUsage(network.memoryUsage());
+    if (Profiler::isEnabled()) {
+        showProfile(Profiler::getNetworkProfile(network));
+    }
+}
+
+void View::showProfile(const NetworkProfile& profile) {
+    std::cout << std::endl << CYAN << "⏱️ 分层计时:" << RESET << std::endl;
+    if (profile.forwardCalls == 0) {
+        std::cout << "  尚未执行前向传播" << std::endl;
+        return;
+    }
+    std::ios::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    std::cout << "  forward: " << profile.forwardCalls << " 次, 共 " << std::fixed << std::setprecision(3)
+              << profile.forwardSeconds * 1e3 << " ms, " << std::setprecision(1)
+              << profile.forwardsPerSecond << " 次/秒" << std::endl;
+    // setw按字节计宽，每个汉字3字节但只占2列，因此表头宽度加上汉字个数
+    std::cout << "  " << std::setw(4 + 1) << "层" << std::setw(8 + 3) << "神经元" << std::setw(10 + 2) << "调用"
+              << std::setw(12 + 2) << "耗时(ms)" << std::setw(10 + 2) << "占比" << std::setw(12 + 2) << "次/秒"
+              << std::setw(14 + 2) << "突触/秒" << std::endl;
+    for (const auto& layer : profile.layers) {
+        std::cout << "  " << std::setw(4) << layer.index << std::setw(8) << layer.neuronCount
+                  << std::setw(10) << layer.calls << std::setw(12) << std::setprecision(3) << layer.seconds * 1e3
+                  << std::setw(9) << std::setprecision(1) << layer.share * 100.0 << "%"
+                  << std::setw(12) << layer.callsPerSecond
+                  << std::setw(14) << std::scientific << std::setprecision(2) << layer.synapsesPerSecond
+                  << std::fixed << std::endl;
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
+
+void View::showMemoryUsage(const MemoryUsage& usage) {
+    std::cout << std::endl << CYAN << "💾 内存占用:" << RESET << std::endl;
+    std::ios::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    // setw按字节计宽，每个汉字3字节但只占2列，因此表头宽度加上汉字个数
+    std::cout << "  " << std::setw(4 + 1) << "层" << std::setw(8 + 3) << "神经元" << std::setw(10 + 2) << "突触"
+              << std::setw(12 + 3) << "神经元(B)" << std::setw(12 + 2) << "突触(B)" << std::setw(12 + 2) << "指针(B)"
+              << std::setw(12 + 2) << "输入(B)" << std::setw(12 + 3) << "分配器(B)" << std::setw(12 + 2) << "合计(B)"
+              << std::setw(12 + 2) << "紧凑(B)" << std::endl;
+    std::vector<LayerMemoryUsage> rows = usage.layers;
+    rows.push_back(usage.totals);
+    for (const auto& layer : rows) {
+        std::cout << "  ";
+        if (layer.index < 0) {
+            std::cout << std::setw(4 + 2) << "合计";
+        } else {
+            std::cout << std::setw(4) << layer.index;
+        }
+        std::cout << std::setw(8) << layer.neuronCount << std::setw(10) << layer.synapseCount
+                  << std::setw(12) << layer.neuronBytes << std::setw(12) << layer.synapseBytes
+                  << std::setw(12) << layer.synapsePointerBytes << std::setw(12) << layer.inputBufferBytes
+                  << std::setw(12) << layer.allocatorOverheadBytes << std::setw(12) << layer.totalBytes
+                  << std::setw(12) << layer.compactBytes << std::endl;
+    }
+    std::cout << "  总计 " << usage.totalBytes << " 字节（" << usage.totals.allocationCount << " 次堆分配），紧凑表示 "
+              << usage.compactBytes << " 字节，" << std::fixed << std::setprecision(1) << usage.ratio << " 倍"
+              << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
 }
 
 void View::showLayerInfo(const Network& network, int layerIndex) {
@@ -2,7 +2,8 @@
 //【文件名】View.hpp
 //【功能模块和目的】用户界面类的声明，负责所有的用户交互和显示功能
 //【开发者及日期】李孟涵 2025年7月30日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加分层计时结果的显示
+//【更改记录】2026年10月19日 增加内存占用的显示
 //-------------------------------------------------------------------------------------------------------------------
 
 #ifndef VIEW_HPP
@@ -12,6 +13,7 @@
 #include <vector>// vector所在头文件
 
 #include "Network.hpp" // 网络类头文件
+#include "Profiler.hpp" // 分层计时
 
 //-------------------------------------------------------------------------------------------------------------------
 //【类名】View
@@ -44,7 +46,9 @@
 //  - void showInfoMessage(const std::string& message): 显示一般信息
 //  - void showProgress(const std::string& message): 显示进度信息
 //  网络信息显示方法：
-//  - void showNetworkInfo(const Network& network): 显示网络信息
+//  - void showNetworkInfo(const Network& network): 显示网络信息和内存占用（编译时定义CANN_PROFILE则同时显示分层计时）
+//  - void showProfile(const NetworkProfile& profile): 显示分层计时结果
+//  - void showMemoryUsage(const MemoryUsage& usage): 显示内存占用
 //  - void showLayerInfo(const Network& network, int layerIndex): 显示层信息
 //  - void showAllLayersInfo(const Network& network): 显示所有层信息
 //  - void showForwardPropagationResult(const std::vector<std::vector<double>>& output): 显示前向传播结果
@@ -52,7 +56,8 @@
 //  操作提示方法：各种对话框显示方法
 //  - void showGoodbye(): 显示再见信息
 //【开发者及日期】李孟涵 2025年7月30日
-//【更改记录】无
+//【更改记录】2026年10月19日 增加showProfile
+//【更改记录】2026年10月19日 增加showMemoryUsage
 //-------------------------------------------------------------------------------------------------------------------
 class View {
 public:
@@ -89,6 +94,8 @@ public:
     
     // 网络信息显示方法
     void showNetworkInfo(const Network& network);
+    void showProfile(const NetworkProfile& profile);
+    void showMemoryUsage(const MemoryUsage& usage);
     void showLayerInfo(const Network& network, int layerIndex);
     void showAllLayersInfo(const Network& network);
     void showForwardPropagationResult(const std::vector<std::vector<double>>& output);
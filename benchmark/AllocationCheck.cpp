@@ -0,0 +1,130 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】AllocationCheck.cpp
+//【功能模块和目的】零分配检查程序：须以 -DCANN_COUNT_ALLOCS 编译。对若干形状的网络预热后，统计各推理路径
+//                  单次调用的堆分配次数和字节数，并要求Network::forward的缓冲区重载在稳定状态下不分配内存，
+//                  违反时以状态码1退出，可放在持续集成中及早发现分配回归
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 同样要求Network::infer的工作区重载在稳定状态下不分配内存
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BenchmarkUtil.hpp"         // 基准测试公用工具
+#include "../AllocationCounter.hpp"  // 分配计数类头文件
+#include "../CompiledNetwork.hpp"    // 稀疏推理网络类头文件
+#include "../Network.hpp"            // 网络类头文件
+#include <functional>                // std::function
+#include <iomanip>                   // 输出格式控制
+#include <iostream>                  // 输入输出流头文件
+#include <memory>                    // 智能指针
+#include <stdexcept>                 // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】buildNetwork
+//【函数功能】构造宽度为width、共depth层的全连接网络，第一层为线性，其余为Sigmoid，权重取确定的小数值
+//【参数】width - 层宽，depth - 层数
+//【返回值】std::unique_ptr<Network> - 构造的网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static std::unique_ptr<Network> buildNetwork(int width, int depth) {
+    std::unique_ptr<Network> network(new Network());
+    for (int l = 0; l < depth; ++l) {
+        network->addLayer(new Layer(network.get(), width, std::vector<double>(width, 0.1), l == 0 ? 0 : 1));
+    }
+    for (int l = 1; l < depth; ++l) {
+        std::vector<std::vector<double>> weights(width, std::vector<double>(width));
+        for (int i = 0; i < width; ++i) {
+            for (int j = 0; j < width; ++j) {
+                weights[i][j] = ((i * 7 + j * 3) % 11 - 5) / (10.0 * width);
+            }
+        }
+        network->setWeights(l, weights);
+    }
+    return network;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】measure
+//【函数功能】预热operation若干次后，统计再调用iterations次的平均分配次数和字节数并输出一行
+//【参数】name - 路径名称，operation - 被测操作，iterations - 统计的调用次数
+//【返回值】AllocationStats - iterations次调用的分配计数合计
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static AllocationStats measure(const std::string& name, const std::function<void()>& operation, int iterations) {
+    for (int i = 0; i < 3; ++i) {
+        operation();
+    }
+    AllocationScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        operation();
+    }
+    AllocationStats stats = scope.getStats();
+    std::cout << "  " << std::left << std::setw(36) << name << std::right << std::setw(10)
+              << static_cast<double>(stats.allocations) / iterations << " allocs/op" << std::setw(12)
+              << static_cast<double>(stats.bytes) / iterations << " bytes/op" << std::endl;
+    return stats;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】main
+//【函数功能】程序入口，参数 --widths=4,64 --depths=2,4 --iterations=100
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】int - 0表示通过，1表示出现分配或出错
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    try {
+        std::vector<int> widths = { 4, 64 };
+        std::vector<int> depths = { 2, 4 };
+        int iterations = 100;
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            size_t equals = argument.find('=');
+            std::string key = argument.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+            if (key == "--widths") {
+                widths = parseIntegerList(value);
+            } else if (key == "--depths") {
+                depths = parseIntegerList(value);
+            } else if (key == "--iterations") {
+                iterations = std::stoi(value);
+            } else {
+                throw std::invalid_argument("Unknown option: " + argument);
+            }
+        }
+        if (!AllocationCounter::isEnabled()) {
+            throw std::runtime_error("AllocationCheck must be compiled with -DCANN_COUNT_ALLOCS");
+        }
+        bool passed = true;
+        for (int depth : depths) {
+            for (int width : widths) {
+                std::cout << "width " << width << ", depth " << depth << ":" << std::endl;
+                std::unique_ptr<Network> network = buildNetwork(width, depth);
+                CompiledNetwork compiled(*network);
+                std::vector<double> input(width, 0.5);
+                std::vector<std::vector<double>> outputs;
+                measure("Network::forward (returned)", [&]() { doNotOptimize(network->forward(input)); }, iterations);
+                measure("CompiledNetwork::forward", [&]() { doNotOptimize(compiled.forward(input)); }, iterations);
+                AllocationStats steady = measure("Network::forward (buffer)",
+                                                 [&]() { network->forward(input, outputs); }, iterations);
+                if (steady.allocations != 0) {
+                    std::cerr << "Error: Network::forward (buffer) allocates in steady state.\n";
+                    passed = false;
+                }
+                InferenceContext context;
+                AllocationStats reentrant = measure("Network::infer (context)",
+                                                    [&]() { network->infer(input, context); }, iterations);
+                if (reentrant.allocations != 0) {
+                    std::cerr << "Error: Network::infer (context) allocates in steady state.\n";
+                    passed = false;
+                }
+            }
+        }
+        std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+        return passed ? 0 : 1;
+    } catch (const std::exception& exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,459 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】BenchmarkBaseline.hpp
+//【功能模块和目的】基准测试基线的读取与比较：解析基准测试输出的JSON，按测试键匹配基线与本次结果，
+//                  以Welch t检验的95%置信区间判断性能变化是否显著，并给出回归时的退出状态
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 任一方样本少于2个时判为inconclusive，不作为回归
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef BENCHMARK_BASELINE_HPP
+#define BENCHMARK_BASELINE_HPP
+
+#include "BenchmarkUtil.hpp" // 基准测试公用工具
+#include <cctype>            // 字符分类
+#include <fstream>           // 文件流头文件
+#include <iomanip>           // 输出格式控制
+#include <map>               // map所属头文件
+#include <memory>            // 智能指针
+#include <ostream>           // 输出流
+#include <stdexcept>         // 标准异常头文件
+#include <string>            // 字符串所属头文件
+#include <vector>            // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】JsonValue
+//【功能】JSON值的简单表示，只用于读取基准测试自身输出的文件
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct JsonValue {
+    enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+    Type type = Type::NUL;                      // 值类型
+    bool boolean = false;                       // 布尔值
+    double number = 0.0;                        // 数值
+    std::string text;                           // 字符串
+    std::vector<JsonValue> items;               // 数组元素
+    std::map<std::string, JsonValue> members;   // 对象成员
+
+    const JsonValue* find(const std::string& key) const {
+        auto it = members.find(key);
+        return it == members.end() ? nullptr : &it->second;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】JsonParser
+//【功能】递归下降的JSON解析器，格式错误时抛出std::runtime_error
+//【接口说明】
+//  - explicit JsonParser(const std::string& text): 构造函数
+//  - JsonValue parse(): 解析整个文本
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text(text), position(0) {}
+
+    JsonValue parse() {
+        JsonValue value = parseValue();
+        skipSpace();
+        if (position != text.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    void fail(const std::string& message) const {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(position) + ": " + message);
+    }
+
+    void skipSpace() {
+        while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+            ++position;
+        }
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (position >= text.size() || text[position] != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++position;
+    }
+
+    bool consume(const std::string& word) {
+        if (text.compare(position, word.size(), word) == 0) {
+            position += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string result;
+        while (position < text.size() && text[position] != '"') {
+            char c = text[position++];
+            if (c == '\\') {
+                if (position >= text.size()) {
+                    fail("unterminated escape");
+                }
+                char escaped = text[position++];
+                switch (escaped) {
+                    case 'n': result += '\n'; break;
+                    case 't': result += '\t'; break;
+                    case 'r': result += '\r'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'u': {
+                        if (position + 4 > text.size()) {
+                            fail("bad unicode escape");
+                        }
+                        unsigned code = static_cast<unsigned>(std::stoul(text.substr(position, 4), nullptr, 16));
+                        position += 4;
+                        result += code < 0x80 ? static_cast<char>(code) : '?'; // 只需要支持控制字符
+                        break;
+                    }
+                    default: result += escaped;
+                }
+            } else {
+                result += c;
+            }
+        }
+        expect('"');
+        return result;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (position >= text.size()) {
+            fail("unexpected end");
+        }
+        JsonValue value;
+        char c = text[position];
+        if (c == '{') {
+            value.type = JsonValue::Type::OBJECT;
+            ++position;
+            skipSpace();
+            if (position < text.size() && text[position] == '}') {
+                ++position;
+                return value;
+            }
+            while (true) {
+                skipSpace();
+                std::string key = parseString();
+                expect(':');
+                value.members[key] = parseValue();
+                skipSpace();
+                if (position < text.size() && text[position] == ',') {
+                    ++position;
+                    continue;
+                }
+                expect('}');
+                return value;
+            }
+        }
+        if (c == '[') {
+            value.type = JsonValue::Type::ARRAY;
+            ++position;
+            skipSpace();
+            if (position < text.size() && text[position] == ']') {
+                ++position;
+                return value;
+            }
+            while (true) {
+                value.items.push_back(parseValue());
+                skipSpace();
+                if (position < text.size() && text[position] == ',') {
+                    ++position;
+                    continue;
+                }
+                expect(']');
+                return value;
+            }
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::STRING;
+            value.text = parseString();
+            return value;
+        }
+        if (consume("true") || consume("false")) {
+            value.type = JsonValue::Type::BOOLEAN;
+            value.boolean = text[position - 1] == 'e' && text[position - 2] == 'u';
+            return value;
+        }
+        if (consume("null")) {
+            return value;
+        }
+        size_t end = position;
+        while (end < text.size() && (std::isdigit(static_cast<unsigned char>(text[end])) ||
+               text[end] == '-' || text[end] == '+' || text[end] == '.' || text[end] == 'e' || text[end] == 'E')) {
+            ++end;
+        }
+        if (end == position) {
+            fail("unexpected character");
+        }
+        value.type = JsonValue::Type::NUMBER;
+        value.number = std::stod(text.substr(position, end - position));
+        position = end;
+        return value;
+    }
+
+    const std::string& text; // 待解析文本
+    size_t position;         // 当前位置
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】BaselineEntry
+//【功能】一项测试的全部重复测量值。key唯一标识一项测试，samples为每次测量的单次操作耗时（越小越好）
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct BaselineEntry {
+    std::string key;              // 测试键
+    std::vector<double> samples;  // 每次测量的单次操作耗时
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】loadBaseline
+//【函数功能】读取基准测试输出的JSON文件，取出results数组中每一项的key和samples
+//【参数】path - 文件路径
+//【返回值】std::vector<BaselineEntry> - 基线中的全部测试
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline std::vector<BaselineEntry> loadBaseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open baseline: " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    JsonValue root = JsonParser(text).parse();
+    const JsonValue* results = root.find("results");
+    if (results == nullptr || results->type != JsonValue::Type::ARRAY) {
+        throw std::runtime_error("Baseline has no results array: " + path);
+    }
+    std::vector<BaselineEntry> entries;
+    for (const auto& item : results->items) {
+        const JsonValue* key = item.find("key");
+        const JsonValue* samples = item.find("samples");
+        if (key == nullptr || samples == nullptr || samples->type != JsonValue::Type::ARRAY) {
+            throw std::runtime_error("Baseline result without key or samples: " + path);
+        }
+        BaselineEntry entry;
+        entry.key = key->text;
+        for (const auto& sample : samples->items) {
+            entry.samples.push_back(sample.number);
+        }
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】studentT975
+//【函数功能】自由度为df的t分布0.975分位数（双侧95%置信区间），按1/df在常用表值之间线性插值
+//【参数】df - 自由度
+//【返回值】double - 分位数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline double studentT975(double df) {
+    static const double table[][2] = {
+        { 1, 12.706 }, { 2, 4.303 }, { 3, 3.182 }, { 4, 2.776 }, { 5, 2.571 }, { 6, 2.447 },
+        { 7, 2.365 }, { 8, 2.306 }, { 9, 2.262 }, { 10, 2.228 }, { 12, 2.179 }, { 15, 2.131 },
+        { 20, 2.086 }, { 30, 2.042 }, { 60, 2.000 }, { 120, 1.980 },
+    };
+    const int count = sizeof(table) / sizeof(table[0]);
+    if (df <= table[0][0]) {
+        return table[0][1];
+    }
+    for (int i = 1; i < count; ++i) {
+        if (df <= table[i][0]) {
+            double t = (1.0 / table[i - 1][0] - 1.0 / df) / (1.0 / table[i - 1][0] - 1.0 / table[i][0]);
+            return table[i - 1][1] + t * (table[i][1] - table[i - 1][1]);
+        }
+    }
+    double t = (1.0 / table[count - 1][0] - 1.0 / df) / (1.0 / table[count - 1][0]);
+    return table[count - 1][1] + t * (1.960 - table[count - 1][1]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ComparisonResult
+//【功能】一项测试与基线的比较结果。change为均值的相对变化，[changeLow, changeHigh]为其95%置信区间，
+//        status为"regression"、"improvement"、"unchanged"、"inconclusive"、"new"或"missing"
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加inconclusive
+//-------------------------------------------------------------------------------------------------------------------
+struct ComparisonResult {
+    std::string key;            // 测试键
+    double baselineMean = 0.0;  // 基线均值
+    double currentMean = 0.0;   // 本次均值
+    double change = 0.0;        // 相对变化
+    double changeLow = 0.0;     // 相对变化的置信下限
+    double changeHigh = 0.0;    // 相对变化的置信上限
+    std::string status;         // 比较结论
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】BaselineComparator
+//【功能】按测试键比较本次结果与基线。耗时差的置信区间由Welch t检验给出（两组方差不必相等），
+//        只有置信下限超过阈值时才判为回归，置信上限低于负阈值时判为改进，避免把噪声当作回归。
+//        任一方样本少于2个时无法估计方差，判为inconclusive，只报告均值变化
+//【接口说明】
+//  - BaselineComparator(double threshold, const std::vector<std::string>& filters): 构造函数，
+//    threshold为相对变化阈值（如0.05），filters非空时只比较键中包含任一子串的测试
+//  - std::vector<ComparisonResult> compare(...) const: 比较基线和本次结果
+//  - static bool hasRegression(...): 是否存在回归
+//  - static void print(...): 输出比较表格
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 样本不足时判为inconclusive
+//-------------------------------------------------------------------------------------------------------------------
+class BaselineComparator {
+public:
+    BaselineComparator(double threshold, const std::vector<std::string>& filters)
+        : threshold(threshold), filters(filters) {}
+
+    std::vector<ComparisonResult> compare(const std::vector<BaselineEntry>& baseline,
+                                          const std::vector<BaselineEntry>& current) const {
+        std::map<std::string, const BaselineEntry*> baselineByKey;
+        for (const auto& entry : baseline) {
+            baselineByKey[entry.key] = &entry;
+        }
+        std::vector<ComparisonResult> results;
+        for (const auto& entry : current) {
+            if (!selected(entry.key)) {
+                continue;
+            }
+            ComparisonResult result;
+            result.key = entry.key;
+            SampleStatistics now = computeStatistics(entry.samples);
+            result.currentMean = now.mean;
+            auto it = baselineByKey.find(entry.key);
+            if (it == baselineByKey.end()) {
+                result.status = "new";
+                results.push_back(result);
+                continue;
+            }
+            SampleStatistics before = computeStatistics(it->second->samples);
+            const double n0 = static_cast<double>(it->second->samples.size());
+            const double n1 = static_cast<double>(entry.samples.size());
+            baselineByKey.erase(it);
+            result.baselineMean = before.mean;
+            if (before.mean <= 0.0) {
+                result.status = "unchanged";
+                results.push_back(result);
+                continue;
+            }
+            double difference = now.mean - before.mean;
+            result.change = difference / before.mean;
+            if (n0 < 2 || n1 < 2) {// 单个样本无法区分变化与噪声
+                result.status = "inconclusive";
+                results.push_back(result);
+                continue;
+            }
+            // Welch t检验：两组均值差的标准误和Welch-Satterthwaite自由度
+            double v0 = before.stddev * before.stddev / n0;
+            double v1 = now.stddev * now.stddev / n1;
+            double standardError = std::sqrt(v0 + v1);
+            double margin = 0.0;
+            if (standardError > 0.0) {
+                double df = (v0 + v1) * (v0 + v1) / (v0 * v0 / (n0 - 1) + v1 * v1 / (n1 - 1));
+                margin = studentT975(df) * standardError;
+            }
+            result.changeLow = (difference - margin) / before.mean;
+            result.changeHigh = (difference + margin) / before.mean;
+            if (result.changeLow > threshold) {
+                result.status = "regression";
+            } else if (result.changeHigh < -threshold) {
+                result.status = "improvement";
+            } else {
+                result.status = "unchanged";
+            }
+            results.push_back(result);
+        }
+        for (const auto& entry : baselineByKey) {
+            if (selected(entry.first)) {
+                ComparisonResult result;
+                result.key = entry.first;
+                result.baselineMean = computeStatistics(entry.second->samples).mean;
+                result.status = "missing";
+                results.push_back(result);
+            }
+        }
+        return results;
+    }
+
+    static bool hasRegression(const std::vector<ComparisonResult>& results) {
+        for (const auto& result : results) {
+            if (result.status == "regression") {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void print(std::ostream& stream, const std::vector<ComparisonResult>& results) const {
+        stream << "\ncomparison with baseline (threshold " << threshold * 100.0 << "%, 95% confidence):\n";
+        stream << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "baseline"
+               << std::setw(14) << "current" << std::setw(10) << "change" << std::setw(22) << "95% CI"
+               << "  status\n";
+        for (const auto& result : results) {
+            stream << std::left << std::setw(48) << result.key << std::right
+                   << std::setw(14) << std::scientific << std::setprecision(3) << result.baselineMean
+                   << std::setw(14) << result.currentMean << std::fixed << std::setprecision(1);
+            if (result.status == "new" || result.status == "missing") {
+                stream << std::setw(10) << "-" << std::setw(22) << "-";
+            } else if (result.status == "inconclusive") {
+                stream << std::setw(9) << result.change * 100.0 << "%" << std::setw(22) << "-";
+            } else {
+                std::ostringstream interval;
+                interval << std::fixed << std::setprecision(1) << "[" << result.changeLow * 100.0 << "%, "
+                         << result.changeHigh * 100.0 << "%]";
+                stream << std::setw(9) << result.change * 100.0 << "%" << std::setw(22) << interval.str();
+            }
+            stream << std::defaultfloat << "  " << result.status << "\n";
+        }
+    }
+
+private:
+    bool selected(const std::string& key) const {
+        if (filters.empty()) {
+            return true;
+        }
+        for (const auto& filter : filters) {
+            if (key.find(filter) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double threshold;                 // 相对变化阈值
+    std::vector<std::string> filters; // 键过滤子串
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseStringList
+//【函数功能】解析以逗号分隔的字符串列表
+//【参数】text - 列表字符串
+//【返回值】std::vector<std::string> - 字符串列表
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline std::vector<std::string> parseStringList(const std::string& text) {
+    std::vector<std::string> values;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(item);
+        }
+    }
+    return values;
+}
+
+#endif // BENCHMARK_BASELINE_HPP
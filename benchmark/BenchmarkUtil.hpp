@@ -0,0 +1,201 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】BenchmarkUtil.hpp
+//【功能模块和目的】基准测试公用工具：防止编译器消除被测代码、计时、样本统计、缓存清除和JSON字符串转义
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#ifndef BENCHMARK_UTIL_HPP
+#define BENCHMARK_UTIL_HPP
+
+#include <algorithm> // 算法库
+#include <chrono>    // 计时
+#include <cmath>     // 数学函数库
+#include <cstddef>   // size_t所属头文件
+#include <cstdio>    // snprintf
+#include <ctime>     // 时间戳
+#include <sstream>   // 字符串流
+#include <string>    // 字符串所属头文件
+#include <vector>    // vector所属头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】doNotOptimize
+//【函数功能】告诉编译器value被读取，防止被测计算被当作无用代码消除
+//【参数】value - 被测计算的结果
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】nowSeconds
+//【函数功能】读取单调时钟
+//【参数】无
+//【返回值】double - 以秒为单位的时间点
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】SampleStatistics
+//【功能】一组重复测量的统计量，cv为变异系数（标准差/均值），用于判断测量是否稳定
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+struct SampleStatistics {
+    double mean = 0.0;   // 均值
+    double stddev = 0.0; // 样本标准差
+    double min = 0.0;    // 最小值
+    double max = 0.0;    // 最大值
+    double cv = 0.0;     // 变异系数
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】computeStatistics
+//【函数功能】计算样本的均值、样本标准差、最值和变异系数
+//【参数】samples - 样本
+//【返回值】SampleStatistics - 统计量，样本为空时全为0
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline SampleStatistics computeStatistics(const std::vector<double>& samples) {
+    SampleStatistics statistics;
+    if (samples.empty()) {
+        return statistics;
+    }
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    statistics.mean = sum / samples.size();
+    double squares = 0.0;
+    for (double sample : samples) {
+        squares += (sample - statistics.mean) * (sample - statistics.mean);
+    }
+    statistics.stddev = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+    statistics.min = *std::min_element(samples.begin(), samples.end());
+    statistics.max = *std::max_element(samples.begin(), samples.end());
+    statistics.cv = statistics.mean > 0.0 ? statistics.stddev / statistics.mean : 0.0;
+    return statistics;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】CacheFlusher
+//【功能】通过读写一块大于末级缓存的缓冲区，把被测数据逐出CPU缓存，用于测量冷缓存下的性能
+//【接口说明】
+//  - explicit CacheFlusher(size_t bytes): 构造函数，分配缓冲区
+//  - void flush(): 遍历缓冲区的每条缓存行
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class CacheFlusher {
+public:
+    explicit CacheFlusher(size_t bytes = 64u << 20) : buffer(bytes, 1), counter(0) {}
+    void flush() {
+        ++counter;
+        for (size_t i = 0; i < buffer.size(); i += 64) {
+            buffer[i] = static_cast<char>(buffer[i] + counter);
+        }
+        doNotOptimize(buffer[counter % buffer.size()]);
+    }
+
+private:
+    std::vector<char> buffer; // 清除缓存用的缓冲区
+    size_t counter;           // 每次写入不同的值，避免写操作被优化
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】jsonString
+//【函数功能】把字符串转义为JSON字符串字面量（含引号）
+//【参数】text - 原字符串
+//【返回值】std::string - JSON字符串
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline std::string jsonString(const std::string& text) {
+    std::string result = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    result += escaped;
+                } else {
+                    result += c;
+                }
+        }
+    }
+    return result + "\"";
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】jsonNumber
+//【函数功能】把浮点数格式化为JSON数值，非有限值输出为null
+//【参数】value - 数值
+//【返回值】std::string - JSON数值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    std::ostringstream stream;
+    stream.precision(10);
+    stream << value;
+    return stream.str();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】currentTimestamp
+//【函数功能】获取当前UTC时间的ISO 8601字符串
+//【参数】无
+//【返回值】std::string - 时间戳
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline std::string currentTimestamp() {
+    std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseIntegerList
+//【函数功能】解析以逗号分隔的整数列表，如 "16,64,256"
+//【参数】text - 列表字符串
+//【返回值】std::vector<int> - 整数列表
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+inline std::vector<int> parseIntegerList(const std::string& text) {
+    std::vector<int> values;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::stoi(item));
+        }
+    }
+    return values;
+}
+
+#endif // BENCHMARK_UTIL_HPP
@@ -0,0 +1,110 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】GenerateModel.cpp
+//【功能模块和目的】合成模型生成程序：按命令行给出的层宽、激活函数比例、稀疏度和权重分布，
+//                  用ModelGenerator流式生成ANN文件，作为导入导出和前向传播基准测试的固定测试模型
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BenchmarkUtil.hpp"      // 基准测试公用工具
+#include "../ModelGenerator.hpp"  // 合成模型生成器类头文件
+#include <iostream>               // 输入输出流头文件
+#include <stdexcept>              // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseDoubleList
+//【函数功能】解析以逗号分隔的浮点数列表，如 "0,1,0,1"
+//【参数】text - 列表字符串
+//【返回值】std::vector<double> - 浮点数列表
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static std::vector<double> parseDoubleList(const std::string& text) {
+    std::vector<double> values;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::stod(item));
+        }
+    }
+    return values;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseOptions
+//【函数功能】解析命令行参数，格式为 --key=value，布尔参数可省略取值
+//【参数】argc - 参数个数，argv - 参数列表，output - 输出文件路径
+//【返回值】ModelSpec - 模型描述
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static ModelSpec parseOptions(int argc, char* argv[], std::string& output) {
+    ModelSpec spec;
+    spec.widths = { 784, 256, 10 };
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--output") {
+            output = value;
+        } else if (key == "--name") {
+            spec.name = value;
+        } else if (key == "--widths") {
+            spec.widths = parseIntegerList(value);
+        } else if (key == "--activations") {
+            spec.activationMix = parseDoubleList(value);
+        } else if (key == "--mix-per-neuron") {
+            spec.mixPerNeuron = value != "0";
+        } else if (key == "--sparsity") {
+            spec.sparsity = std::stod(value);
+        } else if (key == "--zero-fill") {
+            spec.writePrunedAsZero = value != "0";
+        } else if (key == "--distribution") {
+            spec.weightDistribution = value;
+        } else if (key == "--scale") {
+            spec.weightScale = std::stod(value);
+        } else if (key == "--fan-in-scale") {
+            spec.scaleByFanIn = value != "0";
+        } else if (key == "--bias-scale") {
+            spec.biasScale = std::stod(value);
+        } else if (key == "--seed") {
+            spec.seed = std::stoull(value);
+        } else if (key == "--precision") {
+            spec.precision = std::stoi(value);
+        } else {
+            throw std::invalid_argument("Unknown option: " + argument);
+        }
+    }
+    if (output.empty()) {
+        throw std::invalid_argument("Missing --output=path.ANN");
+    }
+    return spec;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】main
+//【函数功能】模型生成程序入口，生成后输出神经元数、突触数、文件大小和耗时
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】int - 程序退出状态码
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    try {
+        std::string output;
+        ModelSpec spec = parseOptions(argc, argv, output);
+        ModelGenerator generator(output);
+        double start = nowSeconds();
+        ModelGenerationReport report = generator.generate(spec);
+        double seconds = nowSeconds() - start;
+        std::cout << output << ": " << report.neuronCount << " neurons, " << report.synapseCount << " of "
+                  << report.denseSynapseCount << " synapses, " << report.bytes << " bytes, "
+                  << seconds << " s\n";
+    } catch (const std::exception& exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
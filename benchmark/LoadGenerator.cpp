@@ -0,0 +1,169 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】LoadGenerator.cpp
+//【功能模块和目的】本机推理服务的负载生成程序（仅Linux）：启动若干客户端进程，每个进程建立一个连接
+//                  并连续发送随机样本，统计总吞吐量和请求延迟分位数，用于观察动态批处理的效果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BenchmarkUtil.hpp"        // 基准测试公用工具
+#include "../InferenceClient.hpp"   // 推理客户端类头文件
+#include <algorithm>                // std::sort
+#include <iostream>                 // 输入输出流头文件
+#include <random>                   // 随机数
+#include <stdexcept>                // 标准异常头文件
+
+#ifdef __linux__
+#include <sys/wait.h>               // waitpid
+#include <unistd.h>                 // fork、pipe
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】runClient
+//【函数功能】客户端进程：发送requests个随机样本，把每个请求的延迟（秒）写入管道
+//【参数】socketPath - 服务套接字路径，requests - 请求数，seed - 随机种子，pipeFd - 结果管道写端
+//【返回值】int - 进程退出状态码
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static int runClient(const std::string& socketPath, int requests, unsigned seed, int pipeFd) {
+#ifdef __linux__
+    try {
+        InferenceClient client(socketPath);
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::vector<double> input(client.getInputSize());
+        std::vector<double> latencies;
+        latencies.reserve(requests);
+        for (int i = 0; i < requests; ++i) {
+            for (auto& value : input) {
+                value = distribution(random);
+            }
+            double start = nowSeconds();
+            doNotOptimize(client.infer(input));
+            latencies.push_back(nowSeconds() - start);
+        }
+        size_t bytes = latencies.size() * sizeof(double);
+        const char* data = reinterpret_cast<const char*>(latencies.data());
+        while (bytes > 0) {
+            ssize_t written = write(pipeFd, data, bytes);
+            if (written <= 0) {
+                return 1;
+            }
+            data += written;
+            bytes -= static_cast<size_t>(written);
+        }
+        return 0;
+    } catch (const std::exception& exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+#else
+    (void)socketPath;
+    (void)requests;
+    (void)seed;
+    (void)pipeFd;
+    return 1;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】main
+//【函数功能】程序入口，参数 --socket=/tmp/cann.sock --clients=8 --requests=10000（每个客户端）
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】int - 程序退出状态码
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+#ifdef __linux__
+    try {
+        std::string socketPath = "/tmp/cann.sock";
+        int clients = 8;
+        int requests = 10000;
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            size_t equals = argument.find('=');
+            std::string key = argument.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+            if (key == "--socket") {
+                socketPath = value;
+            } else if (key == "--clients") {
+                clients = std::stoi(value);
+            } else if (key == "--requests") {
+                requests = std::stoi(value);
+            } else {
+                throw std::invalid_argument("Unknown option: " + argument);
+            }
+        }
+        if (clients <= 0 || requests <= 0) {
+            throw std::invalid_argument("--clients and --requests must be positive");
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        std::vector<pid_t> workers;
+        std::vector<int> pipes;
+        const double start = nowSeconds();
+        for (int c = 0; c < clients; ++c) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                throw std::runtime_error("Failed to create pipe");
+            }
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(fds[0]);
+                _exit(runClient(socketPath, requests, 1000u + static_cast<unsigned>(c), fds[1]));
+            }
+            close(fds[1]);
+            if (pid < 0) {
+                close(fds[0]);
+                throw std::runtime_error("Failed to fork client process");
+            }
+            workers.push_back(pid);
+            pipes.push_back(fds[0]);
+        }
+        std::vector<double> latencies;
+        bool failed = false;
+        for (int c = 0; c < clients; ++c) {
+            std::vector<double> received(requests);
+            size_t total = 0;
+            char* data = reinterpret_cast<char*>(received.data());
+            ssize_t result = 0;
+            while (total < received.size() * sizeof(double)
+                   && (result = read(pipes[c], data + total, received.size() * sizeof(double) - total)) > 0) {
+                total += static_cast<size_t>(result);
+            }
+            close(pipes[c]);
+            int status = 0;
+            waitpid(workers[c], &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || total != received.size() * sizeof(double)) {
+                failed = true;
+                continue;
+            }
+            latencies.insert(latencies.end(), received.begin(), received.end());
+        }
+        const double seconds = nowSeconds() - start;
+        if (failed) {
+            throw std::runtime_error("Some client processes failed");
+        }
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p) {
+            return latencies[static_cast<size_t>(p * (latencies.size() - 1))] * 1e6;
+        };
+        SampleStatistics statistics = computeStatistics(latencies);
+        std::cout << clients << " clients x " << requests << " requests: " << latencies.size() / seconds
+                  << " requests/s over " << seconds << " s" << std::endl;
+        std::cout << "latency us: mean " << statistics.mean * 1e6 << ", p50 " << percentile(0.5) << ", p90 "
+                  << percentile(0.9) << ", p99 " << percentile(0.99) << ", max " << percentile(1.0) << std::endl;
+    } catch (const std::exception& exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+#else
+    (void)argc;
+    (void)argv;
+    std::cerr << "Error: The load generator is only supported on Linux." << std::endl;
+    return 1;
+#endif
+}
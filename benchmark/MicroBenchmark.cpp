@@ -0,0 +1,431 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】MicroBenchmark.cpp
+//【功能模块和目的】核心计算路径的微基准测试程序：Soma::updateOutput、Neuron::updateOutput、
+//                  Layer::updateOutputs、各激活函数及Network::forward，按层宽和层数参数化，
+//                  输出每次操作耗时（ns/op）、突触吞吐量、热/冷缓存两种情形及方差，并可输出JSON
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加基线保存与比较，存在显著回归时以状态码2退出
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BenchmarkBaseline.hpp"  // 基准测试基线的读取与比较
+#include "BenchmarkUtil.hpp"      // 基准测试公用工具
+#include "../ActivationFunc.hpp"  // 激活函数类头文件
+#include "../Network.hpp"         // 网络类头文件
+#include <fstream>                // 文件流头文件
+#include <iomanip>                // 输出格式控制
+#include <iostream>               // 输入输出流头文件
+#include <iterator>               // std::next
+#include <memory>                 // 智能指针
+#include <random>                 // 随机数
+#include <stdexcept>              // 标准异常头文件
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】MicroBenchmarkOptions
+//【功能】微基准测试的运行参数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加基线比较参数
+//-------------------------------------------------------------------------------------------------------------------
+struct MicroBenchmarkOptions {
+    std::vector<int> widths = { 16, 64, 256 }; // 层宽
+    std::vector<int> depths = { 2, 4, 8 };     // 层数（仅用于Network::forward）
+    int repetitions = 10;                      // 每项重复测量次数
+    double minSampleSeconds = 0.01;            // 热缓存下每次测量的最短时间
+    int coldIterations = 20;                   // 冷缓存下每次测量执行的操作数
+    std::string jsonPath;                      // JSON输出路径，"-"为标准输出，空为不输出
+    std::string baselinePath;                  // 作为基线比较的JSON文件，空为不比较
+    double threshold = 0.05;                   // 判为回归的相对变化阈值
+    std::vector<std::string> gates;            // 只比较名称中包含这些子串的测试，空为全部
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】MicroBenchmarkResult
+//【功能】一项微基准测试的结果。name、cache、width、depth共同唯一标识一项测试
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 保留原始样本，用于与基线比较
+//-------------------------------------------------------------------------------------------------------------------
+struct MicroBenchmarkResult {
+    std::string name;          // 被测函数
+    std::string cache;         // "warm"或"cold"
+    int width = 0;             // 层宽（不适用时为0）
+    int depth = 0;             // 层数（不适用时为0）
+    double synapsesPerOp = 0;  // 每次操作处理的突触数（不适用时为0）
+    long long iterations = 0;  // 每次测量的操作数
+    int repetitions = 0;       // 测量次数
+    SampleStatistics nsPerOp;  // 每次操作耗时的统计量
+    std::vector<double> samples; // 每次测量的单次操作耗时
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】MicroBenchmarkRunner
+//【功能】执行并记录微基准测试。热缓存测试先预热，再倍增操作次数直到单次测量不短于minSampleSeconds，
+//        然后重复测量；冷缓存测试在每次操作前清除CPU缓存，只对操作本身计时
+//【接口说明】
+//  - explicit MicroBenchmarkRunner(const MicroBenchmarkOptions& options): 构造函数
+//  - void runWarm(...): 执行热缓存测试，itemsPerOp为一次调用包含的操作数
+//  - void runCold(...): 执行冷缓存测试
+//  - void printTable(std::ostream& stream) const: 输出可读表格
+//  - void writeJson(std::ostream& stream) const: 输出JSON，每项结果带有key和原始样本，可直接作为基线
+//  - std::vector<BaselineEntry> getBaselineEntries() const: 获取用于基线比较的结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 JSON增加key和samples字段，增加getBaselineEntries
+//-------------------------------------------------------------------------------------------------------------------
+class MicroBenchmarkRunner {
+public:
+    explicit MicroBenchmarkRunner(const MicroBenchmarkOptions& options) : options(options) {}
+
+    template <typename Operation>
+    void runWarm(const std::string& name, int width, int depth, double synapsesPerOp, int itemsPerOp, Operation operation) {
+        for (int i = 0; i < 3; ++i) {// 预热
+            operation();
+        }
+        long long iterations = 1;
+        while (iterations < (1LL << 30)) {// 校准每次测量的操作次数
+            double start = nowSeconds();
+            for (long long i = 0; i < iterations; ++i) {
+                operation();
+            }
+            if (nowSeconds() - start >= options.minSampleSeconds) {
+                break;
+            }
+            iterations *= 2;
+        }
+        std::vector<double> samples;
+        for (int r = 0; r < options.repetitions; ++r) {
+            double start = nowSeconds();
+            for (long long i = 0; i < iterations; ++i) {
+                operation();
+            }
+            samples.push_back((nowSeconds() - start) * 1e9 / (static_cast<double>(iterations) * itemsPerOp));
+        }
+        record(name, "warm", width, depth, synapsesPerOp, iterations * itemsPerOp, samples);
+    }
+
+    template <typename Operation>
+    void runCold(const std::string& name, int width, int depth, double synapsesPerOp, Operation operation) {
+        std::vector<double> samples;
+        for (int r = 0; r < options.repetitions; ++r) {
+            double total = 0.0;
+            for (int i = 0; i < options.coldIterations; ++i) {
+                flusher.flush();
+                double start = nowSeconds();
+                operation();
+                total += nowSeconds() - start;
+            }
+            samples.push_back(total * 1e9 / options.coldIterations);
+        }
+        record(name, "cold", width, depth, synapsesPerOp, options.coldIterations, samples);
+    }
+
+    void printTable(std::ostream& stream) const {
+        stream << std::left << std::setw(28) << "benchmark" << std::setw(6) << "cache"
+               << std::right << std::setw(7) << "width" << std::setw(7) << "depth"
+               << std::setw(14) << "ns/op" << std::setw(10) << "cv%" << std::setw(16) << "synapses/s" << "\n";
+        for (const auto& result : results) {
+            stream << std::left << std::setw(28) << result.name << std::setw(6) << result.cache
+                   << std::right << std::setw(7) << result.width << std::setw(7) << result.depth
+                   << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp.mean
+                   << std::setw(10) << std::setprecision(1) << result.nsPerOp.cv * 100.0
+                   << std::setw(16) << std::scientific << std::setprecision(3) << synapsesPerSecond(result)
+                   << std::defaultfloat << "\n";
+        }
+    }
+
+    void writeJson(std::ostream& stream) const {
+        stream << "{\n  \"schema\": \"cann-microbenchmark/1\",\n";
+        stream << "  \"timestamp\": " << jsonString(currentTimestamp()) << ",\n";
+#ifdef __VERSION__
+        stream << "  \"compiler\": " << jsonString(__VERSION__) << ",\n";
+#endif
+        stream << "  \"config\": {\"repetitions\": " << options.repetitions
+               << ", \"min_sample_seconds\": " << jsonNumber(options.minSampleSeconds)
+               << ", \"cold_iterations\": " << options.coldIterations << "},\n";
+        stream << "  \"results\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            stream << (i == 0 ? "\n" : ",\n")
+                   << "    {\"key\": " << jsonString(keyOf(result))
+                   << ", \"name\": " << jsonString(result.name)
+                   << ", \"cache\": " << jsonString(result.cache)
+                   << ", \"width\": " << result.width
+                   << ", \"depth\": " << result.depth
+                   << ", \"synapses_per_op\": " << jsonNumber(result.synapsesPerOp)
+                   << ", \"iterations\": " << result.iterations
+                   << ", \"repetitions\": " << result.repetitions
+                   << ", \"ns_per_op\": {\"mean\": " << jsonNumber(result.nsPerOp.mean)
+                   << ", \"stddev\": " << jsonNumber(result.nsPerOp.stddev)
+                   << ", \"min\": " << jsonNumber(result.nsPerOp.min)
+                   << ", \"max\": " << jsonNumber(result.nsPerOp.max)
+                   << ", \"cv\": " << jsonNumber(result.nsPerOp.cv) << "}"
+                   << ", \"synapses_per_second\": " << jsonNumber(synapsesPerSecond(result))
+                   << ", \"samples\": [";
+            for (size_t j = 0; j < result.samples.size(); ++j) {
+                stream << (j == 0 ? "" : ", ") << jsonNumber(result.samples[j]);
+            }
+            stream << "]}";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    std::vector<BaselineEntry> getBaselineEntries() const {
+        std::vector<BaselineEntry> entries;
+        for (const auto& result : results) {
+            entries.push_back({ keyOf(result), result.samples });
+        }
+        return entries;
+    }
+
+private:
+    static std::string keyOf(const MicroBenchmarkResult& result) {
+        return result.name + "/" + result.cache + "/w" + std::to_string(result.width) + "/d" + std::to_string(result.depth);
+    }
+
+    static double synapsesPerSecond(const MicroBenchmarkResult& result) {
+        return result.nsPerOp.mean > 0.0 ? result.synapsesPerOp * 1e9 / result.nsPerOp.mean : 0.0;
+    }
+
+    void record(const std::string& name, const std::string& cache, int width, int depth,
+                double synapsesPerOp, long long iterations, const std::vector<double>& samples) {
+        MicroBenchmarkResult result;
+        result.name = name;
+        result.cache = cache;
+        result.width = width;
+        result.depth = depth;
+        result.synapsesPerOp = synapsesPerOp;
+        result.iterations = iterations;
+        result.repetitions = static_cast<int>(samples.size());
+        result.nsPerOp = computeStatistics(samples);
+        result.samples = samples;
+        std::cerr << "  " << name << " [" << cache << "] width=" << width << " depth=" << depth
+                  << ": " << result.nsPerOp.mean << " ns/op\n";
+        results.push_back(result);
+    }
+
+    MicroBenchmarkOptions options;              // 运行参数
+    CacheFlusher flusher;                       // 冷缓存测试用的缓存清除器
+    std::vector<MicroBenchmarkResult> results;  // 全部结果
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】buildNetwork
+//【函数功能】构造宽度为width、共depth层的全连接网络，第一层为线性，其余为Sigmoid，权重与偏置由固定种子生成
+//【参数】width - 层宽，depth - 层数，random - 随机数发生器
+//【返回值】std::unique_ptr<Network> - 构造的网络
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static std::unique_ptr<Network> buildNetwork(int width, int depth, std::mt19937& random) {
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    std::unique_ptr<Network> network(new Network());
+    for (int l = 0; l < depth; ++l) {
+        std::vector<double> biases(width);
+        for (auto& bias : biases) {
+            bias = distribution(random) * 0.1;
+        }
+        network->addLayer(new Layer(network.get(), width, biases, l == 0 ? 0 : 1));
+    }
+    for (int l = 1; l < depth; ++l) {
+        std::vector<std::vector<double>> weights(width, std::vector<double>(width));
+        for (auto& row : weights) {
+            for (auto& weight : row) {
+                weight = distribution(random) / std::sqrt(static_cast<double>(width));
+            }
+        }
+        network->setWeights(l, weights);
+    }
+    return network;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】runActivationBenchmarks
+//【函数功能】测试四种激活函数，每次调用遍历一个固定的输入数组，结果按单次函数调用折算
+//【参数】runner - 基准测试执行器，random - 随机数发生器
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static void runActivationBenchmarks(MicroBenchmarkRunner& runner, std::mt19937& random) {
+    std::uniform_real_distribution<double> distribution(-4.0, 4.0);
+    std::vector<double> values(1024);
+    for (auto& value : values) {
+        value = distribution(random);
+    }
+    struct Entry {
+        const char* name;
+        double (*function)(double);
+    };
+    const Entry entries[] = {
+        { "ActivationFunc::linear", &ActivationFunc::linear },
+        { "ActivationFunc::sigmoid", &ActivationFunc::sigmoid },
+        { "ActivationFunc::tanh", &ActivationFunc::tanh },
+        { "ActivationFunc::relu", &ActivationFunc::relu },
+    };
+    for (const auto& entry : entries) {
+        double (*function)(double) = entry.function;
+        runner.runWarm(entry.name, 0, 0, 0.0, static_cast<int>(values.size()), [&values, function]() {
+            double sum = 0.0;
+            for (double value : values) {
+                sum += function(value);
+            }
+            doNotOptimize(sum);
+        });
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】runStructureBenchmarks
+//【函数功能】按层宽测试Soma::updateOutput、Neuron::updateOutput和Layer::updateOutputs，
+//        按层宽和层数测试Network::forward，每项都测热缓存和冷缓存两种情形
+//【参数】runner - 基准测试执行器，options - 运行参数，random - 随机数发生器
+//【返回值】无
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static void runStructureBenchmarks(MicroBenchmarkRunner& runner, const MicroBenchmarkOptions& options, std::mt19937& random) {
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    for (int width : options.widths) {
+        std::vector<double> inputs(width);
+        for (auto& input : inputs) {
+            input = distribution(random);
+        }
+
+        Soma soma(inputs, 0.1, 1);
+        auto somaOperation = [&soma]() {
+            soma.updateOutput();
+            doNotOptimize(soma.getOutput());
+        };
+        runner.runWarm("Soma::updateOutput", width, 0, width, 1, somaOperation);
+        runner.runCold("Soma::updateOutput", width, 0, width, somaOperation);
+
+        // 两层网络：第1层的神经元和整层分别作为Neuron与Layer的被测对象
+        std::unique_ptr<Network> network = buildNetwork(width, 2, random);
+        network->forward(inputs);
+        Layer* layer = *std::next(network->getLayers().begin());
+        Neuron& neuron = layer->getNeuron(width / 2);
+        auto neuronOperation = [&neuron]() {
+            neuron.updateOutput();
+            doNotOptimize(neuron.getOutput());
+        };
+        runner.runWarm("Neuron::updateOutput", width, 0, width, 1, neuronOperation);
+        runner.runCold("Neuron::updateOutput", width, 0, width, neuronOperation);
+
+        auto layerOperation = [layer]() {
+            layer->updateOutputs();
+            doNotOptimize(layer->getNeuron(0).getOutput());
+        };
+        runner.runWarm("Layer::updateOutputs", width, 0, static_cast<double>(width) * width, 1, layerOperation);
+        runner.runCold("Layer::updateOutputs", width, 0, static_cast<double>(width) * width, layerOperation);
+
+        for (int depth : options.depths) {
+            std::unique_ptr<Network> deepNetwork = buildNetwork(width, depth, random);
+            Network* target = deepNetwork.get();
+            auto forwardOperation = [target, &inputs]() {
+                doNotOptimize(target->forward(inputs).back().front());
+            };
+            double synapses = static_cast<double>(depth - 1) * width * width;
+            runner.runWarm("Network::forward", width, depth, synapses, 1, forwardOperation);
+            runner.runCold("Network::forward", width, depth, synapses, forwardOperation);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseOptions
+//【函数功能】解析命令行参数，格式为 --key=value
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】MicroBenchmarkOptions - 运行参数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加--save-baseline、--compare、--threshold和--gate
+//-------------------------------------------------------------------------------------------------------------------
+static MicroBenchmarkOptions parseOptions(int argc, char* argv[]) {
+    MicroBenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--widths") {
+            options.widths = parseIntegerList(value);
+        } else if (key == "--depths") {
+            options.depths = parseIntegerList(value);
+        } else if (key == "--repetitions") {
+            options.repetitions = std::stoi(value);
+        } else if (key == "--min-time") {
+            options.minSampleSeconds = std::stod(value);
+        } else if (key == "--cold-iterations") {
+            options.coldIterations = std::stoi(value);
+        } else if (key == "--json" || key == "--save-baseline") {
+            options.jsonPath = value;
+        } else if (key == "--compare") {
+            options.baselinePath = value;
+        } else if (key == "--threshold") {
+            options.threshold = std::stod(value);
+        } else if (key == "--gate") {
+            options.gates = parseStringList(value);
+        } else {
+            throw std::invalid_argument("Unknown option: " + argument);
+        }
+    }
+    for (int width : options.widths) {
+        if (width <= 0) {
+            throw std::invalid_argument("Widths must be positive.");
+        }
+    }
+    for (int depth : options.depths) {
+        if (depth < 2) {
+            throw std::invalid_argument("Depths must be at least 2.");
+        }
+    }
+    if (options.repetitions <= 0 || options.coldIterations <= 0 || options.minSampleSeconds <= 0.0) {
+        throw std::invalid_argument("Repetitions, cold iterations and minimum sample time must be positive.");
+    }
+    if (options.threshold < 0.0) {
+        throw std::invalid_argument("Threshold must not be negative.");
+    }
+    return options;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】main
+//【函数功能】微基准测试程序入口。可读表格输出到标准输出（JSON写到标准输出时改为标准错误）
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】int - 程序退出状态码：0为正常，1为出错，2为相对基线存在显著回归
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加与基线比较
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    try {
+        MicroBenchmarkOptions options = parseOptions(argc, argv);
+        std::vector<BaselineEntry> baseline;
+        if (!options.baselinePath.empty()) {// 先读取基线，避免测完才发现文件有误
+            baseline = loadBaseline(options.baselinePath);
+        }
+        MicroBenchmarkRunner runner(options);
+        std::mt19937 random(20261019); // 固定种子，保证各次运行的网络相同
+        runActivationBenchmarks(runner, random);
+        runStructureBenchmarks(runner, options, random);
+
+        runner.printTable(options.jsonPath == "-" ? std::cerr : std::cout);
+        if (options.jsonPath == "-") {
+            runner.writeJson(std::cout);
+        } else if (!options.jsonPath.empty()) {
+            std::ofstream file(options.jsonPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to create file: " + options.jsonPath);
+            }
+            runner.writeJson(file);
+        }
+        if (!options.baselinePath.empty()) {
+            BaselineComparator comparator(options.threshold, options.gates);
+            std::vector<ComparisonResult> comparison = comparator.compare(baseline, runner.getBaselineEntries());
+            comparator.print(options.jsonPath == "-" ? std::cerr : std::cout, comparison);
+            if (BaselineComparator::hasRegression(comparison)) {
+                std::cerr << "Error: performance regression beyond " << options.threshold * 100.0 << "%\n";
+                return 2;
+            }
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
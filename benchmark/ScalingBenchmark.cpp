@@ -0,0 +1,552 @@
+//-------------------------------------------------------------------------------------------------------------------
+//【文件名】ScalingBenchmark.cpp
+//【功能模块和目的】端到端规模基准测试程序：从simple.ANN大小的网络到数百万突触的网络，分别测量
+//                  构建（addLayer/addNeuron）、导出、导入、前向传播、拷贝构造、删除神经元、删除层等
+//                  生命周期阶段的耗时和峰值常驻内存（RSS），并按突触数计算各阶段的增长指数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加重复测量、基线保存与比较，存在显著回归时以状态码2退出
+//【更改记录】2026年10月19日 增加对固定测试模型文件（如GenerateModel生成的文件）的导入和前向传播测试
+//-------------------------------------------------------------------------------------------------------------------
+
+#include "BenchmarkBaseline.hpp"  // 基准测试基线的读取与比较
+#include "BenchmarkUtil.hpp"      // 基准测试公用工具
+#include "../ANNFilePorter.hpp"   // ANN文件导入导出类头文件
+#include "../CompiledNetwork.hpp" // 紧凑推理网络类头文件
+#include "../Network.hpp"         // 网络类头文件
+#include <cstdio>                 // std::remove
+#include <fstream>                // 文件流头文件
+#include <iomanip>                // 输出格式控制
+#include <iostream>               // 输入输出流头文件
+#include <map>                    // map所属头文件
+#include <memory>                 // 智能指针
+#include <random>                 // 随机数
+#include <stdexcept>              // 标准异常头文件
+
+#ifdef __linux__
+#include <sys/resource.h>         // getrusage
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】NetworkShape
+//【功能】被测网络的形状：depth层，每层width个神经元，相邻层全连接。
+//        来自模型文件的网络以文件名为label，突触数由文件给出，不参与增长指数的计算
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加label和synapses，用于模型文件
+//-------------------------------------------------------------------------------------------------------------------
+struct NetworkShape {
+    int width = 0;          // 层宽
+    int depth = 0;          // 层数
+    std::string label;      // 模型文件名（生成的网络为空）
+    long long synapses = 0; // 模型文件中的突触数
+    long long getSynapseCount() const {
+        return label.empty() ? static_cast<long long>(depth - 1) * width * width : synapses;
+    }
+    std::string getName() const { return label.empty() ? std::to_string(width) + "x" + std::to_string(depth) : label; }
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】ScalingBenchmarkOptions
+//【功能】规模基准测试的运行参数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加重复次数和基线比较参数
+//-------------------------------------------------------------------------------------------------------------------
+struct ScalingBenchmarkOptions {
+    std::vector<NetworkShape> shapes;  // 被测网络形状，按突触数从小到大
+    int forwardCount = 10;             // 前向传播次数
+    int deleteNeuronCount = 8;         // 删除的神经元数量
+    std::string workDirectory = ".";   // 临时ANN文件所在目录
+    std::vector<std::string> fixtures; // 额外测试的模型文件
+    std::string jsonPath;              // JSON输出路径，"-"为标准输出，空为不输出
+    int repetitions = 1;               // 每种网络完整重复测量的次数
+    std::string baselinePath;          // 作为基线比较的JSON文件，空为不比较
+    double threshold = 0.05;           // 判为回归的相对变化阈值
+    std::vector<std::string> gates;    // 只比较键中包含这些子串的阶段，空为全部
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【结构体名】PhaseResult
+//【功能】一个网络在一个阶段的测量结果。peakRssBytes为本阶段内的常驻内存峰值；
+//        peakReset为false时系统不支持重置峰值，peakRssBytes为进程启动以来的峰值。
+//        重复测量时seconds为各次的平均值，peakRssBytes为各次的最大值，samples为各次的单次操作耗时
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加samples，支持重复测量
+//-------------------------------------------------------------------------------------------------------------------
+struct PhaseResult {
+    NetworkShape shape;         // 网络形状
+    std::string phase;          // 阶段名称
+    int operations = 0;         // 本阶段执行的操作数
+    double seconds = 0.0;       // 本阶段总耗时
+    long long rssBeforeBytes = 0; // 阶段开始时的常驻内存
+    long long rssAfterBytes = 0;  // 阶段结束时的常驻内存
+    long long peakRssBytes = 0;   // 阶段内的常驻内存峰值
+    bool peakReset = false;       // 是否成功重置了峰值
+    std::vector<double> samples;  // 各次测量的单次操作耗时
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】MemoryProbe
+//【功能】读取进程的常驻内存。Linux下通过/proc/self/clear_refs重置峰值（VmHWM），
+//        从/proc/self/status读取当前值（VmRSS）和峰值；其他系统不可用时返回0
+//【接口说明】
+//  - bool resetPeak(): 重置峰值，成功返回true
+//  - long long getCurrentBytes() const: 当前常驻内存
+//  - long long getPeakBytes() const: 常驻内存峰值
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+class MemoryProbe {
+public:
+    bool resetPeak() {
+        std::ofstream file("/proc/self/clear_refs");
+        if (!file.is_open()) {
+            return false;
+        }
+        file << "5";
+        file.close();
+        return !file.fail();
+    }
+    long long getCurrentBytes() const { return readStatus("VmRSS:"); }
+    long long getPeakBytes() const {
+        long long peak = readStatus("VmHWM:");
+#ifdef __linux__
+        if (peak == 0) {
+            struct rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            peak = static_cast<long long>(usage.ru_maxrss) * 1024;
+        }
+#endif
+        return peak;
+    }
+
+private:
+    static long long readStatus(const std::string& key) {
+        std::ifstream file("/proc/self/status");
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.compare(0, key.size(), key) == 0) {
+                return std::stoll(line.substr(key.size())) * 1024; // 单位为kB
+            }
+        }
+        return 0;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【类名】ScalingBenchmark
+//【功能】对每种网络形状依次执行各生命周期阶段并记录结果，再对每个模型文件测试导入和前向传播
+//【接口说明】
+//  - explicit ScalingBenchmark(const ScalingBenchmarkOptions& options): 构造函数
+//  - void run(): 执行全部测试
+//  - void printTable(std::ostream& stream) const: 输出结果表格和增长指数
+//  - void writeJson(std::ostream& stream) const: 输出JSON，每项结果带有key和原始样本，可直接作为基线
+//  - std::vector<BaselineEntry> getBaselineEntries() const: 获取用于基线比较的结果
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 按options.repetitions重复测量，JSON增加key、repetitions和samples字段
+//-------------------------------------------------------------------------------------------------------------------
+class ScalingBenchmark {
+public:
+    explicit ScalingBenchmark(const ScalingBenchmarkOptions& options) : options(options) {}
+
+    void run() {
+        for (int r = 0; r < options.repetitions; ++r) {
+            for (const auto& shape : options.shapes) {
+                std::cerr << "network " << shape.getName() << " (" << shape.getSynapseCount() << " synapses)";
+                std::cerr << (options.repetitions > 1 ? ", repetition " + std::to_string(r + 1) : "") << "\n";
+                runShape(shape);
+            }
+            for (const auto& path : options.fixtures) {
+                std::cerr << "fixture " << path << "\n";
+                runFixture(path);
+            }
+        }
+    }
+
+    void printTable(std::ostream& stream) const {
+        stream << std::left << std::setw(12) << "network" << std::setw(14) << "phase"
+               << std::right << std::setw(12) << "synapses" << std::setw(8) << "ops"
+               << std::setw(14) << "seconds" << std::setw(14) << "s/op"
+               << std::setw(14) << "peak RSS MB" << std::setw(14) << "delta MB" << "\n";
+        for (const auto& result : results) {
+            stream << std::left << std::setw(12) << result.shape.getName() << std::setw(14) << result.phase
+                   << std::right << std::setw(12) << result.shape.getSynapseCount()
+                   << std::setw(8) << result.operations
+                   << std::setw(14) << std::scientific << std::setprecision(3) << result.seconds
+                   << std::setw(14) << result.seconds / result.operations
+                   << std::setw(14) << std::fixed << std::setprecision(1) << result.peakRssBytes / 1048576.0
+                   << std::setw(14) << (result.peakRssBytes - result.rssBeforeBytes) / 1048576.0
+                   << std::defaultfloat << "\n";
+        }
+        stream << "\nscaling exponent of seconds/op vs synapses (1 = linear, 2 = quadratic):\n";
+        for (const auto& exponent : computeExponents()) {
+            stream << "  " << std::left << std::setw(14) << exponent.first << std::right;
+            for (double value : exponent.second) {
+                stream << std::setw(8) << std::fixed << std::setprecision(2) << value;
+            }
+            stream << std::defaultfloat;
+            double last = exponent.second.empty() ? 0.0 : exponent.second.back();
+            stream << (last > 1.5 ? "   <-- superlinear" : "") << "\n";
+        }
+    }
+
+    void writeJson(std::ostream& stream) const {
+        stream << "{\n  \"schema\": \"cann-scaling-benchmark/1\",\n";
+        stream << "  \"timestamp\": " << jsonString(currentTimestamp()) << ",\n";
+#ifdef __VERSION__
+        stream << "  \"compiler\": " << jsonString(__VERSION__) << ",\n";
+#endif
+        stream << "  \"config\": {\"forward_count\": " << options.forwardCount
+               << ", \"delete_neuron_count\": " << options.deleteNeuronCount
+               << ", \"repetitions\": " << options.repetitions << "},\n";
+        stream << "  \"results\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            stream << (i == 0 ? "\n" : ",\n")
+                   << "    {\"key\": " << jsonString(keyOf(result))
+                   << ", \"name\": " << jsonString(result.phase)
+                   << ", \"network\": " << jsonString(result.shape.getName())
+                   << ", \"width\": " << result.shape.width
+                   << ", \"depth\": " << result.shape.depth
+                   << ", \"synapses\": " << result.shape.getSynapseCount()
+                   << ", \"operations\": " << result.operations
+                   << ", \"seconds\": " << jsonNumber(result.seconds)
+                   << ", \"seconds_per_op\": " << jsonNumber(result.seconds / result.operations)
+                   << ", \"rss_before_bytes\": " << result.rssBeforeBytes
+                   << ", \"rss_after_bytes\": " << result.rssAfterBytes
+                   << ", \"peak_rss_bytes\": " << result.peakRssBytes
+                   << ", \"peak_rss_reset\": " << (result.peakReset ? "true" : "false")
+                   << ", \"repetitions\": " << result.samples.size()
+                   << ", \"samples\": [";
+            for (size_t j = 0; j < result.samples.size(); ++j) {
+                stream << (j == 0 ? "" : ", ") << jsonNumber(result.samples[j]);
+            }
+            stream << "]}";
+        }
+        stream << "\n  ],\n  \"scaling_exponents\": {";
+        bool first = true;
+        for (const auto& exponent : computeExponents()) {
+            stream << (first ? "\n" : ",\n") << "    " << jsonString(exponent.first) << ": [";
+            for (size_t i = 0; i < exponent.second.size(); ++i) {
+                stream << (i == 0 ? "" : ", ") << jsonNumber(exponent.second[i]);
+            }
+            stream << "]";
+            first = false;
+        }
+        stream << "\n  }\n}\n";
+    }
+
+    std::vector<BaselineEntry> getBaselineEntries() const {
+        std::vector<BaselineEntry> entries;
+        for (const auto& result : results) {
+            entries.push_back({ keyOf(result), result.samples });
+        }
+        return entries;
+    }
+
+private:
+    static std::string keyOf(const PhaseResult& result) {
+        return result.phase + "/" + result.shape.getName();
+    }
+
+    template <typename Operation>
+    void measure(const NetworkShape& shape, const std::string& phase, int operations, Operation operation) {
+        PhaseResult result;
+        result.shape = shape;
+        result.phase = phase;
+        result.operations = operations;
+        result.peakReset = probe.resetPeak();
+        result.rssBeforeBytes = probe.getCurrentBytes();
+        double start = nowSeconds();
+        operation();
+        result.seconds = nowSeconds() - start;
+        result.rssAfterBytes = probe.getCurrentBytes();
+        result.peakRssBytes = probe.getPeakBytes();
+        result.samples.push_back(result.seconds / operations);
+
+        auto found = indexByKey.find(keyOf(result));
+        if (found == indexByKey.end()) {
+            indexByKey[keyOf(result)] = results.size();
+            results.push_back(result);
+            return;
+        }
+        PhaseResult& merged = results[found->second]; // 重复测量：合并到第一次的结果中
+        merged.samples.push_back(result.samples.front());
+        merged.seconds = computeStatistics(merged.samples).mean * merged.operations;
+        merged.peakRssBytes = std::max(merged.peakRssBytes, result.peakRssBytes);
+        merged.peakReset = merged.peakReset && result.peakReset;
+    }
+
+    void runShape(const NetworkShape& shape) {
+        std::mt19937 random(20261019);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::unique_ptr<Network> network;
+
+        measure(shape, "construct", 1, [&]() {
+            network.reset(new Network());
+            network->setName("scaling_" + shape.getName());
+            for (int l = 0; l < shape.depth; ++l) {
+                network->addLayer(new Layer(network.get(), 0, {}, l == 0 ? 0 : 1));
+            }
+            for (int l = 0; l < shape.depth; ++l) {
+                for (int i = 0; i < shape.width; ++i) {
+                    network->addNeuron(l, distribution(random) * 0.1, l == 0 ? 0 : 1);
+                }
+            }
+            for (int l = 1; l < shape.depth; ++l) {
+                std::vector<std::vector<double>> weights(shape.width, std::vector<double>(shape.width));
+                for (auto& row : weights) {
+                    for (auto& weight : row) {
+                        weight = distribution(random) / std::sqrt(static_cast<double>(shape.width));
+                    }
+                }
+                network->setWeights(l, weights);
+            }
+        });
+
+        const std::string path = options.workDirectory + "/scaling_" + shape.getName() + ".ANN";
+        measure(shape, "export", 1, [&]() {
+            ANNExporter exporter(path);
+            exporter.exportNetwork(*network);
+        });
+
+        std::unique_ptr<Network> imported;
+        measure(shape, "import", 1, [&]() {
+            ANNImporter importer(path);
+            imported.reset(new Network(importer.import()));
+        });
+        std::remove(path.c_str());
+        imported.reset();
+
+        std::vector<double> inputs(shape.width);
+        for (auto& input : inputs) {
+            input = distribution(random);
+        }
+        measure(shape, "forward", options.forwardCount, [&]() {
+            for (int i = 0; i < options.forwardCount; ++i) {
+                doNotOptimize(network->forward(inputs).back().front());
+            }
+        });
+
+        std::unique_ptr<Network> copy;
+        measure(shape, "copy", 1, [&]() {
+            copy.reset(new Network(*network));
+        });
+
+        const int middle = shape.depth / 2;
+        const int deleteCount = std::min(options.deleteNeuronCount, shape.width - 1);
+        if (deleteCount > 0) {
+            measure(shape, "deleteNeuron", deleteCount, [&]() {
+                for (int i = 0; i < deleteCount; ++i) {
+                    copy->deleteNeuron(middle, (i * 7919) % (shape.width - i)); // 删除位置分散在层内
+                }
+            });
+        }
+        if (shape.depth > 2) {
+            measure(shape, "deleteLayer", 1, [&]() {
+                copy->deleteLayer(middle);
+            });
+        }
+
+        measure(shape, "destroy", 1, [&]() {
+            copy.reset();
+            network.reset();
+        });
+    }
+
+    void runFixture(const std::string& path) {
+        // 模型文件可能是稀疏的：import按全连接补齐，importCompiled只保留文件中的突触
+        NetworkShape shape;
+        size_t slash = path.find_last_of('/');
+        shape.label = path.substr(slash == std::string::npos ? 0 : slash + 1);
+        std::unique_ptr<Network> network;
+        measure(shape, "import", 1, [&]() {
+            ANNImporter importer(path);
+            network.reset(new Network(importer.import()));
+        });
+        std::unique_ptr<CompiledNetwork> compiled;
+        measure(shape, "importCompiled", 1, [&]() {
+            ANNImporter importer(path);
+            compiled.reset(new CompiledNetwork(importer.importCompiled()));
+        });
+        shape.depth = compiled->getLayerCount();
+        shape.synapses = static_cast<long long>(compiled->getSynapseCount());
+        results[indexByKey["import/" + shape.label]].shape = shape;
+        results[indexByKey["importCompiled/" + shape.label]].shape = shape;
+
+        std::mt19937 random(20261019);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::vector<double> inputs(compiled->getInputSize());
+        for (auto& input : inputs) {
+            input = distribution(random);
+        }
+        measure(shape, "forward", options.forwardCount, [&]() {
+            for (int i = 0; i < options.forwardCount; ++i) {
+                doNotOptimize(network->forward(inputs).back().front());
+            }
+        });
+        measure(shape, "forwardCompiled", options.forwardCount, [&]() {
+            for (int i = 0; i < options.forwardCount; ++i) {
+                doNotOptimize(compiled->forward(inputs).back().front());
+            }
+        });
+        measure(shape, "destroy", 1, [&]() {
+            network.reset();
+            compiled.reset();
+        });
+    }
+
+    std::map<std::string, std::vector<double>> computeExponents() const {
+        // 相邻两种网络之间：log(每次操作耗时之比) / log(突触数之比)
+        std::map<std::string, std::vector<const PhaseResult*>> byPhase;
+        for (const auto& result : results) {
+            if (result.shape.label.empty()) {
+                byPhase[result.phase].push_back(&result);
+            }
+        }
+        std::map<std::string, std::vector<double>> exponents;
+        for (const auto& entry : byPhase) {
+            std::vector<double>& values = exponents[entry.first];
+            for (size_t i = 1; i < entry.second.size(); ++i) {
+                const PhaseResult& small = *entry.second[i - 1];
+                const PhaseResult& large = *entry.second[i];
+                double sizeRatio = static_cast<double>(large.shape.getSynapseCount()) / small.shape.getSynapseCount();
+                double timeRatio = (large.seconds / large.operations) / (small.seconds / small.operations);
+                if (sizeRatio > 1.0 && timeRatio > 0.0) {
+                    values.push_back(std::log(timeRatio) / std::log(sizeRatio));
+                }
+            }
+        }
+        return exponents;
+    }
+
+    ScalingBenchmarkOptions options;   // 运行参数
+    MemoryProbe probe;                 // 内存读取
+    std::vector<PhaseResult> results;  // 全部结果
+    std::map<std::string, size_t> indexByKey; // 结果键到results下标的映射
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseShapes
+//【函数功能】解析网络形状列表，如 "3x2,64x4"（宽x层数）
+//【参数】text - 列表字符串
+//【返回值】std::vector<NetworkShape> - 网络形状
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static std::vector<NetworkShape> parseShapes(const std::string& text) {
+    std::vector<NetworkShape> shapes;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        size_t separator = item.find('x');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("Invalid network shape: " + item);
+        }
+        NetworkShape shape;
+        shape.width = std::stoi(item.substr(0, separator));
+        shape.depth = std::stoi(item.substr(separator + 1));
+        if (shape.width <= 0 || shape.depth < 2) {
+            throw std::invalid_argument("Network shape needs a positive width and at least 2 layers: " + item);
+        }
+        shapes.push_back(shape);
+    }
+    return shapes;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】parseOptions
+//【函数功能】解析命令行参数，格式为 --key=value
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】ScalingBenchmarkOptions - 运行参数
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加--repetitions、--save-baseline、--compare、--threshold和--gate
+//【更改记录】2026年10月19日 增加--fixtures
+//【更改记录】2026年10月19日 --save-baseline和--compare要求至少重复2次，否则无法估计方差
+//-------------------------------------------------------------------------------------------------------------------
+static ScalingBenchmarkOptions parseOptions(int argc, char* argv[]) {
+    ScalingBenchmarkOptions options;
+    bool savingBaseline = false;
+    options.shapes = parseShapes("3x2,16x3,64x4,256x4,512x4,1024x3"); // 最大约两百万个突触
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--sizes") {
+            options.shapes = parseShapes(value);
+        } else if (key == "--forward-count") {
+            options.forwardCount = std::stoi(value);
+        } else if (key == "--delete-neurons") {
+            options.deleteNeuronCount = std::stoi(value);
+        } else if (key == "--fixtures") {
+            options.fixtures = parseStringList(value);
+        } else if (key == "--workdir") {
+            options.workDirectory = value;
+        } else if (key == "--json" || key == "--save-baseline") {
+            options.jsonPath = value;
+            savingBaseline = savingBaseline || key == "--save-baseline";
+        } else if (key == "--repetitions") {
+            options.repetitions = std::stoi(value);
+        } else if (key == "--compare") {
+            options.baselinePath = value;
+        } else if (key == "--threshold") {
+            options.threshold = std::stod(value);
+        } else if (key == "--gate") {
+            options.gates = parseStringList(value);
+        } else {
+            throw std::invalid_argument("Unknown option: " + argument);
+        }
+    }
+    if (options.forwardCount <= 0 || options.deleteNeuronCount < 0) {
+        throw std::invalid_argument("Forward count must be positive and delete count non-negative.");
+    }
+    if (options.repetitions <= 0 || options.threshold < 0.0) {
+        throw std::invalid_argument("Repetitions must be positive and threshold non-negative.");
+    }
+    if ((savingBaseline || !options.baselinePath.empty()) && options.repetitions < 2) {
+        throw std::invalid_argument("--save-baseline and --compare need --repetitions of at least 2.");
+    }
+    return options;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//【函数名称】main
+//【函数功能】规模基准测试程序入口。可读表格输出到标准输出（JSON写到标准输出时改为标准错误）
+//【参数】argc - 参数个数，argv - 参数列表
+//【返回值】int - 程序退出状态码：0为正常，1为出错，2为相对基线存在显著回归
+//【开发者及日期】李孟涵 2026年10月19日
+//【更改记录】2026年10月19日 增加与基线比较
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    try {
+        ScalingBenchmarkOptions options = parseOptions(argc, argv);
+        std::vector<BaselineEntry> baseline;
+        if (!options.baselinePath.empty()) {// 先读取基线，避免测完才发现文件有误
+            baseline = loadBaseline(options.baselinePath);
+        }
+        ScalingBenchmark benchmark(options);
+        benchmark.run();
+        benchmark.printTable(options.jsonPath == "-" ? std::cerr : std::cout);
+        if (options.jsonPath == "-") {
+            benchmark.writeJson(std::cout);
+        } else if (!options.jsonPath.empty()) {
+            std::ofstream file(options.jsonPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to create file: " + options.jsonPath);
+            }
+            benchmark.writeJson(file);
+        }
+        if (!options.baselinePath.empty()) {
+            BaselineComparator comparator(options.threshold, options.gates);
+            std::vector<ComparisonResult> comparison = comparator.compare(baseline, benchmark.getBaselineEntries());
+            comparator.print(options.jsonPath == "-" ? std::cerr : std::cout, comparison);
+            if (BaselineComparator::hasRegression(comparison)) {
+                std::cerr << "Error: performance regression beyond " << options.threshold * 100.0 << "%\n";
+                return 2;
+            }
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -5,25 +5,432 @@
 // 【更改记录】2025年7月24日 增加了对网络有效性的检查, 增加对网络名称的支持
 // 【更改记录】2025年7月29日 针对索引进行相应修改
 // 【更改记录】2025年7月30日 改为使用MVC架构，分离视图和控制器
+// 【更改记录】2026年10月19日 定义CANN_TRACE时可通过环境变量CANN_TRACE_FILE输出时间线
+// 【更改记录】2026年10月19日 增加非交互的批量推理模式 "infer"
+// 【更改记录】2026年10月19日 增加本机推理服务模式 "serve"
+// 【更改记录】2026年10月19日 推理服务收到SIGHUP时重新加载模型并热替换
+// 【更改记录】2026年10月19日 infer、serve增加--threads、--pin-threads，设置共享线程池
+// 【更改记录】2026年10月19日 infer、serve增加--optimize，加载后合并连续的线性层
+// 【更改记录】2026年10月19日 增加生成C++源码的模式 "codegen"
+// 【更改记录】2026年10月19日 CANN_TRACE_FILE对所有模式生效
+// 【更改记录】2026年10月19日 数值选项改为检查后解析，非法值报告用法错误而不是抛出未捕获的异常
 //-------------------------------------------------------------------------------------------------------------------
 
 #include "View.hpp"     // 视图类头文件
 #include "Controller.hpp" // 控制器类头文件
+#include "ANNFilePorter.hpp"  // ANN文件导入导出类头文件
+#include "BatchInference.hpp" // 批量推理类头文件
+#include "CppExporter.hpp"    // C++源码导出类头文件
+#include "InferenceServer.hpp" // 本机推理服务类头文件
+#include "NetworkOptimizer.hpp" // 网络优化类头文件
+#include "ThreadPool.hpp"   // 线程池类头文件
+#include "Tracer.hpp"   // 时间线跟踪
+#include <atomic>       // 原子变量
+#include <chrono>       // 计时
+#include <csignal>      // 信号处理
+#include <cstdlib>      // std::getenv
+#include <fstream>      // 文件流头文件
 #include <iostream>     // 输入输出流头文件
+#include <memory>       // 智能指针
+#include <string>       // 字符串所属头文件
+#include <thread>       // 线程
 
 //-------------------------------------------------------------------------------------------------------------------
-// 【函数名称】main
-// 【函数功能】程序主函数，创建View和Controller对象，启动MVC架构的神经网络系统
+// 【函数名称】loadModel
+// 【函数功能】为非交互模式加载模型：默认用ANNImporter::import导入（与交互界面一致，缺失的相邻层突触补为1.0）
+//            后编译为CompiledNetwork，sparse为true时用importCompiled只保留文件中列出的突触。
+//            optimize为true时在编译前用NetworkOptimizer优化网络，并把规模变化写到标准错误
+// 【参数】modelPath - 模型文件路径，sparse - 是否按稀疏模型导入，optimize - 是否优化网络
+// 【返回值】CompiledNetwork - 推理网络
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 增加optimize参数
+// 【更改记录】2026年10月19日 同时报告神经元数的变化
+//-------------------------------------------------------------------------------------------------------------------
+static CompiledNetwork loadModel(const std::string& modelPath, bool sparse, bool optimize) {
+    ANNImporter importer(modelPath);
+    if (sparse) {
+        return importer.importCompiled();
+    }
+    Network network = importer.import();
+    if (optimize) {
+        OptimizationReport report = NetworkOptimizer::optimize(network);
+        std::cerr << "Optimized " << modelPath << ": " << report.layersBefore << " -> " << report.layersAfter
+                  << " layers, " << report.neuronsBefore << " -> " << report.neuronsAfter << " neurons, " << report.synapsesBefore << " -> " << report.synapsesAfter << " synapses\n";
+    }
+    return CompiledNetwork(network);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】checkModelOptions
+// 【函数功能】检查模型选项的组合：优化作用于Network，稀疏导入不经过Network，二者不能同时使用
+// 【参数】sparse - 是否按稀疏模型导入，optimize - 是否优化网络
+// 【返回值】bool - 组合是否有效
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static bool checkModelOptions(bool sparse, bool optimize) {
+    if (sparse && optimize) {
+        std::cerr << "Error: --optimize cannot be combined with --sparse.\n";
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】parseIntOption
+// 【函数功能】把选项值解析为整数，值为空、不是完整的十进制整数或超出int范围时在标准错误报告
+// 【参数】key - 选项名，value - 选项值，result - 解析结果，失败时不修改
+// 【返回值】bool - 是否解析成功
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static bool parseIntOption(const std::string& key, const std::string& value, int& result) {
+    size_t used = 0;
+    int parsed = 0;
+    try {
+        parsed = std::stoi(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (value.empty() || used != value.size()) {
+        std::cerr << "Error: Invalid value for " << key << ": '" << value << "'\n";
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】parseThreadOption
+// 【函数功能】解析非交互模式共用的线程池选项：--threads=N（0为硬件线程数）、--pin-threads。
+//            --threads的值为空、不是整数或为负数时在标准错误报告，valid置为false
+// 【参数】key - 选项名，value - 选项值，options - 解析结果，valid - 值是否有效
+// 【返回值】bool - key是否为线程池选项
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 检查--threads的值，增加valid参数
+//-------------------------------------------------------------------------------------------------------------------
+static bool parseThreadOption(const std::string& key, const std::string& value, ThreadPoolOptions& options,
+                              bool& valid) {
+    valid = true;
+    if (key == "--threads") {
+        int workers = 0;
+        if (!parseIntOption(key, value, workers)) {
+            valid = false;
+        } else if (workers < 0) {
+            std::cerr << "Error: Invalid value for --threads: '" << value << "'\n";
+            valid = false;
+        } else {
+            options.workers = workers;
+        }
+        return true;
+    }
+    if (key == "--pin-threads") {
+        options.pinThreads = true;
+        return true;
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】runInference
+// 【函数功能】非交互批量推理：CANN infer model.ANN [--input=path] [--output=path] [--batch-size=N]
+//            [--precision=N] [--sparse] [--optimize] [--threads=N] [--pin-threads]。输入、输出默认为标准输入、标准输出，
+//            吞吐量写到标准错误
+// 【参数】argc - 参数个数，argv - 参数列表，argv[1]为"infer"
+// 【返回值】int - 程序退出状态码
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 增加线程池选项
+// 【更改记录】2026年10月19日 增加--optimize
+// 【更改记录】2026年10月19日 --batch-size、--precision检查后解析
+// 【更改记录】2026年10月19日 --threads的值无效时退出
+//-------------------------------------------------------------------------------------------------------------------
+static int runInference(int argc, char* argv[]) {
+    std::string modelPath;
+    std::string inputPath = "-";
+    std::string outputPath = "-";
+    int batchSize = 256;
+    int precision = 10;
+    bool sparse = false;
+    bool optimize = false;
+    ThreadPoolOptions poolOptions;
+    bool validThreadOption = true;
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--input") {
+            inputPath = value;
+        } else if (key == "--output") {
+            outputPath = value;
+        } else if (key == "--batch-size") {
+            if (!parseIntOption(key, value, batchSize)) {
+                return 1;
+            }
+        } else if (key == "--precision") {
+            if (!parseIntOption(key, value, precision)) {
+                return 1;
+            }
+        } else if (parseThreadOption(key, value, poolOptions, validThreadOption)) {
+            if (!validThreadOption) {
+                return 1;
+            }
+        } else if (key == "--sparse") {
+            sparse = true;
+        } else if (key == "--optimize") {
+            optimize = true;
+        } else if (argument.compare(0, 2, "--") != 0 && modelPath.empty()) {
+            modelPath = argument;
+        } else {
+            std::cerr << "Error: Unknown option: " << argument << "\n";
+            return 1;
+        }
+    }
+    if (modelPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " infer model.ANN [--input=in.csv] [--output=out.csv]"
+                  << " [--batch-size=256] [--precision=10] [--sparse] [--optimize] [--threads=N] [--pin-threads]\n";
+        return 1;
+    }
+    if (!checkModelOptions(sparse, optimize)) {
+        return 1;
+    }
+    std::ios::sync_with_stdio(false);
+    std::ifstream inputFile;
+    std::ofstream outputFile;
+    if (inputPath != "-") {
+        inputFile.open(inputPath);
+        if (!inputFile.is_open()) {
+            std::cerr << "Error: Failed to open input file: " << inputPath << "\n";
+            return 1;
+        }
+    }
+    if (outputPath != "-") {
+        outputFile.open(outputPath);
+        if (!outputFile.is_open()) {
+            std::cerr << "Error: Failed to create output file: " << outputPath << "\n";
+            return 1;
+        }
+    }
+    try {
+        ThreadPool::configureShared(poolOptions);
+        CompiledNetwork network = loadModel(modelPath, sparse, optimize);
+        BatchInference inference(network, batchSize, precision);
+        InferenceReport report = inference.run(inputPath == "-" ? std::cin : inputFile,
+                                               outputPath == "-" ? std::cout : outputFile);
+        std::cerr << report.rows << " rows in " << report.batches << " batches, " << report.seconds << " s ("
+                  << report.computeSeconds << " s compute), " << report.rowsPerSecond << " rows/s\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】runCodegen
+// 【函数功能】生成C++源码：CANN codegen model.ANN --output=model.hpp [--sparse] [--optimize]。
+//            加载方式与infer相同，由CppExporter按输出文件的扩展名生成头文件或源文件
+// 【参数】argc - 参数个数，argv - 参数列表，argv[1]为"codegen"
+// 【返回值】int - 程序退出状态码
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static int runCodegen(int argc, char* argv[]) {
+    std::string modelPath;
+    std::string outputPath;
+    bool sparse = false;
+    bool optimize = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--output") {
+            outputPath = value;
+        } else if (key == "--sparse") {
+            sparse = true;
+        } else if (key == "--optimize") {
+            optimize = true;
+        } else if (argument.compare(0, 2, "--") != 0 && modelPath.empty()) {
+            modelPath = argument;
+        } else {
+            std::cerr << "Error: Unknown option: " << argument << "\n";
+            return 1;
+        }
+    }
+    if (modelPath.empty() || outputPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " codegen model.ANN --output=model.hpp [--sparse] [--optimize]\n";
+        return 1;
+    }
+    if (!checkModelOptions(sparse, optimize)) {
+        return 1;
+    }
+    try {
+        CompiledNetwork network = loadModel(modelPath, sparse, optimize);
+        CppExporter exporter(outputPath);
+        exporter.exportNetwork(network);
+        std::cerr << "Generated " << outputPath << " (namespace " << CppExporter::getNamespaceName(network.getName())
+                  << ", " << network.getInputSize() << " inputs, " << network.getOutputSize() << " outputs)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】stopServer
+// 【函数功能】SIGINT、SIGTERM的处理函数，请求正在运行的推理服务停止（只写一个原子变量）
+// 【参数】信号编号（未使用）
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static InferenceServer* runningServer = nullptr; // 供信号处理函数请求停止
+
+static void stopServer(int) {
+    if (runningServer != nullptr) {
+        runningServer->stop();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】requestReload
+// 【函数功能】SIGHUP的处理函数，请求推理服务重新加载模型（只写一个原子变量，由重新加载线程完成加载）
+// 【参数】信号编号（未使用）
+// 【返回值】无
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】无
+//-------------------------------------------------------------------------------------------------------------------
+static std::atomic<bool> reloadRequested(false); // 是否收到了重新加载请求
+
+static void requestReload(int) {
+    reloadRequested.store(true);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】runServer
+// 【函数功能】本机推理服务：CANN serve model.ANN [--socket=path] [--max-batch=N] [--max-delay-us=N] [--sparse]
+//            [--optimize] [--threads=N] [--pin-threads]，收到SIGINT或SIGTERM后停止，并把统计写到标准错误。收到SIGHUP时由重新加载线程从同一路径
+//            重新加载模型并发布为新版本，进行中的请求在旧版本上完成；加载失败时继续使用原版本
+// 【参数】argc - 参数个数，argv - 参数列表，argv[1]为"serve"
+// 【返回值】int - 程序退出状态码
+// 【开发者及日期】李孟涵 2026年10月19日
+// 【更改记录】2026年10月19日 模型放入ModelHandle，支持SIGHUP热替换
+// 【更改记录】2026年10月19日 增加线程池选项
+// 【更改记录】2026年10月19日 增加--optimize
+// 【更改记录】2026年10月19日 --max-batch、--max-delay-us检查后解析
+// 【更改记录】2026年10月19日 --threads的值无效时退出
+//-------------------------------------------------------------------------------------------------------------------
+static int runServer(int argc, char* argv[]) {
+    std::string modelPath;
+    std::string socketPath = "/tmp/cann.sock";
+    BatchingOptions options;
+    bool sparse = false;
+    bool optimize = false;
+    ThreadPoolOptions poolOptions;
+    bool validThreadOption = true;
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--socket") {
+            socketPath = value;
+        } else if (key == "--max-batch") {
+            if (!parseIntOption(key, value, options.maxBatchSize)) {
+                return 1;
+            }
+        } else if (key == "--max-delay-us") {
+            if (!parseIntOption(key, value, options.maxDelayMicroseconds)) {
+                return 1;
+            }
+        } else if (parseThreadOption(key, value, poolOptions, validThreadOption)) {
+            if (!validThreadOption) {
+                return 1;
+            }
+        } else if (key == "--sparse") {
+            sparse = true;
+        } else if (key == "--optimize") {
+            optimize = true;
+        } else if (argument.compare(0, 2, "--") != 0 && modelPath.empty()) {
+            modelPath = argument;
+        } else {
+            std::cerr << "Error: Unknown option: " << argument << "\n";
+            return 1;
+        }
+    }
+    if (modelPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " serve model.ANN [--socket=/tmp/cann.sock] [--max-batch=64]"
+                  << " [--max-delay-us=1000] [--sparse] [--optimize] [--threads=N] [--pin-threads]\n";
+        return 1;
+    }
+    if (!checkModelOptions(sparse, optimize)) {
+        return 1;
+    }
+    try {
+        ThreadPool::configureShared(poolOptions);
+        ModelHandle model(loadModel(modelPath, sparse, optimize));
+        InferenceServer server(model, socketPath, options);
+        runningServer = &server;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+#ifdef SIGHUP
+        std::signal(SIGHUP, requestReload);
+#endif
+        {
+            ModelSnapshot snapshot = model.acquire();
+            std::cerr << "Serving " << modelPath << " (" << snapshot->getInputSize() << " -> "
+                      << snapshot->getOutputSize() << ") on " << socketPath << "\n";
+        }
+        std::atomic<bool> serving(true);
+        std::thread reloader([&]() {// 以100毫秒为周期处理重新加载请求，并回收已无读者的旧版本
+            while (serving.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (reloadRequested.exchange(false)) {
+                    try {
+                        long long version = model.publish(loadModel(modelPath, sparse, optimize));
+                        ModelSnapshot snapshot = model.acquire();
+                        std::cerr << "Reloaded " << modelPath << " as version " << version << " ("
+                                  << snapshot->getInputSize() << " -> " << snapshot->getOutputSize() << ")\n";
+                    } catch (const std::exception& e) {
+                        std::cerr << "Reload failed, keeping version " << model.getVersion() << ": " << e.what() << "\n";
+                    }
+                }
+                model.reclaim();
+            }
+        });
+        try {
+            server.run();
+        } catch (...) {
+            serving.store(false);
+            reloader.join();
+            throw;
+        }
+        serving.store(false);
+        reloader.join();
+        runningServer = nullptr;
+        ServerStats stats = server.getStats();
+        std::cerr << stats.requests << " requests in " << stats.batches << " batches ("
+                  << (stats.batches > 0 ? static_cast<double>(stats.requests) / stats.batches : 0.0)
+                  << " per batch), " << stats.connections << " connections, " << stats.errors << " errors\n";
+    } catch (const std::exception& e) {
+        runningServer = nullptr;
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】runInteractive
+// 【函数功能】交互模式：创建View和Controller对象，启动MVC架构的神经网络系统
 // 【参数】无
 // 【返回值】int - 程序退出状态码
 // 【开发者及日期】李孟涵 2025年7月21日
-// 【更改记录】2025年7月24日 增加了对网络有效性的检查, 增加对网络名称的支持
-// 【更改记录】2025年7月29日 针对索引进行相应修改
-// 【更改记录】2025年7月30日 改为使用MVC架构，分离视图和控制器
+// 【更改记录】2026年10月19日 由main中提取，时间线的启用和输出移回main
 //-------------------------------------------------------------------------------------------------------------------
-
-int main()
-{
+static int runInteractive() {
     try {
         // 创建视图对象
         View view;
@@ -33,7 +440,6 @@ int main()
         
         // 启动应用程序主循环
         controller.run();
-        
     } catch (const std::exception& e) {
         std::cout << "\n❌ 程序运行出错: " << e.what() << std::endl;
         return 1;
@@ -43,4 +449,49 @@ int main()
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 【函数名称】main
+// 【函数功能】程序主函数，按第一个参数进入批量推理、推理服务、生成C++源码或交互模式
+// 【参数】argc - 参数个数，argv - 参数列表
+// 【返回值】int - 程序退出状态码
+// 【开发者及日期】李孟涵 2025年7月21日
+// 【更改记录】2025年7月24日 增加了对网络有效性的检查, 增加对网络名称的支持
+// 【更改记录】2025年7月29日 针对索引进行相应修改
+// 【更改记录】2025年7月30日 改为使用MVC架构，分离视图和控制器
+// 【更改记录】2026年10月19日 定义CANN_TRACE且设置了CANN_TRACE_FILE时，记录时间线并在退出时写入该文件
+// 【更改记录】2026年10月19日 第一个参数为"infer"时进入非交互批量推理模式
+// 【更改记录】2026年10月19日 第一个参数为"serve"时启动本机推理服务
+// 【更改记录】2026年10月19日 第一个参数为"codegen"时生成C++源码
+// 【更改记录】2026年10月19日 时间线在所有模式下记录和输出，交互模式提取为runInteractive
+//-------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+#ifdef CANN_TRACE
+    const char* traceFile = std::getenv("CANN_TRACE_FILE");
+    if (traceFile != nullptr) {
+        Tracer::setThreadName("main");
+        Tracer::enable();
+    }
+#endif
+    const std::string mode = argc >= 2 ? argv[1] : "";
+    int status = 0;
+    if (mode == "infer") {
+        status = runInference(argc, argv);
+    } else if (mode == "serve") {
+        status = runServer(argc, argv);
+    } else if (mode == "codegen") {
+        status = runCodegen(argc, argv);
+    } else {
+        status = runInteractive();
+    }
+#ifdef CANN_TRACE
+    if (traceFile != nullptr) {
+        Tracer::disable();
+        Tracer::writeJson(std::string(traceFile));
+    }
+#endif
+    return status;
+}